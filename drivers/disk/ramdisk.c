@@ -51,6 +51,32 @@ static int disk_ram_access_write(struct disk_info *disk, const uint8_t *buff,
 	return 0;
 }
 
+static int disk_ram_access_readv(struct disk_info *disk,
+				 const struct disk_iovec *iov, size_t iovcnt,
+				 uint32_t sector)
+{
+	for (size_t i = 0; i < iovcnt; i++) {
+		memcpy(iov[i].buf, lba_to_address(sector),
+		       iov[i].num_sector * RAMDISK_SECTOR_SIZE);
+		sector += iov[i].num_sector;
+	}
+
+	return 0;
+}
+
+static int disk_ram_access_writev(struct disk_info *disk,
+				  const struct disk_iovec *iov, size_t iovcnt,
+				  uint32_t sector)
+{
+	for (size_t i = 0; i < iovcnt; i++) {
+		memcpy(lba_to_address(sector), iov[i].buf,
+		       iov[i].num_sector * RAMDISK_SECTOR_SIZE);
+		sector += iov[i].num_sector;
+	}
+
+	return 0;
+}
+
 static int disk_ram_access_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
 {
 	switch (cmd) {
@@ -78,6 +104,8 @@ static const struct disk_operations ram_disk_ops = {
 	.read = disk_ram_access_read,
 	.write = disk_ram_access_write,
 	.ioctl = disk_ram_access_ioctl,
+	.readv = disk_ram_access_readv,
+	.writev = disk_ram_access_writev,
 };
 
 static struct disk_info ram_disk = {
@@ -668,10 +668,11 @@ static int sdhc_spi_detect(const struct device *dev)
 }
 
 static int sdhc_spi_read(struct sdhc_spi_data *data,
-	uint8_t *buf, uint32_t sector, uint32_t count)
+	const struct disk_iovec *iov, size_t iovcnt, uint32_t sector)
 {
 	int err;
-	uint32_t addr;
+	uint32_t addr, count;
+	uint8_t *buf;
 
 	err = sdhc_map_disk_status(data->status);
 	if (err != 0) {
@@ -693,14 +694,19 @@ static int sdhc_spi_read(struct sdhc_spi_data *data,
 		goto error;
 	}
 
-	/* Read the sectors */
-	for (; count != 0U; count--) {
-		err = sdhc_spi_rx_block(data, buf, SDMMC_DEFAULT_BLOCK_SIZE);
-		if (err != 0) {
-			goto error;
-		}
+	/* Read the sectors, all the buffers in the same transfer */
+	for (; iovcnt != 0U; iov++, iovcnt--) {
+		buf = iov->buf;
 
-		buf += SDMMC_DEFAULT_BLOCK_SIZE;
+		for (count = iov->num_sector; count != 0U; count--) {
+			err = sdhc_spi_rx_block(data, buf,
+						SDMMC_DEFAULT_BLOCK_SIZE);
+			if (err != 0) {
+				goto error;
+			}
+
+			buf += SDMMC_DEFAULT_BLOCK_SIZE;
+		}
 	}
 
 	/* Ignore the error as STOP_TRANSMISSION always returns 0x7F */
@@ -772,10 +778,11 @@ error:
 
 /* this function is optimized to write multiple blocks */
 static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
-	const uint8_t *buf, uint32_t sector, uint32_t count)
+	const struct disk_iovec *iov, size_t iovcnt, uint32_t sector)
 {
 	int err;
-	uint32_t addr;
+	uint32_t addr, count;
+	const uint8_t *buf;
 	uint8_t block[SDHC_CRC16_SIZE];
 
 	err = sdhc_map_disk_status(data->status);
@@ -794,43 +801,47 @@ static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
 		goto exit;
 	}
 
-	/* Write the blocks */
-	for (; count != 0U; count--) {
-		/* Start the block */
-		block[0] = SDHC_TOKEN_MULTI_WRITE;
-		err = sdhc_spi_tx(data, block, 1);
-		if (err != 0) {
-			goto exit;
-		}
+	/* Write the blocks, all the buffers in the same transfer */
+	for (; iovcnt != 0U; iov++, iovcnt--) {
+		buf = iov->buf;
 
-		/* Write the payload */
-		err = sdhc_spi_tx(data, buf, SDMMC_DEFAULT_BLOCK_SIZE);
-		if (err != 0) {
-			goto exit;
-		}
+		for (count = iov->num_sector; count != 0U; count--) {
+			/* Start the block */
+			block[0] = SDHC_TOKEN_MULTI_WRITE;
+			err = sdhc_spi_tx(data, block, 1);
+			if (err != 0) {
+				goto exit;
+			}
 
-		/* Build and write the trailing CRC */
-		sys_put_be16(crc16_itu_t(0, buf, SDMMC_DEFAULT_BLOCK_SIZE),
-			     block);
+			/* Write the payload */
+			err = sdhc_spi_tx(data, buf, SDMMC_DEFAULT_BLOCK_SIZE);
+			if (err != 0) {
+				goto exit;
+			}
 
-		err = sdhc_spi_tx(data, block, sizeof(block));
-		if (err != 0) {
-			goto exit;
-		}
+			/* Build and write the trailing CRC */
+			sys_put_be16(crc16_itu_t(0, buf,
+						 SDMMC_DEFAULT_BLOCK_SIZE),
+				     block);
 
-		err = sdhc_map_data_status(sdhc_spi_rx_u8(data));
-		if (err != 0) {
-			goto exit;
-		}
+			err = sdhc_spi_tx(data, block, sizeof(block));
+			if (err != 0) {
+				goto exit;
+			}
 
-		/* Wait for the card to finish programming */
-		err = sdhc_spi_skip_until_ready(data);
-		if (err != 0) {
-			goto exit;
-		}
+			err = sdhc_map_data_status(sdhc_spi_rx_u8(data));
+			if (err != 0) {
+				goto exit;
+			}
 
-		buf += SDMMC_DEFAULT_BLOCK_SIZE;
-		sector++;
+			/* Wait for the card to finish programming */
+			err = sdhc_spi_skip_until_ready(data);
+			if (err != 0) {
+				goto exit;
+			}
+
+			buf += SDMMC_DEFAULT_BLOCK_SIZE;
+		}
 	}
 
 	/* Stop the transmission */
@@ -870,19 +881,45 @@ static int disk_spi_sdhc_access_status(struct disk_info *disk)
 	return data->status;
 }
 
+static int disk_spi_sdhc_access_readv(struct disk_info *disk,
+	const struct disk_iovec *iov, size_t iovcnt, uint32_t sector)
+{
+	const struct device *dev = disk->dev;
+	struct sdhc_spi_data *data = dev->data;
+	int err;
+
+	LOG_DBG("sector=%u iovcnt=%zu", sector, iovcnt);
+
+	err = sdhc_spi_read(data, iov, iovcnt, sector);
+	if (err != 0 && sdhc_is_retryable(err)) {
+		sdhc_spi_recover(data);
+		err = sdhc_spi_read(data, iov, iovcnt, sector);
+	}
+
+	return err;
+}
+
 static int disk_spi_sdhc_access_read(struct disk_info *disk,
 	uint8_t *buf, uint32_t sector, uint32_t count)
+{
+	const struct disk_iovec iov = { .buf = buf, .num_sector = count };
+
+	return disk_spi_sdhc_access_readv(disk, &iov, 1, sector);
+}
+
+static int disk_spi_sdhc_access_writev(struct disk_info *disk,
+	const struct disk_iovec *iov, size_t iovcnt, uint32_t sector)
 {
 	const struct device *dev = disk->dev;
 	struct sdhc_spi_data *data = dev->data;
 	int err;
 
-	LOG_DBG("sector=%u count=%u", sector, count);
+	LOG_DBG("multi block sector=%u iovcnt=%zu", sector, iovcnt);
 
-	err = sdhc_spi_read(data, buf, sector, count);
+	err = sdhc_spi_write_multi(data, iov, iovcnt, sector);
 	if (err != 0 && sdhc_is_retryable(err)) {
 		sdhc_spi_recover(data);
-		err = sdhc_spi_read(data, buf, sector, count);
+		err = sdhc_spi_write_multi(data, iov, iovcnt, sector);
 	}
 
 	return err;
@@ -897,13 +934,12 @@ static int disk_spi_sdhc_access_write(struct disk_info *disk,
 
 	/* for more than 2 blocks the multiple block is preferred */
 	if (count > 2) {
-		LOG_DBG("multi block sector=%u count=%u", sector, count);
+		const struct disk_iovec iov = {
+			.buf = (void *)buf,
+			.num_sector = count,
+		};
 
-		err = sdhc_spi_write_multi(data, buf, sector, count);
-		if (err != 0 && sdhc_is_retryable(err)) {
-			sdhc_spi_recover(data);
-			err = sdhc_spi_write_multi(data, buf, sector, count);
-		}
+		return disk_spi_sdhc_access_writev(disk, &iov, 1, sector);
 	} else {
 		LOG_DBG("sector=%u count=%u", sector, count);
 
@@ -965,6 +1001,8 @@ static const struct disk_operations spi_sdhc_disk_ops = {
 	.read = disk_spi_sdhc_access_read,
 	.write = disk_spi_sdhc_access_write,
 	.ioctl = disk_spi_sdhc_access_ioctl,
+	.readv = disk_spi_sdhc_access_readv,
+	.writev = disk_spi_sdhc_access_writev,
 };
 
 static struct disk_info spi_sdhc_disk = {
@@ -309,6 +309,17 @@ struct usdhc_data {
 	const uint32_t *tx_data;
 	/* Data buffer to write
 	 */
+	const struct disk_iovec *iov;
+	size_t iovcnt;
+	/* Buffers of a vectored transfer, rx_data or
+	 * tx_data then points to the first one
+	 */
+	size_t iov_idx;
+	uint32_t iov_start;
+	uint32_t iov_end;
+	/* Buffer being transferred and its
+	 * range of words in the transfer
+	 */
 };
 
 enum usdhc_dma_mode {
@@ -1165,6 +1176,29 @@ static inline uint32_t usdhc_read_data(USDHC_Type *base)
 	return base->DATA_BUFF_ACC_PORT;
 }
 
+/* Get the location of a word of the transfer, words of vectored transfers
+ * are accessed in order.
+ */
+static uint32_t *usdhc_data_word(struct usdhc_data *data, uint32_t word)
+{
+	uint32_t *buf = data->rx_data ? data->rx_data :
+		(uint32_t *)data->tx_data;
+
+	if (!data->iov) {
+		return &buf[word];
+	}
+
+	while (word >= data->iov_end) {
+		data->iov_idx++;
+		data->iov_start = data->iov_end;
+		data->iov_end += (data->iov[data->iov_idx].num_sector *
+			data->block_size) / sizeof(uint32_t);
+	}
+
+	return (uint32_t *)data->iov[data->iov_idx].buf +
+		(word - data->iov_start);
+}
+
 static uint32_t usdhc_read_data_port(struct usdhc_priv *priv,
 	uint32_t xfered_words)
 {
@@ -1199,7 +1233,8 @@ static uint32_t usdhc_read_data_port(struct usdhc_priv *priv,
 
 		i = 0U;
 		while (i < remaing_words) {
-			data->rx_data[xfered_words++] = usdhc_read_data(base);
+			*usdhc_data_word(data, xfered_words++) =
+				usdhc_read_data(base);
 			i++;
 		}
 	}
@@ -1298,7 +1333,8 @@ static uint32_t usdhc_write_data_port(struct usdhc_priv *priv,
 
 		i = 0U;
 		while (i < remaing_words) {
-			usdhc_write_data(base, data->tx_data[xfered_words++]);
+			usdhc_write_data(base,
+				*usdhc_data_word(data, xfered_words++));
 			i++;
 		}
 	}
@@ -1434,10 +1470,11 @@ static int usdhc_xfer(struct usdhc_priv *priv)
 	}
 
 	/* Update ADMA descriptor table according to different DMA mode
-	 * (no DMA, ADMA1, ADMA2).
+	 * (no DMA, ADMA1, ADMA2). Vectored transfers are polled.
 	 */
 
-	if (data && (!execute_tuning) && priv->op_context.dma_cfg.adma_table)
+	if (data && (!execute_tuning) && (!data->iov) &&
+		priv->op_context.dma_cfg.adma_table)
 		error = usdhc_adma_table_cfg(priv,
 			(data->data_type & USDHC_XFER_BOOT) ?
 			USDHC_ADMA_MUTI_FLAG : USDHC_ADMA_SINGLE_FLAG);
@@ -2109,6 +2146,48 @@ static int usdhc_read_sector(void *bus_data, uint8_t *buf, uint32_t sector,
 	return usdhc_xfer(priv);
 }
 
+/* Transfer consecutive sectors to or from several buffers with a single
+ * multiple block command.
+ */
+static int usdhc_xfer_sectorv(struct usdhc_priv *priv,
+	const struct disk_iovec *iov, size_t iovcnt, uint32_t sector,
+	bool write)
+{
+	struct usdhc_cmd *cmd = &priv->op_context.cmd;
+	struct usdhc_data *data = &priv->op_context.data;
+
+	memset((char *)cmd, 0, sizeof(struct usdhc_cmd));
+	memset((char *)data, 0, sizeof(struct usdhc_data));
+
+	priv->op_context.cmd_only = 0;
+	data->block_size = priv->card_info.sd_block_size;
+	for (size_t i = 0; i < iovcnt; i++) {
+		data->block_count += iov[i].num_sector;
+	}
+	if (write) {
+		cmd->index = SDHC_WRITE_MULTIPLE_BLOCK;
+		data->tx_data = (const uint32_t *)iov[0].buf;
+	} else {
+		cmd->index = SDHC_READ_MULTIPLE_BLOCK;
+		data->rx_data = (uint32_t *)iov[0].buf;
+	}
+	data->cmd12 = true;
+	data->iov = iov;
+	data->iovcnt = iovcnt;
+	data->iov_end = (iov[0].num_sector * data->block_size) /
+		sizeof(uint32_t);
+
+	cmd->argument = sector;
+	if (!(priv->card_info.card_flags & SDHC_HIGH_CAPACITY_FLAG)) {
+		cmd->argument *= priv->card_info.sd_block_size;
+	}
+
+	cmd->rsp_type = SDHC_RSP_TYPE_R1;
+	cmd->rsp_err_flags = SDHC_R1ERR_All_FLAG;
+
+	return usdhc_xfer(priv);
+}
+
 static bool usdhc_set_sd_active(USDHC_Type *base)
 {
 	uint32_t timeout = 0xffff;
@@ -2740,6 +2819,30 @@ static int disk_usdhc_access_write(struct disk_info *disk, const uint8_t *buf,
 	return usdhc_write_sector(priv, buf, sector, count);
 }
 
+static int disk_usdhc_access_readv(struct disk_info *disk,
+				   const struct disk_iovec *iov, size_t iovcnt,
+				   uint32_t sector)
+{
+	const struct device *dev = disk->dev;
+	struct usdhc_priv *priv = dev->data;
+
+	LOG_DBG("sector=%u iovcnt=%zu", sector, iovcnt);
+
+	return usdhc_xfer_sectorv(priv, iov, iovcnt, sector, false);
+}
+
+static int disk_usdhc_access_writev(struct disk_info *disk,
+				    const struct disk_iovec *iov,
+				    size_t iovcnt, uint32_t sector)
+{
+	const struct device *dev = disk->dev;
+	struct usdhc_priv *priv = dev->data;
+
+	LOG_DBG("sector=%u iovcnt=%zu", sector, iovcnt);
+
+	return usdhc_xfer_sectorv(priv, iov, iovcnt, sector, true);
+}
+
 static int disk_usdhc_access_ioctl(struct disk_info *disk, uint8_t cmd, void *buf)
 {
 	const struct device *dev = disk->dev;
@@ -2789,6 +2892,8 @@ static const struct disk_operations usdhc_disk_ops = {
 	.read = disk_usdhc_access_read,
 	.write = disk_usdhc_access_write,
 	.ioctl = disk_usdhc_access_ioctl,
+	.readv = disk_usdhc_access_readv,
+	.writev = disk_usdhc_access_writev,
 };
 
 static struct disk_info usdhc_disk = {
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <init.h>
+#include <kernel.h>
+#include <drivers/flash.h>
+
+#include "flash_async.h"
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(flash_async, CONFIG_FLASH_LOG_LEVEL);
+
+void flash_async_queue_init(struct flash_async_queue *queue)
+{
+	sys_slist_init(&queue->reqs);
+}
+
+/* Requests are merged when the second one continues the first one, both in
+ * flash and in memory.
+ */
+static bool req_mergeable(const struct flash_async_req *last,
+			  const struct flash_async_req *req)
+{
+	if ((last->op != req->op) ||
+	    (last->offset + last->batch_len != req->offset)) {
+		return false;
+	}
+
+	return (req->op == FLASH_ASYNC_OP_ERASE) ||
+	       ((uint8_t *)last->data + last->batch_len == req->data);
+}
+
+void flash_async_queue_put(struct flash_async_queue *queue,
+			   struct flash_async_req *req)
+{
+	struct flash_async_req *last, *tail;
+	k_spinlock_key_t key;
+
+	req->merged = NULL;
+	req->batch_len = req->len;
+
+	key = k_spin_lock(&queue->lock);
+
+	last = SYS_SLIST_PEEK_TAIL_CONTAINER(&queue->reqs, last, node);
+	if (last && req_mergeable(last, req)) {
+		for (tail = last; tail->merged; tail = tail->merged) {
+		}
+		tail->merged = req;
+		last->batch_len += req->len;
+	} else {
+		sys_slist_append(&queue->reqs, &req->node);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+}
+
+struct flash_async_req *flash_async_queue_get(struct flash_async_queue *queue)
+{
+	struct flash_async_req *req;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	key = k_spin_lock(&queue->lock);
+	node = sys_slist_get(&queue->reqs);
+	k_spin_unlock(&queue->lock, key);
+
+	return SYS_SLIST_CONTAINER(node, req, node);
+}
+
+int flash_async_execute(const struct device *dev, struct flash_async_req *req)
+{
+	switch (req->op) {
+	case FLASH_ASYNC_OP_READ:
+		return flash_read(dev, req->offset, req->data, req->batch_len);
+	case FLASH_ASYNC_OP_WRITE:
+		return flash_write(dev, req->offset, req->data, req->batch_len);
+	case FLASH_ASYNC_OP_ERASE:
+		return flash_erase(dev, req->offset, req->batch_len);
+	default:
+		return -EINVAL;
+	}
+}
+
+void flash_async_complete(const struct device *dev,
+			  struct flash_async_req *req, int result)
+{
+	struct flash_async_req *next;
+
+	for (; req; req = next) {
+		/* The request can be reused by its completion */
+		next = req->merged;
+
+		if (req->cb) {
+			req->cb(dev, req, result);
+		}
+		if (req->signal) {
+			k_poll_signal_raise(req->signal, result);
+		}
+	}
+}
+
+/* Devices without async_submit handler share a work queue, which executes
+ * their requests with the synchronous API.
+ */
+struct flash_async_ctx {
+	const struct device *dev;
+	struct flash_async_queue queue;
+	struct k_work work;
+};
+
+static struct flash_async_ctx async_ctx[CONFIG_FLASH_ASYNC_DEVICES];
+static struct k_spinlock async_ctx_lock;
+
+static K_THREAD_STACK_DEFINE(async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q async_workq;
+
+static void async_work_handler(struct k_work *work)
+{
+	struct flash_async_ctx *ctx = CONTAINER_OF(work, struct flash_async_ctx,
+						   work);
+	struct flash_async_req *req;
+
+	while ((req = flash_async_queue_get(&ctx->queue)) != NULL) {
+		flash_async_complete(ctx->dev, req,
+				     flash_async_execute(ctx->dev, req));
+	}
+}
+
+static struct flash_async_ctx *async_ctx_get(const struct device *dev)
+{
+	struct flash_async_ctx *ctx = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&async_ctx_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(async_ctx); i++) {
+		if (async_ctx[i].dev == dev) {
+			ctx = &async_ctx[i];
+			break;
+		}
+
+		if (!ctx && !async_ctx[i].dev) {
+			ctx = &async_ctx[i];
+		}
+	}
+
+	if (ctx && !ctx->dev) {
+		ctx->dev = dev;
+		flash_async_queue_init(&ctx->queue);
+		k_work_init(&ctx->work, async_work_handler);
+	}
+
+	k_spin_unlock(&async_ctx_lock, key);
+
+	return ctx;
+}
+
+static int async_submit(const struct device *dev, enum flash_async_op op,
+			off_t offset, void *data, size_t len,
+			struct flash_async_req *req)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+	struct flash_async_ctx *ctx;
+	int rc;
+
+	if (!req || !len) {
+		return -EINVAL;
+	}
+
+	req->op = op;
+	req->offset = offset;
+	req->data = data;
+	req->len = len;
+
+	if (api->async_submit) {
+		return api->async_submit(dev, req);
+	}
+
+	ctx = async_ctx_get(dev);
+	if (!ctx) {
+		LOG_ERR("No asynchronous context left for %s", dev->name);
+		return -ENOMEM;
+	}
+
+	flash_async_queue_put(&ctx->queue, req);
+
+	rc = k_work_submit_to_queue(&async_workq, &ctx->work);
+
+	return (rc < 0) ? rc : 0;
+}
+
+int flash_read_async(const struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_req *req)
+{
+	return async_submit(dev, FLASH_ASYNC_OP_READ, offset, data, len, req);
+}
+
+int flash_write_async(const struct device *dev, off_t offset,
+		      const void *data, size_t len,
+		      struct flash_async_req *req)
+{
+	return async_submit(dev, FLASH_ASYNC_OP_WRITE, offset, (void *)data,
+			    len, req);
+}
+
+int flash_erase_async(const struct device *dev, off_t offset, size_t size,
+		      struct flash_async_req *req)
+{
+	return async_submit(dev, FLASH_ASYNC_OP_ERASE, offset, NULL, size,
+			    req);
+}
+
+static int flash_async_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "flash_async",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&async_workq, async_stack,
+			   K_THREAD_STACK_SIZEOF(async_stack),
+			   CONFIG_FLASH_ASYNC_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_FLASH_FLASH_ASYNC_H_
+#define ZEPHYR_DRIVERS_FLASH_FLASH_ASYNC_H_
+
+#include <kernel.h>
+#include <drivers/flash.h>
+
+/* Queue of the pending asynchronous requests of a device, for the drivers
+ * implementing the async_submit handler.
+ */
+struct flash_async_queue {
+	sys_slist_t reqs;
+	struct k_spinlock lock;
+};
+
+void flash_async_queue_init(struct flash_async_queue *queue);
+
+/* Append a request to the queue, or merge it with the last queued one. */
+void flash_async_queue_put(struct flash_async_queue *queue,
+			   struct flash_async_req *req);
+
+/* Remove the first request from the queue, NULL if the queue is empty. The
+ * request carries the requests merged with it and req->batch_len is the
+ * length of the whole operation.
+ */
+struct flash_async_req *flash_async_queue_get(struct flash_async_queue *queue);
+
+/* Execute a request with the synchronous API of the device. */
+int flash_async_execute(const struct device *dev, struct flash_async_req *req);
+
+/* Notify the completion of a request and of the requests merged with it. */
+void flash_async_complete(const struct device *dev,
+			  struct flash_async_req *req, int result);
+
+#endif /* ZEPHYR_DRIVERS_FLASH_FLASH_ASYNC_H_ */
@@ -15,6 +15,10 @@
 #include <stats/stats.h>
 #include <string.h>
 
+#ifdef CONFIG_FLASH_ASYNC
+#include "flash_async.h"
+#endif
+
 #ifdef CONFIG_ARCH_POSIX
 
 #include <unistd.h>
@@ -334,6 +338,78 @@ flash_sim_get_parameters(const struct device *dev)
 	return &flash_sim_parameters;
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+/* Asynchronous requests are executed one at a time by a delayed work, after
+ * the simulated latency of the operation. The flash content is updated when
+ * the request completes.
+ */
+static struct flash_async_queue flash_sim_async_queue;
+static struct flash_async_req *flash_sim_async_cur;
+static struct k_spinlock flash_sim_async_lock;
+static struct k_work_delayable flash_sim_async_work;
+static const struct device *flash_sim_async_dev;
+
+static uint32_t flash_sim_async_latency(const struct flash_async_req *req)
+{
+	switch (req->op) {
+	case FLASH_ASYNC_OP_READ:
+		return CONFIG_FLASH_SIMULATOR_ASYNC_READ_LATENCY_US;
+	case FLASH_ASYNC_OP_WRITE:
+		return CONFIG_FLASH_SIMULATOR_ASYNC_WRITE_LATENCY_US;
+	default:
+		return CONFIG_FLASH_SIMULATOR_ASYNC_ERASE_LATENCY_US *
+		       DIV_ROUND_UP(req->batch_len, FLASH_SIMULATOR_ERASE_UNIT);
+	}
+}
+
+/* Start the next request, called with flash_sim_async_lock held */
+static void flash_sim_async_start(void)
+{
+	if (flash_sim_async_cur) {
+		return;
+	}
+
+	flash_sim_async_cur = flash_async_queue_get(&flash_sim_async_queue);
+	if (flash_sim_async_cur) {
+		k_work_schedule(&flash_sim_async_work,
+				K_USEC(flash_sim_async_latency(
+					       flash_sim_async_cur)));
+	}
+}
+
+static void flash_sim_async_handler(struct k_work *work)
+{
+	struct flash_async_req *req = flash_sim_async_cur;
+	k_spinlock_key_t key;
+	int rc;
+
+	rc = flash_async_execute(flash_sim_async_dev, req);
+	flash_async_complete(flash_sim_async_dev, req, rc);
+
+	key = k_spin_lock(&flash_sim_async_lock);
+	flash_sim_async_cur = NULL;
+	flash_sim_async_start();
+	k_spin_unlock(&flash_sim_async_lock, key);
+}
+
+static int flash_sim_async_submit(const struct device *dev,
+				  struct flash_async_req *req)
+{
+	k_spinlock_key_t key;
+
+	if (!flash_range_is_valid(dev, req->offset, req->len)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&flash_sim_async_lock);
+	flash_async_queue_put(&flash_sim_async_queue, req);
+	flash_sim_async_start();
+	k_spin_unlock(&flash_sim_async_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 static const struct flash_driver_api flash_sim_api = {
 	.read = flash_sim_read,
 	.write = flash_sim_write,
@@ -342,6 +418,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_ASYNC
+	.async_submit = flash_sim_async_submit,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
@@ -411,6 +490,11 @@ static int flash_init(const struct device *dev)
 	STATS_INIT_AND_REG(flash_sim_stats, STATS_SIZE_32, "flash_sim_stats");
 	STATS_INIT_AND_REG(flash_sim_thresholds, STATS_SIZE_32,
 			   "flash_sim_thresholds");
+#ifdef CONFIG_FLASH_ASYNC
+	flash_sim_async_dev = dev;
+	flash_async_queue_init(&flash_sim_async_queue);
+	k_work_init_delayable(&flash_sim_async_work, flash_sim_async_handler);
+#endif
 	return flash_mock_init(dev);
 }
 
@@ -473,6 +473,11 @@ int bt_l2cap_chan_disconnect(struct bt_l2cap_chan *chan);
  *  When segmenting an L2CAP SDU into L2CAP PDUs the stack will first attempt
  *  to allocate buffers from the original buffer pool of the L2CAP SDU before
  *  using the stacks own buffer pool.
+ *  An SDU can also be sent without any copy as a chain of fragments which
+ *  each fit in the MPS of the peer, the first one including the SDU length:
+ *  each fragment is then used as a segment directly if the first one has
+ *  @ref BT_L2CAP_SDU_CHAN_SEND_RESERVE bytes of headroom and the following
+ *  ones @ref BT_L2CAP_CHAN_SEND_RESERVE bytes.
  *
  *  @note Buffer ownership is transferred to the stack in case of success, in
  *  case of an error the caller retains the ownership of the buffer.
@@ -14,8 +14,14 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#define FLASH_IMG_BUF_CNT CONFIG_STREAM_FLASH_PIPELINE_BUFFERS
+#else
+#define FLASH_IMG_BUF_CNT 1
+#endif
+
 struct flash_img_context {
-	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE * FLASH_IMG_BUF_CNT];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
@@ -62,6 +62,18 @@ extern "C" {
 
 struct disk_operations;
 
+/**
+ * @brief Buffer of a vectored disk transfer
+ *
+ * The buffers of a transfer are mapped to consecutive sectors.
+ */
+struct disk_iovec {
+	/** Data buffer */
+	void *buf;
+	/** Number of sectors transferred to or from the buffer */
+	uint32_t num_sector;
+};
+
 /**
  * @brief Disk info
  */
@@ -74,6 +86,16 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Internally used by the disk cache: sectors per erase block,
+	 * 0 when the disk is not cached
+	 */
+	uint32_t cache_erase_sectors;
+	/** Internally used by the disk cache: number of sectors */
+	uint32_t cache_sector_count;
+	/** Internally used by the disk cache: end of the last read */
+	uint32_t cache_read_next;
+#endif
 };
 
 /**
@@ -87,6 +109,12 @@ struct disk_operations {
 	int (*write)(struct disk_info *disk, const uint8_t *data_buf,
 		     uint32_t start_sector, uint32_t num_sector);
 	int (*ioctl)(struct disk_info *disk, uint8_t cmd, void *buff);
+	/** Optional, read consecutive sectors into several buffers */
+	int (*readv)(struct disk_info *disk, const struct disk_iovec *iov,
+		     size_t iovcnt, uint32_t start_sector);
+	/** Optional, write consecutive sectors from several buffers */
+	int (*writev)(struct disk_info *disk, const struct disk_iovec *iov,
+		      size_t iovcnt, uint32_t start_sector);
 };
 
 /**
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <device.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -127,6 +128,18 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 				   void *data, size_t len);
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 
+struct flash_async_req;
+
+/**
+ * @brief Asynchronous request submission handler type
+ *
+ * The request is queued after the pending requests of the device and may be
+ * merged with the last of them. Drivers without this handler get their
+ * asynchronous requests executed by a common work queue thread.
+ */
+typedef int (*flash_api_async_submit)(const struct device *dev,
+				      struct flash_async_req *req);
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -140,6 +153,9 @@ __subsystem struct flash_driver_api {
 	flash_api_sfdp_read sfdp_read;
 	flash_api_read_jedec_id read_jedec_id;
 #endif /* CONFIG_FLASH_JESD216_API */
+#if defined(CONFIG_FLASH_ASYNC)
+	flash_api_async_submit async_submit;
+#endif /* CONFIG_FLASH_ASYNC */
 };
 
 /**
@@ -278,6 +294,108 @@ static inline int z_impl_flash_erase(const struct device *dev, off_t offset,
 	return rc;
 }
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+
+struct k_poll_signal;
+
+/** @brief Asynchronous flash operations */
+enum flash_async_op {
+	FLASH_ASYNC_OP_READ,
+	FLASH_ASYNC_OP_WRITE,
+	FLASH_ASYNC_OP_ERASE,
+};
+
+/**
+ * @brief Asynchronous request completion callback
+ *
+ * @param dev    : flash device
+ * @param req    : completed request, it can be reused from the callback
+ * @param result : 0 on success, negative errno code on fail
+ */
+typedef void (*flash_async_cb_t)(const struct device *dev,
+				 struct flash_async_req *req, int result);
+
+/**
+ * @brief Asynchronous flash request
+ *
+ * The request and its data buffer belong to the flash driver from the
+ * submission until the completion is notified.
+ */
+struct flash_async_req {
+	/** Completion callback, may be NULL. It is called from a work queue
+	 *  or from the driver interrupt, so it must not block.
+	 */
+	flash_async_cb_t cb;
+	/** Signal raised with the result on completion, may be NULL */
+	struct k_poll_signal *signal;
+	/** User data, for the use of the callback */
+	void *user_data;
+
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	struct flash_async_req *merged;
+	enum flash_async_op op;
+	off_t offset;
+	void *data;
+	size_t len;
+	size_t batch_len;
+	/** @endcond */
+};
+
+/**
+ *  @brief  Submit an asynchronous read
+ *
+ *  The requests of a device are executed in order. Consecutive requests of
+ *  the same operation on adjacent flash areas and adjacent buffers are
+ *  merged into a single driver operation, each request is still completed
+ *  separately.
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : offset (byte aligned) to read
+ *  @param  data            : buffer to store read data, valid until
+ *                            completion
+ *  @param  len             : number of bytes to read
+ *  @param  req             : request, with the completion fields set
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ */
+int flash_read_async(const struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_req *req);
+
+/**
+ *  @brief  Submit an asynchronous write
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : starting offset for the write
+ *  @param  data            : data to write, valid until completion
+ *  @param  len             : number of bytes to write
+ *  @param  req             : request, with the completion fields set
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ *
+ *  @see flash_read_async()
+ */
+int flash_write_async(const struct device *dev, off_t offset,
+		      const void *data, size_t len,
+		      struct flash_async_req *req);
+
+/**
+ *  @brief  Submit an asynchronous erase
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : erase area starting offset
+ *  @param  size            : size of area to be erased
+ *  @param  req             : request, with the completion fields set
+ *
+ *  @return  0 if the request is queued, negative errno code on fail.
+ *
+ *  @see flash_read_async()
+ */
+int flash_erase_async(const struct device *dev, off_t offset, size_t size,
+		      struct flash_async_req *req);
+
+#endif /* CONFIG_FLASH_ASYNC */
+
 /**
  *  @brief  Enable or disable write protection for a flash memory
  *
@@ -583,6 +583,34 @@ int fs_stat(const char *path, struct fs_dirent *entry);
  */
 int fs_statvfs(const char *path, struct fs_statvfs *stat);
 
+#ifdef CONFIG_FS_CACHE
+/**
+ * @brief Statistics of the file system core caches
+ */
+struct fs_cache_stats {
+	/** fs_stat() calls served by the stat cache */
+	uint32_t stat_hits;
+	/** fs_stat() calls passed to the file system */
+	uint32_t stat_misses;
+	/** Stat cache entries invalidated by modifications */
+	uint32_t stat_invalidations;
+	/** fs_read() calls served by a read-ahead buffer */
+	uint32_t ra_hits;
+	/** Reads ahead from the file system */
+	uint32_t ra_fills;
+};
+
+/**
+ * @brief Get the statistics of the file system core caches
+ *
+ * @param stats Pointer to the structure to fill
+ *
+ * @retval 0 on success;
+ * @retval <0 negative errno code on error.
+ */
+int fs_cache_stats_get(struct fs_cache_stats *stats);
+#endif /* CONFIG_FS_CACHE */
+
 /**
  * @brief Register a file system
  *
@@ -36,6 +36,7 @@ extern "C" {
 typedef uint8_t fs_mode_t;
 
 struct fs_mount_t;
+struct fs_read_ahead;
 
 /**
  * @addtogroup file_system_api
@@ -54,6 +55,12 @@ struct fs_file_t {
 	void *filep;
 	const struct fs_mount_t *mp;
 	fs_mode_t flags;
+#ifdef CONFIG_FS_READ_AHEAD
+	/* Read-ahead buffer, managed by the file system core */
+	struct fs_read_ahead *ra;
+	/* Number of consecutive reads */
+	uint8_t ra_seq;
+#endif
 };
 
 /**
@@ -30,6 +30,31 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection statistics
+ *
+ * Durations are in microseconds and include the closing of the sector. A
+ * background garbage collection is done in steps, its durations are the ones
+ * of the steps.
+ *
+ * @param fg_count Number of garbage collections done by nvs_write()
+ * @param fg_max_us Longest garbage collection done by nvs_write()
+ * @param fg_total_us Total duration of the garbage collections done by
+ * nvs_write()
+ * @param bg_count Number of garbage collections done in the background
+ * @param bg_max_us Longest background garbage collection step
+ * @param bg_total_us Total duration of the background garbage collection
+ * steps
+ */
+struct nvs_gc_stats {
+	uint32_t fg_count;
+	uint32_t fg_max_us;
+	uint32_t fg_total_us;
+	uint32_t bg_count;
+	uint32_t bg_max_us;
+	uint32_t bg_total_us;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -43,6 +68,20 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Lookup cache, ATE address of the most recent entry of
+ * the IDs hashed to each position
+ * @param gc_work Background garbage collection work
+ * @param gc_work_init Background garbage collection work is initialized, must
+ * be zero before the first call to nvs_init(), see nvs_init()
+ * @param gc_armed Background garbage collection is allowed
+ * @param gc_active Background garbage collection is in progress
+ * @param gc_addr Address of the last allocation table entry handled by the
+ * background garbage collection
+ * @param gc_stop_addr Address of the first allocation table entry of the
+ * sector being garbage collected
+ * @param gc_data_end Offset bounding the data left to move by the background
+ * garbage collection
+ * @param gc_stats Garbage collection statistics
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +96,21 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work gc_work;
+	bool gc_work_init;
+	bool gc_armed;
+	bool gc_active;
+	uint32_t gc_addr;
+	uint32_t gc_stop_addr;
+	uint16_t gc_data_end;
+#endif
+#ifdef CONFIG_NVS_GC_STATS
+	struct nvs_gc_stats gc_stats;
+#endif
 };
 
 /**
@@ -75,6 +129,13 @@ struct nvs_fs {
  *
  * Initializes a NVS file system in flash.
  *
+ * With CONFIG_NVS_BACKGROUND_GC the gc_work_init field of the file system
+ * must be zero before the first call, as it tells whether a background
+ * garbage collection of an earlier initialization must be cancelled. This is
+ * the case for a file system with static storage, any other one must be
+ * zeroed (e.g. with memset()) before it is first initialized. An initialized
+ * file system may be initialized again.
+ *
  * @param fs Pointer to file system
  * @param dev_name Pointer to flash device name
  * @retval 0 Success
@@ -170,6 +231,19 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_stats_get
+ *
+ * Get the garbage collection statistics of the file system, they are
+ * reset by nvs_init().
+ *
+ * @param fs Pointer to file system
+ * @param stats Pointer to the statistics to fill
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats);
+
 /**
  * @}
  */
@@ -289,6 +289,13 @@ static inline char z_log_minimal_level_to_char(int level)
 
 #define Z_LOG_INST(_inst) COND_CODE_1(CONFIG_LOG, (_inst), NULL)
 
+/* Rate limiting is skipped in user context since the dynamic data of the
+ * source is not accessible there.
+ */
+#define Z_LOG_RATE_LIMIT_CHECK(_is_user_context, _dsource, _level) \
+	(!IS_ENABLED(CONFIG_LOG_RATE_LIMIT) || (_is_user_context) || \
+	 z_log_rate_limit_check(_dsource, _level))
+
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
@@ -308,6 +315,9 @@ static inline char z_log_minimal_level_to_char(int level)
 	    _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATE_LIMIT_CHECK(is_user_context, _dsource, _level)) { \
+		break; \
+	} \
 	if (IS_ENABLED(CONFIG_LOG2)) { \
 		int _mode; \
 		void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
@@ -360,6 +370,9 @@ static inline char z_log_minimal_level_to_char(int level)
 	    _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATE_LIMIT_CHECK(is_user_context, _dsource, _level)) { \
+		break; \
+	} \
 	if (IS_ENABLED(CONFIG_LOG2)) { \
 		int mode; \
 		void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
@@ -742,6 +755,20 @@ uint32_t z_log_dropped_read_and_clear(void);
  */
 bool z_log_dropped_pending(void);
 
+/** @brief Check if a log message passes the rate limit of its source.
+ *
+ * Updates the rate limiting state of the source and counts the message as
+ * suppressed if it does not pass.
+ *
+ * @param source Dynamic data of the log source.
+ * @param level  Severity level of the message.
+ *
+ * @retval true Message shall be logged.
+ * @retval false Message exceeds the rate limit and shall be dropped.
+ */
+bool z_log_rate_limit_check(struct log_source_dynamic_data *source,
+			    uint8_t level);
+
 /** @brief Log a message from user mode context.
  *
  * @note This function is intended to be used internally
@@ -169,6 +169,44 @@ void log_backend_enable(struct log_backend const *const backend,
  */
 void log_backend_disable(struct log_backend const *const backend);
 
+/**
+ * @brief Set rate limiting parameters.
+ *
+ * Parameters apply to all log sources and levels. Requires
+ * CONFIG_LOG_RATE_LIMIT.
+ *
+ * @param burst		Number of messages passed before a source is limited.
+ * @param rate		Number of messages per second passed when limited.
+ * @param sample	Pass one in @p sample messages exceeding the limit, 0
+ *			to suppress all of them.
+ */
+void log_rate_limit_set(uint16_t burst, uint16_t rate, uint16_t sample);
+
+/**
+ * @brief Get rate limiting parameters.
+ *
+ * @param burst		Location for the burst size.
+ * @param rate		Location for the rate.
+ * @param sample	Location for the sampling ratio.
+ */
+void log_rate_limit_get(uint16_t *burst, uint16_t *rate, uint16_t *sample);
+
+/**
+ * @brief Get number of messages suppressed by rate limiting.
+ *
+ * @param source_id	Source ID.
+ * @param level		Severity level.
+ *
+ * @return Number of suppressed messages.
+ */
+uint32_t log_rate_limit_suppressed_get(uint32_t source_id, uint32_t level);
+
+/**
+ * @brief Reset rate limiting state and suppressed messages counters of all
+ *	  sources.
+ */
+void log_rate_limit_reset(void);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_INIT() log_init()
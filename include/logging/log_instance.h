@@ -7,6 +7,7 @@
 #define ZEPHYR_INCLUDE_LOGGING_LOG_INSTANCE_H_
 
 #include <zephyr/types.h>
+#include <sys/atomic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,9 +26,25 @@ struct log_source_const_data {
 #endif
 };
 
+/** @brief Rate limiting state of one severity level of a log source. */
+struct log_source_rate_limit {
+	/** Uptime in milliseconds when the bucket was last refilled. */
+	atomic_t stamp;
+	/** Tokens used from the bucket. */
+	atomic_t used;
+	/** Number of messages exceeding the limit, used for sampling. */
+	atomic_t limited;
+	/** Number of suppressed messages. */
+	atomic_t suppressed;
+};
+
 /** @brief Dynamic data associated with the source of log messages. */
 struct log_source_dynamic_data {
 	uint32_t filters;
+#ifdef CONFIG_LOG_RATE_LIMIT
+	/* One bucket for each level, error to debug. */
+	struct log_source_rate_limit rate_limit[4];
+#endif
 #ifdef CONFIG_NIOS2
 	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
 	 * Nios2 uses global pointer register for structures <=8 bytes and
@@ -35,7 +52,8 @@ struct log_source_dynamic_data {
 	 */
 	uint32_t dummy[2];
 #endif
-#if defined(CONFIG_RISCV) && defined(CONFIG_64BIT)
+#if defined(CONFIG_RISCV) && defined(CONFIG_64BIT) && \
+	!defined(CONFIG_LOG_RATE_LIMIT)
 	/* Workaround: RV64 needs to ensure that structure is just 8 bytes. */
 	uint32_t dummy;
 #endif
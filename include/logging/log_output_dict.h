@@ -25,6 +25,23 @@ enum log_dict_output_msg_type {
 	MSG_DROPPED_MSG = 1,
 };
 
+/** First byte of the frame sync pattern. */
+#define LOG_DICT_OUTPUT_FRAME_SYNC0 0xA5
+
+/** Second byte of the frame sync pattern. */
+#define LOG_DICT_OUTPUT_FRAME_SYNC1 0x5A
+
+/**
+ * Frame header used with CONFIG_LOG_DICTIONARY_FRAMING.
+ *
+ * The header is followed by one log record of @p len bytes and the
+ * CRC16-CCITT (seed 0xFFFF) of the record, both in target endianness.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t sync[2];
+	uint16_t len;
+} __packed;
+
 /**
  * Output header for one dictionary based log message.
  */
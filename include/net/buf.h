@@ -909,6 +909,25 @@ static inline void net_buf_simple_restore(struct net_buf_simple *buf,
  */
 #define NET_BUF_EXTERNAL_DATA  BIT(1)
 
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+/**
+ * @brief Allocation record of a network buffer.
+ *
+ * Filled in when the buffer is allocated, if CONFIG_NET_BUF_ALLOC_TRACE is
+ * enabled.
+ */
+struct net_buf_trace {
+	/** Return address of the allocation call, identifies the caller. */
+	void *site;
+
+	/** Thread which allocated the buffer. */
+	k_tid_t owner;
+
+	/** Uptime of the allocation, in milliseconds. */
+	uint32_t time;
+};
+#endif /* CONFIG_NET_BUF_ALLOC_TRACE */
+
 /**
  * @brief Network buffer representation.
  *
@@ -959,6 +978,11 @@ struct net_buf {
 		struct net_buf_simple b;
 	};
 
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	/** Allocation record, valid while the buffer is allocated. */
+	struct net_buf_trace trace;
+#endif
+
 	/** System metadata for this buffer. */
 	uint8_t user_data[CONFIG_NET_BUF_USER_DATA_SIZE] __net_buf_align;
 };
@@ -975,6 +999,16 @@ struct net_buf_data_alloc {
 	void *alloc_data;
 };
 
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+/** @cond INTERNAL_HIDDEN */
+struct net_buf_cpu_cache {
+	struct k_spinlock lock;
+	uint8_t count;
+	struct net_buf *bufs[CONFIG_NET_BUF_CPU_CACHE_SIZE];
+};
+/** @endcond */
+#endif /* CONFIG_NET_BUF_CPU_CACHE */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1009,6 +1043,14 @@ struct net_buf_pool {
 
 	/** Start of buffer storage array */
 	struct net_buf * const __bufs;
+
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+	/** Free buffers of fixed size pools, cached by each CPU. */
+	struct net_buf_cpu_cache cpu_cache[CONFIG_MP_NUM_CPUS];
+
+	/** Number of threads waiting for the LIFO. */
+	atomic_t waiters;
+#endif /* CONFIG_NET_BUF_CPU_CACHE */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1197,6 +1239,31 @@ extern const struct net_buf_data_cb net_buf_var_cb;
  */
 struct net_buf_pool *net_buf_pool_get(int id);
 
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+/**
+ * @typedef net_buf_trace_cb_t
+ * @brief Callback used while iterating over the allocated buffers of a pool.
+ *
+ * @param buf Allocated buffer, see buf->trace.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*net_buf_trace_cb_t)(struct net_buf *buf, void *user_data);
+
+/**
+ * @brief Go through the allocated buffers of a pool.
+ *
+ * Intended for diagnostics, e.g. to find out which code holds the buffers
+ * of an exhausted pool. The buffers can be freed or allocated while they
+ * are being iterated over, so the result is only a snapshot.
+ *
+ * @param pool Pool to go through.
+ * @param cb User-supplied callback function to call.
+ * @param user_data User specified data.
+ */
+void net_buf_pool_trace_foreach(struct net_buf_pool *pool,
+				net_buf_trace_cb_t cb, void *user_data);
+#endif /* CONFIG_NET_BUF_ALLOC_TRACE */
+
 /**
  * @brief Get a zero-based index for a buffer.
  *
@@ -1326,6 +1393,12 @@ struct net_buf *net_buf_get_debug(struct k_fifo *fifo, k_timeout_t timeout,
 struct net_buf *net_buf_get(struct k_fifo *fifo, k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+bool net_buf_cpu_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+#endif
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1339,6 +1412,12 @@ static inline void net_buf_destroy(struct net_buf *buf)
 {
 	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
 
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+	if (net_buf_cpu_cache_put(pool, buf)) {
+		return;
+	}
+#endif
+
 	k_lifo_put(&pool->free, buf);
 }
 
@@ -292,6 +292,11 @@ __net_socket struct net_context {
 	int can_filter_id;
 #endif /* CONFIG_NET_SOCKETS_CAN */
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+	/** Traffic statistics of this context */
+	struct net_stats_context stats;
+#endif /* CONFIG_NET_CONTEXT_STATS */
+
 	/** Option values */
 	struct {
 #if defined(CONFIG_NET_CONTEXT_PRIORITY)
@@ -1060,6 +1065,7 @@ enum net_context_option {
 	NET_OPT_SOCKS5		= 3,
 	NET_OPT_RCVTIMEO        = 4,
 	NET_OPT_SNDTIMEO        = 5,
+	NET_OPT_STATS           = 6,
 };
 
 /**
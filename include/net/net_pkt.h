@@ -116,6 +116,11 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+	/** Time in cycles when the packet was queued for or by a context */
+	uint32_t queue_time;
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME)
 	/** Network packet TX time in the future (in nanoseconds) */
 	uint64_t txtime;
@@ -833,6 +838,33 @@ static inline void net_pkt_set_create_time(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+static inline uint32_t net_pkt_queue_time(struct net_pkt *pkt)
+{
+	return pkt->queue_time;
+}
+
+static inline void net_pkt_set_queue_time(struct net_pkt *pkt,
+					  uint32_t queue_time)
+{
+	pkt->queue_time = queue_time;
+}
+#else
+static inline uint32_t net_pkt_queue_time(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_queue_time(struct net_pkt *pkt,
+					  uint32_t queue_time)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(queue_time);
+}
+#endif /* CONFIG_NET_CONTEXT_STATS */
+
 #if defined(CONFIG_NET_PKT_TXTIME)
 static inline uint64_t net_pkt_txtime(struct net_pkt *pkt)
 {
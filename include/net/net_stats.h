@@ -285,6 +285,32 @@ struct net_stats_pm {
 	uint32_t start_time;
 };
 
+/**
+ * @brief Per network context (socket) statistics
+ */
+struct net_stats_context {
+	/** Number of payload bytes sent and received */
+	struct net_stats_bytes bytes;
+
+	/** Number of packets (or TCP segments) sent and received */
+	struct net_stats_pkts pkts;
+
+	/** Number of packets dropped */
+	net_stats_t drop;
+
+	/** Number of TCP segments that had to be retransmitted */
+	net_stats_t retransmit;
+
+	/** Smoothed TCP round trip time in milliseconds */
+	uint32_t rtt;
+
+	/** Time received data spent in the socket queue before recv() */
+	struct net_stats_rx_time rx_queue_time;
+
+	/** Time sent data spent queued before it was given to the driver */
+	struct net_stats_tx_time tx_queue_time;
+};
+
 
 /**
  * @brief All network statistics in one struct.
@@ -870,6 +870,9 @@ struct ifreq {
 /** sockopt: Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
+/** sockopt: Get socket traffic statistics (struct net_stats_context) */
+#define SO_NET_STATS 62
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
@@ -333,6 +333,47 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Start a settings transaction.
+ *
+ * Until the transaction is committed with @ref settings_txn_commit or
+ * aborted with @ref settings_txn_abort, the values saved by the calling
+ * thread with @ref settings_save_one, @ref settings_delete or
+ * @ref settings_save are staged in RAM instead of being written to the
+ * storage back-end. Saving the same key several times only keeps the last
+ * value. Other threads saving or loading settings are blocked until the
+ * transaction ends, so it must be kept short.
+ *
+ * If CONFIG_SETTINGS_TXN_ATOMIC is not enabled and the staging buffer gets
+ * full, the staged values are written to the back-end and the transaction
+ * continues.
+ *
+ * @return 0 on success, -EBUSY if the calling thread already has a
+ * transaction in progress, -ENOENT if there is no storage back-end.
+ */
+int settings_txn_begin(void);
+
+/**
+ * Commit a settings transaction.
+ *
+ * Writes all the staged values to the storage back-end. With
+ * CONFIG_SETTINGS_TXN_ATOMIC either all or none of them are visible after
+ * a power loss during the commit.
+ *
+ * @return 0 on success, -EINVAL if there is no transaction in progress,
+ * -ENOMEM if the staging buffer got full (atomic transactions only, nothing
+ * is written), other negative error code if writing to the back-end failed.
+ */
+int settings_txn_commit(void);
+
+/**
+ * Abort a settings transaction.
+ *
+ * Discards the staged values which have not been written to the storage
+ * back-end.
+ */
+void settings_txn_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
@@ -79,6 +79,40 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 		      uint32_t start_sector, uint32_t num_sector);
 
+/**
+ * @brief Read data from disk into several buffers
+ *
+ * Function reads consecutive sectors into the buffers of @p iov, in order.
+ * Disks supporting it transfer the sectors with a single multi-block
+ * command, the other ones are read one buffer at a time.
+ *
+ * @param[in] pdrv          Disk name
+ * @param[in] iov           Buffers and their number of sectors
+ * @param[in] iovcnt        Number of buffers
+ * @param[in] start_sector  Start disk sector to read from
+ *
+ * @return 0 on success, negative errno code on fail
+ */
+int disk_access_readv(const char *pdrv, const struct disk_iovec *iov,
+		      size_t iovcnt, uint32_t start_sector);
+
+/**
+ * @brief Write data to disk from several buffers
+ *
+ * Function writes consecutive sectors from the buffers of @p iov, in order.
+ * Disks supporting it transfer the sectors with a single multi-block
+ * command, the other ones are written one buffer at a time.
+ *
+ * @param[in] pdrv          Disk name
+ * @param[in] iov           Buffers and their number of sectors
+ * @param[in] iovcnt        Number of buffers
+ * @param[in] start_sector  Start disk sector to write to
+ *
+ * @return 0 on success, negative errno code on fail
+ */
+int disk_access_writev(const char *pdrv, const struct disk_iovec *iov,
+		       size_t iovcnt, uint32_t start_sector);
+
 /**
  * @brief Get/Configure disk parameters
  *
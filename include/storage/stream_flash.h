@@ -22,6 +22,9 @@
 
 #include <stdbool.h>
 #include <drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +47,24 @@ extern "C" {
  */
 typedef int (*stream_flash_callback_t)(uint8_t *buf, size_t len, size_t offset);
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+/**
+ * @brief Write buffer of a pipelined stream flash context
+ *
+ * Internal to the stream flash implementation.
+ */
+struct stream_flash_pipe_buf {
+	uint8_t *buf; /* Buffer memory */
+	size_t len; /* Number of payload bytes being written */
+	size_t offset; /* Offset the payload is written to */
+	struct flash_async_req write_req; /* Write of the buffer */
+	struct flash_async_req erase_req[2]; /* Erases ahead of the write */
+	int result; /* Result of the write */
+	bool busy; /* Write submitted and not retired yet */
+	volatile bool done; /* Write completed */
+};
+#endif
+
 /**
  * @brief Structure for stream flash context
  *
@@ -62,6 +83,15 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	/* Write buffers, used in turn */
+	struct stream_flash_pipe_buf pipe[CONFIG_STREAM_FLASH_PIPELINE_BUFFERS];
+	uint8_t pipe_cnt; /* Number of buffers, 0 if not pipelined */
+	uint8_t pipe_idx; /* Index of the buffer being filled */
+	size_t bytes_submitted; /* Number of bytes submitted for writing */
+	struct k_sem pipe_sem; /* Given on write completions */
+	int pipe_err; /* First error of the pipeline */
+#endif
 };
 
 /**
@@ -83,6 +113,46 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+/**
+ * @brief Initialize context needed for pipelined stream writes to flash.
+ *
+ * The write buffer is split into @p buf_cnt buffers of @p buf_len bytes.
+ * Once a buffer is full, it is erased and written in the background with
+ * the asynchronous flash API while the next buffer is filled, the page
+ * following the written one is erased ahead of time.
+ * @ref stream_flash_buffered_write only blocks when the next buffer is still
+ * being written.
+ *
+ * The number of bytes written, and thus the progress stored by
+ * @ref stream_flash_progress_save, only accounts for the buffers whose write
+ * has completed and, if any, whose callback succeeded. A flush write waits
+ * for all the buffers to be written. After an error, the context must be
+ * initialized again.
+ *
+ * @param ctx context to be initialized
+ * @param fdev Flash device to operate on
+ * @param buf Write buffers, @p buf_cnt times @p buf_len bytes
+ * @param buf_len Length of each write buffer. Can not be larger than the page
+ *                size. Must be multiple of the flash device
+ *                write-block-size.
+ * @param buf_cnt Number of write buffers, from 2 to
+ *                CONFIG_STREAM_FLASH_PIPELINE_BUFFERS.
+ * @param offset Offset within flash device to start writing to
+ * @param size Number of bytes available for performing buffered write.
+ *             If this is '0', the size will be set to the total size
+ *             of the flash device minus the offset.
+ * @param cb Callback to be invoked on completed flash write operations.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_init_pipelined(struct stream_flash_ctx *ctx,
+				const struct device *fdev, uint8_t *buf,
+				size_t buf_len, size_t buf_cnt, size_t offset,
+				size_t size, stream_flash_callback_t cb);
+#endif
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -119,7 +189,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
  *
  * This function erases a flash page to which an offset belongs if this page
  * is not the page previously erased by the provided ctx
- * (ctx->last_erased_page_start_offset).
+ * (ctx->last_erased_page_start_offset). With a pipelined context, the
+ * pending writes are completed first.
  *
  * @param ctx context
  * @param off offset from the base address of the flash device
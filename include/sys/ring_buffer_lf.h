@@ -0,0 +1,253 @@
+/* ring_buffer_lf.h: Lock-free ring buffer API */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RING_BUFFER_LF_H_
+#define ZEPHYR_INCLUDE_SYS_RING_BUFFER_LF_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+#include <sys/ring_buffer.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lock-free ring buffer APIs
+ * @defgroup ring_buffer_lf_apis Lock-free Ring Buffer APIs
+ * @ingroup datastructure_apis
+ *
+ * Byte ring buffer which can be used without external locking by one
+ * consumer and either one producer (SPSC) or many producers (MPSC). The
+ * producer and consumer indexes are free running 32-bit counters updated
+ * with atomic operations, therefore the buffer size must be a power of 2.
+ *
+ * The consumer side (@ref ring_buf_lf_get_claim, @ref ring_buf_lf_get_finish
+ * and @ref ring_buf_lf_get) and the single producer side
+ * (@ref ring_buf_lf_put_claim, @ref ring_buf_lf_put_finish and
+ * @ref ring_buf_lf_put) follow the semantics of the corresponding
+ * @ref ring_buffer_apis byte mode functions. Multiple producers, including
+ * interrupt handlers, must use @ref ring_buf_lf_mp_put instead. Single and
+ * multi producer functions must not be mixed on the same buffer.
+ *
+ * @{
+ */
+
+/**
+ * @brief A structure to represent a lock-free ring buffer
+ */
+struct ring_buf_lf {
+	atomic_t head;      /**< Consumer index, data before it is free */
+	atomic_t tail;      /**< Producer index, data before it is valid */
+	atomic_t prod_head; /**< Multi producer reservation index */
+	atomic_t prod_busy; /**< Number of multi producers writing data */
+	uint32_t tmp_head;  /**< Consumer claim index */
+	uint32_t tmp_tail;  /**< Single producer claim index */
+	uint32_t size;      /**< Size of buf in bytes, a power of 2 */
+	uint32_t mask;      /**< Modulo mask */
+	uint8_t *buf;       /**< Memory region for stored data */
+};
+
+/**
+ * @brief Statically define and initialize a lock-free ring buffer.
+ *
+ * The ring buffer contains 2^pow bytes.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_lf <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param pow Ring buffer size exponent.
+ */
+#define RING_BUF_LF_DECLARE_POW2(name, pow) \
+	BUILD_ASSERT(BIT(pow) <= RING_BUFFER_MAX_SIZE, \
+		RING_BUFFER_SIZE_ASSERT_MSG); \
+	static uint8_t _ring_buffer_lf_data_##name[BIT(pow)]; \
+	struct ring_buf_lf name = { \
+		.size = BIT(pow), \
+		.mask = BIT(pow) - 1, \
+		.buf = _ring_buffer_lf_data_##name \
+	}
+
+/**
+ * @brief Initialize a lock-free ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_LF_DECLARE_POW2.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size in bytes, must be a power of 2.
+ * @param data Ring buffer data area (uint8_t data[size]).
+ */
+static inline void ring_buf_lf_init(struct ring_buf_lf *buf, uint32_t size,
+				    uint8_t *data)
+{
+	__ASSERT(size <= RING_BUFFER_MAX_SIZE, RING_BUFFER_SIZE_ASSERT_MSG);
+	__ASSERT(is_power_of_two(size), "Size must be a power of 2");
+
+	memset(buf, 0, sizeof(struct ring_buf_lf));
+	buf->size = size;
+	buf->mask = size - 1U;
+	buf->buf = data;
+}
+
+/**
+ * @brief Determine if a lock-free ring buffer is empty.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+static inline bool ring_buf_lf_is_empty(struct ring_buf_lf *buf)
+{
+	return (uint32_t)atomic_get(&buf->head) ==
+	       (uint32_t)atomic_get(&buf->tail);
+}
+
+/**
+ * @brief Determine free space in a lock-free ring buffer.
+ *
+ * The returned value is a snapshot, it may change immediately if other
+ * contexts are using the buffer.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space in bytes.
+ */
+static inline uint32_t ring_buf_lf_space_get(struct ring_buf_lf *buf)
+{
+	return buf->size - ((uint32_t)atomic_get(&buf->tail) -
+			    (uint32_t)atomic_get(&buf->head));
+}
+
+/**
+ * @brief Return ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity in bytes.
+ */
+static inline uint32_t ring_buf_lf_capacity_get(struct ring_buf_lf *buf)
+{
+	return buf->size;
+}
+
+/**
+ * @brief Allocate buffer for writing data to a ring buffer (single producer).
+ *
+ * Works like @ref ring_buf_put_claim. The returned region is contiguous,
+ * so less than @a size bytes may be claimed when the buffer wraps. Claimed
+ * data becomes visible to the consumer with @ref ring_buf_lf_put_finish.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+uint32_t ring_buf_lf_put_claim(struct ring_buf_lf *buf, uint8_t **data,
+			       uint32_t size);
+
+/**
+ * @brief Indicate number of bytes written to allocated buffers
+ *	  (single producer).
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of valid bytes in the allocated buffers.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed size.
+ */
+int ring_buf_lf_put_finish(struct ring_buf_lf *buf, uint32_t size);
+
+/**
+ * @brief Write (copy) data to a ring buffer (single producer).
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t ring_buf_lf_put(struct ring_buf_lf *buf, const uint8_t *data,
+			 uint32_t size);
+
+/**
+ * @brief Write (copy) data to a ring buffer (multiple producers).
+ *
+ * Space is reserved with an atomic compare-and-swap, so this function can
+ * be called concurrently from any number of threads, interrupts and CPUs
+ * without locking. Data written by a producer becomes visible to the
+ * consumer once every producer that reserved space before it has finished
+ * copying, no producer ever waits for another one.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t ring_buf_lf_mp_put(struct ring_buf_lf *buf, const uint8_t *data,
+			    uint32_t size);
+
+/**
+ * @brief Get address of a valid data in a ring buffer.
+ *
+ * Works like @ref ring_buf_get_claim. Only one consumer may use the buffer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough free space or buffer wraps.
+ */
+uint32_t ring_buf_lf_get_claim(struct ring_buf_lf *buf, uint8_t **data,
+			       uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer.
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed size.
+ */
+int ring_buf_lf_get_finish(struct ring_buf_lf *buf, uint32_t size);
+
+/**
+ * @brief Read data from a ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+uint32_t ring_buf_lf_get(struct ring_buf_lf *buf, uint8_t *data,
+			 uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RING_BUFFER_LF_H_ */
@@ -8,8 +8,150 @@
 
 #include <string.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <sys/types.h>
 
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+#define WORD_MASK (sizeof(mem_word_t) - 1)
+#define WORD_BITS (sizeof(mem_word_t) * 8U)
+
+/* 0x01 and 0x80 repeated in every byte of a word */
+#define WORD_ONES ((mem_word_t)-1 / 0xff)
+#define WORD_HIGHS (WORD_ONES << 7)
+
+/* Non-zero if any byte of the word is zero */
+static inline mem_word_t word_has_zero(mem_word_t w)
+{
+	return (w - WORD_ONES) & ~w & WORD_HIGHS;
+}
+
+static inline mem_word_t word_repeat(unsigned char c)
+{
+	return WORD_ONES * c;
+}
+
+static inline bool word_aligned(const void *p)
+{
+	return ((uintptr_t)p & WORD_MASK) == 0;
+}
+
+/* Word starting <shift> bits into <lo>, followed by the start of <hi> */
+static inline mem_word_t word_merge(mem_word_t lo, mem_word_t hi,
+				    unsigned int shift)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return (lo << shift) | (hi >> (WORD_BITS - shift));
+#else
+	return (lo >> shift) | (hi << (WORD_BITS - shift));
+#endif
+}
+
+/*
+ * Copy forward a word at a time, also when the source and the destination
+ * are not equally aligned: aligned source words are then shifted and merged.
+ * Aligned words are never read past the word holding the last source byte.
+ * Overlapping areas are supported when <d_byte> is below <s_byte>.
+ */
+static void copy_forward(unsigned char *d_byte, const unsigned char *s_byte,
+			 size_t n)
+{
+	while (!word_aligned(d_byte) && (n > 0)) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	if (n >= sizeof(mem_word_t)) {
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		uintptr_t offset = (uintptr_t)s_byte & WORD_MASK;
+
+		if (offset == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+			do {
+				*(d_word++) = *(s_word++);
+				n -= sizeof(mem_word_t);
+			} while (n >= sizeof(mem_word_t));
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			const mem_word_t *s_word =
+				(const mem_word_t *)(s_byte - offset);
+			unsigned int shift = offset * 8U;
+			mem_word_t lo = *(s_word++);
+			mem_word_t hi;
+
+			do {
+				hi = *(s_word++);
+				*(d_word++) = word_merge(lo, hi, shift);
+				lo = hi;
+				s_byte += sizeof(mem_word_t);
+				n -= sizeof(mem_word_t);
+			} while (n >= sizeof(mem_word_t));
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+}
+
+/*
+ * Same as copy_forward(), from the end of the areas. Overlapping areas are
+ * supported when <d_byte> is above <s_byte>.
+ */
+static void copy_backward(unsigned char *d_byte, const unsigned char *s_byte,
+			  size_t n)
+{
+	d_byte += n;
+	s_byte += n;
+
+	while (!word_aligned(d_byte) && (n > 0)) {
+		*(--d_byte) = *(--s_byte);
+		n--;
+	}
+
+	if (n >= sizeof(mem_word_t)) {
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		uintptr_t offset = (uintptr_t)s_byte & WORD_MASK;
+
+		if (offset == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+			do {
+				*(--d_word) = *(--s_word);
+				n -= sizeof(mem_word_t);
+			} while (n >= sizeof(mem_word_t));
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			const mem_word_t *s_word =
+				(const mem_word_t *)(s_byte - offset);
+			unsigned int shift = offset * 8U;
+			mem_word_t hi = *s_word;
+			mem_word_t lo;
+
+			do {
+				lo = *(--s_word);
+				*(--d_word) = word_merge(lo, hi, shift);
+				hi = lo;
+				s_byte -= sizeof(mem_word_t);
+				n -= sizeof(mem_word_t);
+			} while (n >= sizeof(mem_word_t));
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	while (n > 0) {
+		*(--d_byte) = *(--s_byte);
+		n--;
+	}
+}
+#endif /* CONFIG_MINIMAL_LIBC_WORD_ACCESS */
+
 /**
  *
  * @brief Copy a string
@@ -66,16 +208,35 @@ char *strncpy(char *_MLIBC_RESTRICT d, const char *_MLIBC_RESTRICT s, size_t n)
  * @return pointer to 1st instance of found byte, or NULL if not found
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRCHR)
 char *strchr(const char *s, int c)
 {
 	char tmp = (char) c;
 
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	while (!word_aligned(s) && (*s != tmp) && (*s != '\0')) {
+		s++;
+	}
+
+	if (word_aligned(s)) {
+		const mem_word_t *w = (const mem_word_t *)s;
+		mem_word_t c_word = word_repeat(tmp);
+
+		while (!word_has_zero(*w) && !word_has_zero(*w ^ c_word)) {
+			w++;
+		}
+
+		s = (const char *)w;
+	}
+#endif
+
 	while ((*s != tmp) && (*s != '\0')) {
 		s++;
 	}
 
 	return (*s == tmp) ? (char *) s : NULL;
 }
+#endif
 
 /**
  *
@@ -104,17 +265,34 @@ char *strrchr(const char *s, int c)
  * @return number of bytes in string <s>
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRLEN)
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *start = s;
+
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	while (!word_aligned(s) && (*s != '\0')) {
+		s++;
+	}
+
+	if (word_aligned(s)) {
+		const mem_word_t *w = (const mem_word_t *)s;
+
+		while (!word_has_zero(*w)) {
+			w++;
+		}
+
+		s = (const char *)w;
+	}
+#endif
 
 	while (*s != '\0') {
 		s++;
-		n++;
 	}
 
-	return n;
+	return s - start;
 }
+#endif
 
 /**
  *
@@ -142,8 +320,32 @@ size_t strnlen(const char *s, size_t maxlen)
  * @return negative # if <s1> < <s2>, 0 if <s1> == <s2>, else positive #
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRCMP)
 int strcmp(const char *s1, const char *s2)
 {
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	/* Compare words only if strings have identical alignment */
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & WORD_MASK) == 0) {
+		while (!word_aligned(s1) && (*s1 == *s2) && (*s1 != '\0')) {
+			s1++;
+			s2++;
+		}
+
+		if (word_aligned(s1)) {
+			const mem_word_t *w1 = (const mem_word_t *)s1;
+			const mem_word_t *w2 = (const mem_word_t *)s2;
+
+			while ((*w1 == *w2) && !word_has_zero(*w1)) {
+				w1++;
+				w2++;
+			}
+
+			s1 = (const char *)w1;
+			s2 = (const char *)w2;
+		}
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -151,6 +353,7 @@ int strcmp(const char *s1, const char *s2)
 
 	return *s1 - *s2;
 }
+#endif
 
 /**
  *
@@ -236,11 +439,37 @@ char *strncat(char *_MLIBC_RESTRICT dest, const char *_MLIBC_RESTRICT src,
  *
  * @return negative # if <m1> < <m2>, 0 if <m1> == <m2>, else positive #
  */
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_MEMCMP)
 int memcmp(const void *m1, const void *m2, size_t n)
 {
 	const char *c1 = m1;
 	const char *c2 = m2;
 
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	/* Compare words only if areas have identical alignment */
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & WORD_MASK) == 0) {
+		while (!word_aligned(c1) && (n > 0) && (*c1 == *c2)) {
+			c1++;
+			c2++;
+			n--;
+		}
+
+		if (word_aligned(c1)) {
+			const mem_word_t *w1 = (const mem_word_t *)c1;
+			const mem_word_t *w2 = (const mem_word_t *)c2;
+
+			while ((n >= sizeof(mem_word_t)) && (*w1 == *w2)) {
+				w1++;
+				w2++;
+				n -= sizeof(mem_word_t);
+			}
+
+			c1 = (const char *)w1;
+			c2 = (const char *)w2;
+		}
+	}
+#endif
+
 	if (!n) {
 		return 0;
 	}
@@ -252,6 +481,7 @@ int memcmp(const void *m1, const void *m2, size_t n)
 
 	return *c1 - *c2;
 }
+#endif
 
 /**
  *
@@ -260,6 +490,7 @@ int memcmp(const void *m1, const void *m2, size_t n)
  * @return pointer to destination buffer <d>
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_MEMMOVE)
 void *memmove(void *d, const void *s, size_t n)
 {
 	char *dest = d;
@@ -271,22 +502,31 @@ void *memmove(void *d, const void *s, size_t n)
 		 * Copy backwards to prevent the premature corruption of <src>.
 		 */
 
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+		copy_backward(d, s, n);
+#else
 		while (n > 0) {
 			n--;
 			dest[n] = src[n];
 		}
+#endif
 	} else {
 		/* It is safe to perform a forward-copy */
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+		copy_forward(d, s, n);
+#else
 		while (n > 0) {
 			*dest = *src;
 			dest++;
 			src++;
 			n--;
 		}
+#endif
 	}
 
 	return d;
 }
+#endif
 
 /**
  *
@@ -295,8 +535,14 @@ void *memmove(void *d, const void *s, size_t n)
  * @return pointer to start of destination buffer
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_MEMCPY)
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	copy_forward(d, s, n);
+
+	return d;
+#else
 	/* attempt word-sized copying only if buffers have identical alignment */
 
 	unsigned char *d_byte = (unsigned char *)d;
@@ -337,7 +583,9 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 	}
 
 	return d;
+#endif
 }
+#endif
 
 /**
  *
@@ -396,8 +644,33 @@ void *memset(void *buf, int c, size_t n)
  * @return pointer to start of found byte
  */
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_MEMCHR)
 void *memchr(const void *s, int c, size_t n)
 {
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+	const unsigned char *b = s;
+
+	while (!word_aligned(b) && (n > 0) && (*b != (unsigned char)c)) {
+		b++;
+		n--;
+	}
+
+	if (word_aligned(b)) {
+		const mem_word_t *w = (const mem_word_t *)b;
+		mem_word_t c_word = word_repeat(c);
+
+		while ((n >= sizeof(mem_word_t)) &&
+		       !word_has_zero(*w ^ c_word)) {
+			w++;
+			n -= sizeof(mem_word_t);
+		}
+
+		s = w;
+	} else {
+		s = b;
+	}
+#endif
+
 	if (n != 0) {
 		const unsigned char *p = s;
 
@@ -411,3 +684,4 @@ void *memchr(const void *s, int c, size_t n)
 
 	return NULL;
 }
+#endif
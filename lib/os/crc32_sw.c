@@ -5,6 +5,11 @@
  */
 
 #include <sys/crc.h>
+#include "crc_slice.h"
+
+#if defined(CONFIG_CRC_HW) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
@@ -13,6 +18,21 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if defined(CONFIG_CRC_HW) && defined(__ARM_FEATURE_CRC32)
+	crc = ~crc;
+
+	for (; len >= 4; data += 4, len -= 4) {
+		crc = __crc32w(crc, sys_get_le32(data));
+	}
+
+	for (; len; len--) {
+		crc = __crc32b(crc, *data++);
+	}
+
+	return (~crc);
+#elif defined(CRC_SLICE_TABLES)
+	return ~crc32_slice_update(crc32_ieee_slice_table, ~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
@@ -31,4 +51,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
@@ -5,7 +5,21 @@
  */
 
 #include <sys/crc.h>
+#include "crc_slice.h"
 
+#if defined(CONFIG_CRC_HW) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+
+#define crc32c_word(crc, word) __crc32cw(crc, word)
+#define crc32c_byte(crc, byte) __crc32cb(crc, byte)
+#define CRC32C_HW 1
+#elif defined(CONFIG_CRC_HW) && defined(__SSE4_2__)
+#define crc32c_word(crc, word) __builtin_ia32_crc32si(crc, word)
+#define crc32c_byte(crc, byte) __builtin_ia32_crc32qi(crc, byte)
+#define CRC32C_HW 1
+#endif
+
+#if !defined(CRC_SLICE_TABLES)
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
@@ -13,6 +27,7 @@ static const uint32_t crc32c_table[16] = {
 	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -31,10 +46,22 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
+#if defined(CRC32C_HW)
+	for (; len >= 4; data += 4, len -= 4) {
+		crc = crc32c_word(crc, sys_get_le32(data));
+	}
+
+	for (; len; len--) {
+		crc = crc32c_byte(crc, *data++);
+	}
+#elif defined(CRC_SLICE_TABLES)
+	crc = crc32_slice_update(crc32c_slice_table, crc, data, len);
+#else
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
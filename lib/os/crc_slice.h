@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_CRC_SLICE_H_
+#define ZEPHYR_LIB_OS_CRC_SLICE_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <sys/byteorder.h>
+
+#if defined(CONFIG_CRC_SLICE_BY_4) || defined(CONFIG_CRC_SLICE_BY_8) || \
+	defined(CONFIG_CRC_HW)
+#define CRC_SLICE_TABLES 1
+#endif
+
+#if defined(CONFIG_CRC_SLICE_BY_4)
+#define CRC_SLICES 4
+#else
+#define CRC_SLICES 8
+#endif
+
+/* Entry i of table k is the reflected CRC of byte i followed by k zero
+ * bytes, so that CRC_SLICES bytes are processed with one lookup per byte.
+ */
+extern const uint32_t crc32_ieee_slice_table[CRC_SLICES][256];
+extern const uint32_t crc32c_slice_table[CRC_SLICES][256];
+
+extern const uint8_t crc8_ccitt_table[256];
+
+/* Update a reflected CRC32, without initial or final inversion */
+static inline uint32_t crc32_slice_update(const uint32_t table[][256],
+					  uint32_t crc, const uint8_t *data,
+					  size_t len)
+{
+	for (; len >= CRC_SLICES; data += CRC_SLICES, len -= CRC_SLICES) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+#if CRC_SLICES == 8
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+#else
+		crc = table[3][lo & 0xff] ^ table[2][(lo >> 8) & 0xff] ^
+		      table[1][(lo >> 16) & 0xff] ^ table[0][lo >> 24];
+#endif
+	}
+
+	for (; len; len--) {
+		crc = table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+#endif /* ZEPHYR_LIB_OS_CRC_SLICE_H_ */
@@ -0,0 +1,220 @@
+/* ring_buffer_lf.c: Lock-free ring buffer API */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/ring_buffer_lf.h>
+#include <string.h>
+
+/*
+ * All indexes are free running 32-bit counters which are reduced with the
+ * mask only when the buffer memory is accessed. Since the size is a power of
+ * 2 not bigger than 2^31, unsigned wrapping of the counters does not need
+ * any special handling (unlike struct ring_buf which rewinds its indexes).
+ *
+ * Shared indexes are accessed with atomic operations which act as full
+ * memory barriers, so data written before an index update is visible to the
+ * other side once it observes the new index value.
+ */
+
+static inline uint32_t idx_get(const atomic_t *idx)
+{
+	return (uint32_t)atomic_get(idx);
+}
+
+static inline void idx_set(atomic_t *idx, uint32_t val)
+{
+	(void)atomic_set(idx, (atomic_val_t)val);
+}
+
+/* Return true if index @a a is ahead of index @a b. */
+static inline bool idx_after(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) > 0;
+}
+
+/* Copy data into the ring buffer, starting at index @a idx, with wrapping. */
+static void copy_in(struct ring_buf_lf *buf, uint32_t idx,
+		    const uint8_t *data, uint32_t size)
+{
+	uint32_t offset = idx & buf->mask;
+	uint32_t first = MIN(size, buf->size - offset);
+
+	memcpy(&buf->buf[offset], data, first);
+	memcpy(buf->buf, data + first, size - first);
+}
+
+uint32_t ring_buf_lf_put_claim(struct ring_buf_lf *buf, uint8_t **data,
+			       uint32_t size)
+{
+	uint32_t space, trail_size, offset;
+
+	offset = buf->tmp_tail & buf->mask;
+	space = buf->size - (buf->tmp_tail - idx_get(&buf->head));
+	trail_size = buf->size - offset;
+
+	size = MIN(size, space);
+	size = MIN(size, trail_size);
+
+	*data = &buf->buf[offset];
+	buf->tmp_tail += size;
+
+	return size;
+}
+
+int ring_buf_lf_put_finish(struct ring_buf_lf *buf, uint32_t size)
+{
+	uint32_t tail = idx_get(&buf->tail);
+
+	if (size > (buf->tmp_tail - tail)) {
+		return -EINVAL;
+	}
+
+	tail += size;
+	buf->tmp_tail = tail;
+	idx_set(&buf->tail, tail);
+
+	return 0;
+}
+
+uint32_t ring_buf_lf_put(struct ring_buf_lf *buf, const uint8_t *data,
+			 uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_lf_put_claim(buf, &dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_lf_put_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
+
+/* Advance the published tail to @a new_tail unless some other producer has
+ * already published a later index.
+ */
+static void tail_publish(struct ring_buf_lf *buf, uint32_t new_tail)
+{
+	uint32_t tail;
+
+	do {
+		tail = idx_get(&buf->tail);
+		if (!idx_after(new_tail, tail)) {
+			return;
+		}
+	} while (!atomic_cas(&buf->tail, (atomic_val_t)tail,
+			     (atomic_val_t)new_tail));
+}
+
+uint32_t ring_buf_lf_mp_put(struct ring_buf_lf *buf, const uint8_t *data,
+			    uint32_t size)
+{
+	uint32_t start, space, reserved;
+	uint32_t allocated = 0U;
+
+	/* A producer which cannot write anything must not announce itself,
+	 * otherwise producers spinning on a full buffer could prevent the
+	 * data from ever being published.
+	 */
+	space = buf->size - (idx_get(&buf->prod_head) - idx_get(&buf->head));
+	if (space && size) {
+		/* Announce the producer before reserving, so that nobody
+		 * publishes the reserved space before the data is copied.
+		 */
+		(void)atomic_inc(&buf->prod_busy);
+
+		do {
+			start = idx_get(&buf->prod_head);
+			space = buf->size - (start - idx_get(&buf->head));
+			allocated = MIN(size, space);
+		} while (allocated &&
+			 !atomic_cas(&buf->prod_head, (atomic_val_t)start,
+				     (atomic_val_t)(start + allocated)));
+
+		if (allocated) {
+			copy_in(buf, start, data, allocated);
+		}
+
+		(void)atomic_dec(&buf->prod_busy);
+	}
+
+	/* If no producer is busy after the reservation index was read, then
+	 * all the space reserved up to that index has been written. If some
+	 * producer is still busy, it will do the publishing when it is done.
+	 */
+	reserved = idx_get(&buf->prod_head);
+	if (atomic_get(&buf->prod_busy) == 0) {
+		tail_publish(buf, reserved);
+	}
+
+	return allocated;
+}
+
+uint32_t ring_buf_lf_get_claim(struct ring_buf_lf *buf, uint8_t **data,
+			       uint32_t size)
+{
+	uint32_t space, trail_size, offset;
+
+	offset = buf->tmp_head & buf->mask;
+	space = idx_get(&buf->tail) - buf->tmp_head;
+	trail_size = buf->size - offset;
+
+	size = MIN(size, space);
+	size = MIN(size, trail_size);
+
+	*data = &buf->buf[offset];
+	buf->tmp_head += size;
+
+	return size;
+}
+
+int ring_buf_lf_get_finish(struct ring_buf_lf *buf, uint32_t size)
+{
+	uint32_t head = idx_get(&buf->head);
+
+	if (size > (buf->tmp_head - head)) {
+		return -EINVAL;
+	}
+
+	head += size;
+	buf->tmp_head = head;
+	idx_set(&buf->head, head);
+
+	return 0;
+}
+
+uint32_t ring_buf_lf_get(struct ring_buf_lf *buf, uint8_t *data,
+			 uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_lf_get_claim(buf, &src, size);
+		if (data) {
+			memcpy(data, src, partial_size);
+			data += partial_size;
+		}
+		total_size += partial_size;
+		size -= partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_lf_get_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+
+	return total_size;
+}
@@ -41,3 +41,69 @@ def extract_string_from_section(section, str_ptr):
         offset += 1
 
     return ret_str
+
+
+# Need to keep sync with struct log_dict_output_frame_hdr_t in
+# include/logging/log_output_dict.h
+FRAME_SYNC = b'\xa5\x5a'
+FRAME_HDR_SIZE = 4
+FRAME_CRC_SIZE = 2
+
+
+def crc16_ccitt(seed, data):
+    """Same as crc16_ccitt() in lib/os/crc16_sw.c"""
+    for byte in data:
+        e = (seed ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        seed = ((seed >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+
+    return seed
+
+
+def extract_frames(data, little_endian=True):
+    """
+    Extract log records from framed log data
+    (CONFIG_LOG_DICTIONARY_FRAMING).
+
+    Returns a tuple of the list of valid records, the trailing bytes
+    which do not form a complete frame yet, and the number of corrupted
+    frames or garbage bytes skipped while resynchronizing.
+    """
+    endian = "little" if little_endian else "big"
+    records = []
+    errors = 0
+    offset = 0
+
+    while True:
+        idx = data.find(FRAME_SYNC, offset)
+        if idx < 0:
+            # Keep a possible partial sync pattern at the end
+            keep = len(data) - 1 if data[-1:] == FRAME_SYNC[:1] else len(data)
+            if keep > offset:
+                errors += 1
+            return records, data[keep:], errors
+
+        if idx > offset:
+            errors += 1
+
+        offset = idx
+        if len(data) - offset < FRAME_HDR_SIZE:
+            break
+
+        length = int.from_bytes(data[offset + 2:offset + 4], endian)
+        end = offset + FRAME_HDR_SIZE + length + FRAME_CRC_SIZE
+        if len(data) < end:
+            break
+
+        record = data[offset + FRAME_HDR_SIZE:end - FRAME_CRC_SIZE]
+        crc = int.from_bytes(data[end - FRAME_CRC_SIZE:end], endian)
+
+        if crc16_ccitt(0xFFFF, record) == crc:
+            records.append(record)
+            offset = end
+        else:
+            # Not a valid frame, look for the next sync pattern
+            errors += 1
+            offset += 1
+
+    return records, data[offset:], errors
@@ -14,6 +14,7 @@ log data and print the log messages.
 import argparse
 import binascii
 import logging
+import socket
 import sys
 
 import dictionary_parser
@@ -31,15 +32,65 @@ def parse_args():
     argparser = argparse.ArgumentParser()
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="?", help="Log Data file")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--framed", action="store_true",
+                           help="Log data is framed (CONFIG_LOG_DICTIONARY_FRAMING)")
+    argparser.add_argument("--udp", metavar="[ADDR:]PORT",
+                           help="Receive log data from the network backend "
+                                "on the given UDP port instead of a file")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
-    return argparser.parse_args()
+    args = argparser.parse_args()
+
+    if args.logfile is None and args.udp is None:
+        argparser.error("either logfile or --udp is required")
+
+    return args
+
+
+def parse_framed_log_data(log_parser, logdata, little_endian, debug):
+    """Parse all complete frames, return the trailing partial frame"""
+    records, remaining, errors = \
+        dictionary_parser.utils.extract_frames(logdata, little_endian)
+
+    if errors:
+        logger.warning("--- %d corrupted frame(s) skipped ---", errors)
+
+    for record in records:
+        if not log_parser.parse_log_data(record, debug=debug):
+            logger.error("ERROR: cannot parse log record")
+
+    return remaining
+
+
+def receive_udp(args, log_parser, database):
+    """Parse log data received from the network backend until interrupted"""
+    addr, _, port = args.udp.rpartition(":")
+    family = socket.AF_INET6 if ":" in addr else socket.AF_INET
+    sock = socket.socket(family, socket.SOCK_DGRAM)
+    sock.bind((addr.strip("[]"), int(port)))
+
+    pending = b''
+
+    try:
+        while True:
+            data, _ = sock.recvfrom(65536)
+
+            if args.framed:
+                pending = parse_framed_log_data(log_parser, pending + data,
+                                                database.is_tgt_little_endian(),
+                                                args.debug)
+            elif not log_parser.parse_log_data(data, debug=args.debug):
+                logger.error("ERROR: cannot parse log data")
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
 
 
 def main():
@@ -59,6 +110,15 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    if args.udp:
+        receive_udp(args, log_parser, database)
+        return
+
     # Open log data file for reading
     if args.hex:
         if args.rawhex:
@@ -109,22 +169,25 @@ def main():
 
         logfile.close()
 
-    log_parser = dictionary_parser.get_parser(database)
-    if log_parser is not None:
-        logger.debug("# Build ID: %s", database.get_build_id())
-        logger.debug("# Target: %s, %d-bit", database.get_arch(), database.get_tgt_bits())
-        if database.is_tgt_little_endian():
-            logger.debug("# Endianness: Little")
-        else:
-            logger.debug("# Endianness: Big")
-
+    logger.debug("# Build ID: %s", database.get_build_id())
+    logger.debug("# Target: %s, %d-bit", database.get_arch(), database.get_tgt_bits())
+    if database.is_tgt_little_endian():
+        logger.debug("# Endianness: Little")
+    else:
+        logger.debug("# Endianness: Big")
+
+    if args.framed:
+        remaining = parse_framed_log_data(log_parser, logdata,
+                                          database.is_tgt_little_endian(),
+                                          args.debug)
+        if remaining:
+            logger.warning("--- %d byte(s) of incomplete frame at the end ---",
+                           len(remaining))
+    else:
         ret = log_parser.parse_log_data(logdata, debug=args.debug)
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
-    else:
-        logger.error("ERROR: Cannot find a suitable parser matching database version!")
-        sys.exit(1)
 
 
 if __name__ == "__main__":
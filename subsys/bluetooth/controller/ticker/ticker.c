@@ -24,6 +24,20 @@
  ****************************************************************************/
 #define DOUBLE_BUFFER_SIZE 2
 
+#if defined(CONFIG_BT_TICKER_WHEEL)
+#define TICKER_WHEEL_SLOTS CONFIG_BT_TICKER_WHEEL_SLOTS
+#define TICKER_WHEEL_SHIFT CONFIG_BT_TICKER_WHEEL_SLOT_SHIFT
+#define TICKER_WHEEL_SPAN  ((uint32_t)TICKER_WHEEL_SLOTS << TICKER_WHEEL_SHIFT)
+#define TICKER_WHEEL_MASK  (TICKER_WHEEL_SLOTS - 1)
+
+/* Slot of ticker nodes expiring beyond the timing wheel */
+#define TICKER_WHEEL_FAR   ((uint8_t)(TICKER_NULL - 1))
+
+BUILD_ASSERT((TICKER_WHEEL_SLOTS >= 32) &&
+	     !(TICKER_WHEEL_SLOTS & TICKER_WHEEL_MASK),
+	     "Timing wheel slots must be a power of two, from 32");
+#endif /* CONFIG_BT_TICKER_WHEEL */
+
 /*****************************************************************************
  * Types
  ****************************************************************************/
@@ -85,6 +99,17 @@ struct ticker_node {
 					     * default. Lower value is higher
 					     * priority
 					     */
+#if defined(CONFIG_BT_TICKER_WHEEL)
+	uint8_t  prev;			    /* Previous ticker node */
+	uint8_t  wheel_slot;		    /* Timing wheel slot of node,
+					     * TICKER_WHEEL_FAR if beyond the
+					     * wheel or TICKER_NULL if not
+					     * in the list
+					     */
+	uint32_t ticks_abs;		    /* Expiration in timing wheel
+					     * ticks
+					     */
+#endif /* CONFIG_BT_TICKER_WHEEL */
 #endif /* !CONFIG_BT_TICKER_LOW_LAT &&
 	* !CONFIG_BT_TICKER_SLOT_AGNOSTIC
 	*/
@@ -265,6 +290,20 @@ struct ticker_instance {
 					 * ticker_worker at end of job, if
 					 * requested
 					 */
+#if defined(CONFIG_BT_TICKER_WHEEL)
+	uint8_t  ticker_id_tail;	/* Index of last ticker node */
+	uint8_t  ticker_id_far;		/* Index of first ticker node expiring
+					 * beyond the timing wheel
+					 */
+	uint32_t ticks_wheel;		/* Timing wheel ticks from which the
+					 * ticks_to_expire of the first ticker
+					 * node counts
+					 */
+	uint32_t wheel_map[TICKER_WHEEL_SLOTS / 32]; /* Non-empty slots */
+	uint8_t  wheel_head[TICKER_WHEEL_SLOTS];     /* First ticker node of
+						      * each slot
+						      */
+#endif /* CONFIG_BT_TICKER_WHEEL */
 
 	ticker_caller_id_get_cb_t caller_id_get_cb; /* Function for retrieving
 						     * the caller id from user
@@ -464,7 +503,353 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 	*ticks_to_expire = _ticks_to_expire;
 }
 
-#if !defined(CONFIG_BT_TICKER_LOW_LAT)
+#if defined(CONFIG_BT_TICKER_WHEEL)
+/**
+ * @brief Get timing wheel slot
+ *
+ * @details The timing wheel spans TICKER_WHEEL_SLOTS whole slots, starting
+ * with the slot from which ticks_to_expire of the first ticker node counts.
+ *
+ * @param instance  Pointer to ticker instance
+ * @param ticks_abs Expiration in timing wheel ticks
+ *
+ * @return Slot index, or TICKER_WHEEL_FAR if expiring beyond the wheel
+ * @internal
+ */
+static inline uint8_t ticker_wheel_slot_get(struct ticker_instance *instance,
+					    uint32_t ticks_abs)
+{
+	uint32_t ticks_start;
+
+	ticks_start = instance->ticks_wheel & ~BIT_MASK(TICKER_WHEEL_SHIFT);
+	if ((ticks_abs - ticks_start) >= TICKER_WHEEL_SPAN) {
+		return TICKER_WHEEL_FAR;
+	}
+
+	return (ticks_abs >> TICKER_WHEEL_SHIFT) & TICKER_WHEEL_MASK;
+}
+
+/**
+ * @brief Get first ticker node after a timing wheel slot
+ *
+ * @details Searches the slot map, in expiration order, for the first
+ * non-empty slot following the given one.
+ *
+ * @param instance Pointer to ticker instance
+ * @param slot     Slot to search from, excluded
+ *
+ * @return Id of first ticker node of the next non-empty slot, id of first
+ * ticker node beyond the wheel, or TICKER_NULL
+ * @internal
+ */
+static uint8_t ticker_wheel_next_get(struct ticker_instance *instance,
+				     uint8_t slot)
+{
+	uint32_t slot_start;
+	uint32_t offset;
+
+	slot_start = (instance->ticks_wheel >> TICKER_WHEEL_SHIFT) &
+		     TICKER_WHEEL_MASK;
+	offset = ((slot - slot_start) & TICKER_WHEEL_MASK) + 1U;
+
+	while (offset < TICKER_WHEEL_SLOTS) {
+		uint32_t map;
+
+		slot = (slot_start + offset) & TICKER_WHEEL_MASK;
+		map = instance->wheel_map[slot >> 5] >> (slot & 31U);
+		if (map) {
+			offset += find_lsb_set(map) - 1U;
+			if (offset < TICKER_WHEEL_SLOTS) {
+				slot = (slot_start + offset) &
+				       TICKER_WHEEL_MASK;
+
+				return instance->wheel_head[slot];
+			}
+
+			break;
+		}
+
+		offset += 32U - (slot & 31U);
+	}
+
+	return instance->ticker_id_far;
+}
+
+/**
+ * @brief Add ticker node to timing wheel
+ *
+ * @details Called after the node is linked in the list. Nodes of a slot are
+ * adjacent in the list, the node becomes the first of its slot if linked in
+ * front of the current first one.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to add
+ *
+ * @internal
+ */
+static void ticker_wheel_add(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *ticker = &instance->nodes[id];
+	uint8_t slot;
+
+	slot = ticker_wheel_slot_get(instance, ticker->ticks_abs);
+	ticker->wheel_slot = slot;
+
+	if (slot == TICKER_WHEEL_FAR) {
+		if ((instance->ticker_id_far == TICKER_NULL) ||
+		    (instance->ticker_id_far == ticker->next)) {
+			instance->ticker_id_far = id;
+		}
+	} else if (!(instance->wheel_map[slot >> 5] & BIT(slot & 31U))) {
+		instance->wheel_map[slot >> 5] |= BIT(slot & 31U);
+		instance->wheel_head[slot] = id;
+	} else if (instance->wheel_head[slot] == ticker->next) {
+		instance->wheel_head[slot] = id;
+	}
+}
+
+/**
+ * @brief Remove ticker node from timing wheel
+ *
+ * @details Called before the node is unlinked from the list.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to remove
+ *
+ * @internal
+ */
+static void ticker_wheel_remove(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	struct ticker_node *ticker = &node[id];
+	uint8_t slot = ticker->wheel_slot;
+	uint8_t next = ticker->next;
+
+	if (slot == TICKER_WHEEL_FAR) {
+		if (instance->ticker_id_far == id) {
+			instance->ticker_id_far = next;
+		}
+	} else if (instance->wheel_head[slot] == id) {
+		if ((next != TICKER_NULL) && (node[next].wheel_slot == slot)) {
+			instance->wheel_head[slot] = next;
+		} else {
+			instance->wheel_map[slot >> 5] &= ~BIT(slot & 31U);
+		}
+	}
+
+	ticker->wheel_slot = TICKER_NULL;
+}
+
+/**
+ * @brief Advance timing wheel
+ *
+ * @details Called after ticks_wheel moved forward. Adds the ticker nodes
+ * which are no longer beyond the wheel to their slots.
+ *
+ * @param instance Pointer to ticker instance
+ *
+ * @internal
+ */
+static void ticker_wheel_advance(struct ticker_instance *instance)
+{
+	uint8_t id;
+
+	while (((id = instance->ticker_id_far) != TICKER_NULL) &&
+	       (ticker_wheel_slot_get(instance,
+				      instance->nodes[id].ticks_abs) !=
+		TICKER_WHEEL_FAR)) {
+		instance->ticker_id_far = instance->nodes[id].next;
+		ticker_wheel_add(instance, id);
+	}
+}
+
+#if defined(CONFIG_BT_TICKER_EXT)
+/**
+ * @brief Rebuild timing wheel
+ *
+ * @details Re-indexes all ticker nodes from the list, after nodes were
+ * relinked without ticker_enqueue.
+ *
+ * @param instance Pointer to ticker instance
+ *
+ * @internal
+ */
+static void ticker_wheel_rebuild(struct ticker_instance *instance)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	uint32_t ticks_abs;
+	uint8_t previous;
+	uint8_t id;
+
+	for (id = 0U; id < ARRAY_SIZE(instance->wheel_map); id++) {
+		instance->wheel_map[id] = 0U;
+	}
+	instance->ticker_id_far = TICKER_NULL;
+
+	ticks_abs = instance->ticks_wheel;
+	previous = TICKER_NULL;
+	for (id = instance->ticker_id_head; id != TICKER_NULL;
+	     id = node[id].next) {
+		ticks_abs += node[id].ticks_to_expire;
+		node[id].ticks_abs = ticks_abs;
+		node[id].prev = previous;
+		ticker_wheel_add(instance, id);
+		previous = id;
+	}
+	instance->ticker_id_tail = previous;
+}
+#endif /* CONFIG_BT_TICKER_EXT */
+
+/**
+ * @brief Enqueue ticker node
+ *
+ * @details Finds insertion point for new ticker node and inserts the
+ * node in the linked node list. The search starts at the timing wheel slot
+ * of the new node, and yields the same insertion point as a search from the
+ * head of the list.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to enqueue
+ *
+ * @return Id of enqueued ticker node
+ * @internal
+ */
+static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *ticker_current;
+	struct ticker_node *ticker_new;
+	uint32_t ticks_to_expire_current;
+	struct ticker_node *node;
+	uint32_t ticks_to_expire;
+	uint32_t ticks_abs;
+	uint8_t previous;
+	uint8_t current;
+	uint8_t slot;
+
+	node = &instance->nodes[0];
+	ticker_new = &node[id];
+	ticks_to_expire = ticker_new->ticks_to_expire;
+	ticks_abs = instance->ticks_wheel + ticks_to_expire;
+
+	/* All ticker nodes before the first node of the slot, or before the
+	 * first node after an empty slot, expire earlier than the new node.
+	 */
+	slot = ticker_wheel_slot_get(instance, ticks_abs);
+	if (slot == TICKER_WHEEL_FAR) {
+		current = instance->ticker_id_far;
+	} else if (instance->wheel_map[slot >> 5] & BIT(slot & 31U)) {
+		current = instance->wheel_head[slot];
+	} else {
+		current = ticker_wheel_next_get(instance, slot);
+	}
+
+	if (current != TICKER_NULL) {
+		previous = node[current].prev;
+	} else {
+		previous = instance->ticker_id_tail;
+	}
+
+	/* Find insertion point for new ticker node */
+	while (current != TICKER_NULL) {
+		ticker_current = &node[current];
+		ticks_to_expire_current = ticker_current->ticks_abs -
+					  instance->ticks_wheel;
+
+		if (ticks_to_expire < ticks_to_expire_current) {
+			break;
+		}
+
+		/* Check for timeout in same tick - prioritize according to
+		 * latency
+		 */
+		if ((ticks_to_expire == ticks_to_expire_current) &&
+		    (ticker_new->lazy_current > ticker_current->lazy_current)) {
+			break;
+		}
+
+		previous = current;
+		current = ticker_current->next;
+	}
+
+	/* Link in new ticker node and adjust ticks_to_expire to relative value
+	 */
+	ticker_new->ticks_abs = ticks_abs;
+	ticker_new->next = current;
+	ticker_new->prev = previous;
+
+	if (previous == TICKER_NULL) {
+		instance->ticker_id_head = id;
+	} else {
+		ticker_new->ticks_to_expire = ticks_abs -
+					      node[previous].ticks_abs;
+		node[previous].next = id;
+	}
+
+	if (current == TICKER_NULL) {
+		instance->ticker_id_tail = id;
+	} else {
+		node[current].ticks_to_expire = node[current].ticks_abs -
+						ticks_abs;
+		node[current].prev = id;
+	}
+
+	ticker_wheel_add(instance, id);
+
+	return id;
+}
+
+/**
+ * @brief Dequeue ticker node
+ *
+ * @details Unlinks the ticker node and adjusts the links and
+ * ticks_to_expire. Returns the ticks until expiration for dequeued ticker
+ * node.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to dequeue
+ *
+ * @return Total ticks until expiration for dequeued ticker node, or 0 if
+ * node was not found
+ * @internal
+ */
+static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *ticker_current;
+	struct ticker_node *node;
+	uint8_t previous;
+	uint8_t next;
+
+	node = &instance->nodes[0];
+	ticker_current = &node[id];
+	if (ticker_current->wheel_slot == TICKER_NULL) {
+		/* Ticker not in active list */
+		return 0;
+	}
+
+	ticker_wheel_remove(instance, id);
+
+	previous = ticker_current->prev;
+	next = ticker_current->next;
+
+	if (previous == TICKER_NULL) {
+		instance->ticker_id_head = next;
+	} else {
+		node[previous].next = next;
+	}
+
+	/* If this is not the last ticker, increment the next ticker by this
+	 * ticker timeout
+	 */
+	if (next == TICKER_NULL) {
+		instance->ticker_id_tail = previous;
+	} else {
+		node[next].ticks_to_expire += ticker_current->ticks_to_expire;
+		node[next].prev = previous;
+	}
+
+	return ticker_current->ticks_abs - instance->ticks_wheel;
+}
+#elif !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
  *
@@ -632,6 +1017,7 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 }
 #endif /* !CONFIG_BT_TICKER_LOW_LAT */
 
+#if !defined(CONFIG_BT_TICKER_WHEEL)
 /**
  * @brief Dequeue ticker node
  *
@@ -702,6 +1088,7 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 
 	return (total + timeout);
 }
+#endif /* !CONFIG_BT_TICKER_WHEEL */
 
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
@@ -1511,6 +1898,9 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 		ticks_to_expire = ticker->ticks_to_expire;
 		if (ticks_elapsed < ticks_to_expire) {
 			ticker->ticks_to_expire -= ticks_elapsed;
+#if defined(CONFIG_BT_TICKER_WHEEL)
+			instance->ticks_wheel += ticks_elapsed;
+#endif /* CONFIG_BT_TICKER_WHEEL */
 			break;
 		}
 
@@ -1552,7 +1942,12 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 		ticker->ticks_to_expire = 0U;
 
 		/* remove the expired ticker from head */
+#if defined(CONFIG_BT_TICKER_WHEEL)
+		instance->ticks_wheel += ticks_to_expire;
+		(void)ticker_dequeue(instance, id_expired);
+#else /* !CONFIG_BT_TICKER_WHEEL */
 		instance->ticker_id_head = ticker->next;
+#endif /* !CONFIG_BT_TICKER_WHEEL */
 
 		/* Ticker will be restarted if periodic or to be re-scheduled */
 		if ((ticker->ticks_periodic != 0U) ||
@@ -1672,6 +2067,11 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 			ticker->req = ticker->ack;
 		}
 	}
+
+#if defined(CONFIG_BT_TICKER_WHEEL)
+	/* Index the ticker nodes the wheel has advanced to */
+	ticker_wheel_advance(instance);
+#endif /* CONFIG_BT_TICKER_WHEEL */
 }
 
 /**
@@ -1968,6 +2368,13 @@ static uint8_t ticker_job_reschedule_in_window(struct ticker_instance *instance,
 		rescheduled  = 1U;
 	}
 
+#if defined(CONFIG_BT_TICKER_WHEEL)
+	if (rescheduled) {
+		/* Nodes were relinked in place, re-index the list */
+		ticker_wheel_rebuild(instance);
+	}
+#endif /* CONFIG_BT_TICKER_WHEEL */
+
 	return rescheduled;
 }
 #endif /* CONFIG_BT_TICKER_EXT */
@@ -2545,6 +2952,9 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 	while (count_node--) {
 		instance->nodes[count_node].priority = 0;
+#if defined(CONFIG_BT_TICKER_WHEEL)
+		instance->nodes[count_node].wheel_slot = TICKER_NULL;
+#endif /* CONFIG_BT_TICKER_WHEEL */
 	}
 #endif /* !CONFIG_BT_TICKER_LOW_LAT &&
 	* !CONFIG_BT_TICKER_SLOT_AGNOSTIC
@@ -2571,6 +2981,14 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->trigger_set_cb = trigger_set_cb;
 
 	instance->ticker_id_head = TICKER_NULL;
+#if defined(CONFIG_BT_TICKER_WHEEL)
+	instance->ticker_id_tail = TICKER_NULL;
+	instance->ticker_id_far = TICKER_NULL;
+	instance->ticks_wheel = 0U;
+	for (uint8_t i = 0U; i < ARRAY_SIZE(instance->wheel_map); i++) {
+		instance->wheel_map[i] = 0U;
+	}
+#endif /* CONFIG_BT_TICKER_WHEEL */
 	instance->ticker_id_slot_previous = TICKER_NULL;
 	instance->ticks_slot_previous = 0U;
 	instance->ticks_current = 0U;
@@ -41,12 +41,20 @@
 #define TICKER_NODE_T_SIZE      40
 #else
 #if defined(CONFIG_BT_TICKER_EXT)
+#if defined(CONFIG_BT_TICKER_WHEEL)
+#define TICKER_NODE_T_SIZE      52
+#else
 #define TICKER_NODE_T_SIZE      48
+#endif /* CONFIG_BT_TICKER_WHEEL */
 #else
 #if defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 #define TICKER_NODE_T_SIZE      36
 #else
+#if defined(CONFIG_BT_TICKER_WHEEL)
+#define TICKER_NODE_T_SIZE      48
+#else
 #define TICKER_NODE_T_SIZE      44
+#endif /* CONFIG_BT_TICKER_WHEEL */
 #endif /* CONFIG_BT_TICKER_SLOT_AGNOSTIC */
 #endif /* CONFIG_BT_TICKER_EXT */
 #endif /* CONFIG_BT_TICKER_LOW_LAT */
@@ -79,6 +79,20 @@ static const uint16_t gap_appearance = CONFIG_BT_DEVICE_APPEARANCE;
 static sys_slist_t db;
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Static attributes by handle, used if all of them are indexed */
+static const struct bt_gatt_attr
+	*static_attrs[CONFIG_BT_GATT_ATTR_INDEX_STATIC_MAX];
+static bool static_attrs_valid;
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+/* Dynamic services in handle order, -1 if they are not all indexed */
+static struct bt_gatt_service
+	*dyn_svcs[CONFIG_BT_GATT_ATTR_INDEX_DYNAMIC_MAX];
+static int dyn_svc_count;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static atomic_t init;
 static atomic_t service_init;
 
@@ -876,6 +890,27 @@ static const struct bt_gatt_attr *find_attr(uint16_t handle)
 	return attr;
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static void dyn_index_build(void)
+{
+	struct bt_gatt_service *svc;
+	int count = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		if (count == ARRAY_SIZE(dyn_svcs)) {
+			BT_WARN("Only %zu dynamic services can be indexed",
+				ARRAY_SIZE(dyn_svcs));
+			dyn_svc_count = -1;
+			return;
+		}
+
+		dyn_svcs[count++] = svc;
+	}
+
+	dyn_svc_count = count;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static void gatt_insert(struct bt_gatt_service *svc, uint16_t last_handle)
 {
 	struct bt_gatt_service *tmp, *prev = NULL;
@@ -940,6 +975,10 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	dyn_index_build();
+#endif
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1088,6 +1127,27 @@ static void ccc_delayed_store(struct k_work *work)
 }
 #endif
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static void static_index_build(void)
+{
+	uint16_t handle = 0U;
+
+	if (last_static_handle > ARRAY_SIZE(static_attrs)) {
+		BT_WARN("Only %zu of %u static attributes can be indexed",
+			ARRAY_SIZE(static_attrs), last_static_handle);
+		return;
+	}
+
+	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			static_attrs[handle++] = &svc->attrs[i];
+		}
+	}
+
+	static_attrs_valid = true;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static void bt_gatt_service_init(void)
 {
 	if (!atomic_cas(&service_init, 0, 1)) {
@@ -1097,6 +1157,10 @@ static void bt_gatt_service_init(void)
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	static_index_build();
+#endif
 }
 
 void bt_gatt_init(void)
@@ -1237,6 +1301,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	dyn_index_build();
+#endif
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1399,11 +1467,7 @@ uint16_t bt_gatt_attr_get_handle(const struct bt_gatt_attr *attr)
 			continue;
 		}
 
-		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
-			if (attr == &static_svc->attrs[i]) {
-				return handle;
-			}
-		}
+		return handle + (attr - &static_svc->attrs[0]);
 	}
 
 	return 0;
@@ -1536,6 +1600,70 @@ static uint8_t gatt_foreach_iter(const struct bt_gatt_attr *attr,
 	return result;
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX) && defined(CONFIG_BT_GATT_DYNAMIC_DB)
+/* Index of the first attribute of a service with a handle not lower than
+ * start_handle, attributes of a service are in ascending handle order.
+ */
+static size_t svc_attr_find(const struct bt_gatt_service *svc,
+			    uint16_t start_handle)
+{
+	size_t lo = 0, hi = svc->attr_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (svc->attrs[mid].handle < start_handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void foreach_attr_type_dyn_index(uint16_t start_handle,
+					uint16_t end_handle,
+					const struct bt_uuid *uuid,
+					const void *attr_data,
+					uint16_t num_matches,
+					bt_gatt_attr_func_t func,
+					void *user_data)
+{
+	size_t count = dyn_svc_count;
+	size_t lo = 0, hi = count;
+
+	/* Find the first service not ending before start_handle */
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		struct bt_gatt_service *svc = dyn_svcs[mid];
+
+		if (svc->attrs[svc->attr_count - 1].handle < start_handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; lo < count; lo++) {
+		struct bt_gatt_service *svc = dyn_svcs[lo];
+
+		for (size_t i = svc_attr_find(svc, start_handle);
+		     i < svc->attr_count; i++) {
+			struct bt_gatt_attr *attr = &svc->attrs[i];
+
+			if (gatt_foreach_iter(attr, attr->handle,
+					      start_handle, end_handle,
+					      uuid, attr_data, &num_matches,
+					      func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX && CONFIG_BT_GATT_DYNAMIC_DB */
+
 static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 				    const struct bt_uuid *uuid,
 				    const void *attr_data, uint16_t num_matches,
@@ -1545,6 +1673,15 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 	size_t i;
 	struct bt_gatt_service *svc;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (dyn_svc_count >= 0) {
+		foreach_attr_type_dyn_index(start_handle, end_handle, uuid,
+					    attr_data, num_matches, func,
+					    user_data);
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
 		struct bt_gatt_service *next;
 
@@ -1584,6 +1721,23 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (static_attrs_valid && start_handle <= last_static_handle) {
+		for (uint16_t handle = MAX(start_handle, 1U);
+		     handle <= last_static_handle; handle++) {
+			if (gatt_foreach_iter(static_attrs[handle - 1], handle,
+					      start_handle, end_handle, uuid,
+					      attr_data, &num_matches, func,
+					      user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+
+		start_handle = last_static_handle + 1;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
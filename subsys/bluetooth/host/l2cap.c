@@ -1632,7 +1632,7 @@ static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf)
 
 static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 					     struct net_buf *buf,
-					     size_t sdu_hdr_len)
+					     size_t sdu_hdr_len, uint16_t sdu_len)
 {
 	struct net_buf *seg;
 	uint16_t headroom;
@@ -1651,7 +1651,7 @@ static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 	if (net_buf_headroom(buf) >= headroom && !buf->frags) {
 		if (sdu_hdr_len) {
 			/* Push SDU length if set */
-			net_buf_push_le16(buf, net_buf_frags_len(buf));
+			net_buf_push_le16(buf, sdu_len);
 		}
 		return net_buf_ref(buf);
 	}
@@ -1663,7 +1663,7 @@ segment:
 	}
 
 	if (sdu_hdr_len) {
-		net_buf_add_le16(seg, net_buf_frags_len(buf));
+		net_buf_add_le16(seg, sdu_len);
 	}
 
 	/* Don't send more that TX MPS including SDU length */
@@ -1749,12 +1749,19 @@ static bool test_and_dec(atomic_t *target)
  *
  * In all cases the original buffer is unaffected so it can be pushed back to
  * be sent later.
+ *
+ * A fragment which fits in a segment is sent as it is, and *frag is then
+ * updated to the next fragment of the SDU.
  */
 static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
-			      struct net_buf *buf, uint16_t sdu_hdr_len)
+			      struct net_buf **frag, uint16_t sdu_hdr_len,
+			      uint16_t sdu_len)
 {
+	struct net_buf *buf = *frag;
+	struct net_buf *next = buf->frags;
 	struct net_buf *seg;
 	struct net_buf_simple_state state;
+	bt_conn_tx_cb_t cb;
 	int len, err;
 
 	if (!test_and_dec(&ch->tx.credits)) {
@@ -1765,8 +1772,12 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 	/* Save state so it can be restored if we failed to send */
 	net_buf_simple_save(&buf->b, &state);
 
-	seg = l2cap_chan_create_seg(ch, buf, sdu_hdr_len);
+	/* Segments never carry the following fragments */
+	buf->frags = NULL;
+
+	seg = l2cap_chan_create_seg(ch, buf, sdu_hdr_len, sdu_len);
 	if (!seg) {
+		buf->frags = next;
 		atomic_inc(&ch->tx.credits);
 		return -EAGAIN;
 	}
@@ -1776,29 +1787,28 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 
 	len = seg->len - sdu_hdr_len;
 
-	/* Set a callback if there is no data left in the buffer and sent
-	 * callback has been set.
+	/* Set the SDU sent callback on the last segment if sent callback has
+	 * been set. Every other segment resumes sending when it completes, as
+	 * it holds a buffer the following segments may need.
 	 */
-	if ((buf == seg || !buf->len) && ch->chan.ops->sent) {
-		err = bt_l2cap_send_cb(ch->chan.conn, ch->tx.cid, seg,
-				       l2cap_chan_sdu_sent,
-				       UINT_TO_POINTER(ch->tx.cid));
+	if (!next && (buf == seg || !buf->len) && ch->chan.ops->sent) {
+		cb = l2cap_chan_sdu_sent;
 	} else {
-		err = bt_l2cap_send_cb(ch->chan.conn, ch->tx.cid, seg,
-				       l2cap_chan_seg_sent,
-				       UINT_TO_POINTER(ch->tx.cid));
+		cb = l2cap_chan_seg_sent;
 	}
 
+	err = bt_l2cap_send_cb(ch->chan.conn, ch->tx.cid, seg, cb,
+			       UINT_TO_POINTER(ch->tx.cid));
 	if (err) {
 		BT_WARN("Unable to send seg %d", err);
 		atomic_inc(&ch->tx.credits);
 
-		/* If the segment is not the original buffer release it since it
-		 * won't be needed anymore.
+		/* Release the segment, or the reference taken on the original
+		 * buffer, since it won't be needed anymore.
 		 */
-		if (seg != buf) {
-			net_buf_unref(seg);
-		}
+		net_buf_unref(seg);
+
+		buf->frags = next;
 
 		if (err == -ENOBUFS) {
 			/* Restore state since segment could not be sent */
@@ -1809,6 +1819,16 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 		return err;
 	}
 
+	if (seg != buf) {
+		buf->frags = next;
+	} else if (next) {
+		/* The fragment itself is being sent, continue with the next
+		 * one without touching it anymore.
+		 */
+		net_buf_unref(buf);
+		*frag = next;
+	}
+
 	/* Check if there is no credits left clear output status and notify its
 	 * change.
 	 */
@@ -1841,7 +1861,8 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 
 	if (!sent) {
 		/* Add SDU length for the first segment */
-		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_SIZE);
+		ret = l2cap_chan_le_send(ch, &frag, BT_L2CAP_SDU_HDR_SIZE,
+					 total_len);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1860,7 +1881,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			frag = net_buf_frag_del(NULL, frag);
 		}
 
-		ret = l2cap_chan_le_send(ch, frag, 0);
+		ret = l2cap_chan_le_send(ch, &frag, 0, total_len);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -9,6 +9,7 @@
 #include <zephyr.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/util.h>
 #include <sys/byteorder.h>
 
@@ -51,6 +52,18 @@ struct mod_pub_val {
 static const struct bt_mesh_comp *dev_comp;
 static uint16_t dev_primary_addr;
 
+#if defined(CONFIG_BT_MESH_ACCESS_OP_INDEX)
+/* Opcodes of the models, sorted by opcode and then by element. Only the first
+ * model of an element supporting an opcode receives it, like without index.
+ */
+static struct op_index_entry {
+	uint32_t opcode;
+	struct bt_mesh_model *mod;
+	const struct bt_mesh_model_op *op;
+} op_index[CONFIG_BT_MESH_ACCESS_OP_INDEX_SIZE];
+static int op_index_count;
+#endif /* CONFIG_BT_MESH_ACCESS_OP_INDEX */
+
 void bt_mesh_model_foreach(void (*func)(struct bt_mesh_model *mod,
 					struct bt_mesh_elem *elem,
 					bool vnd, bool primary,
@@ -357,6 +370,88 @@ static void mod_init(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 	}
 }
 
+#if defined(CONFIG_BT_MESH_ACCESS_OP_INDEX)
+static void op_index_add(struct bt_mesh_model *mod, bool vnd,
+			 const struct bt_mesh_model_op *op)
+{
+	struct op_index_entry *entry;
+	int i;
+
+	/* SIG models only receive SIG opcodes and vendor models only vendor
+	 * opcodes of their company.
+	 */
+	if (vnd != (BT_MESH_MODEL_OP_LEN(op->opcode) == 3)) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_BT_MESH_MODEL_VND_MSG_CID_FORCE) && vnd &&
+	    (uint16_t)(op->opcode & 0xffff) != mod->vnd.company) {
+		return;
+	}
+
+	for (i = op_index_count; i > 0; i--) {
+		entry = &op_index[i - 1];
+
+		if (entry->opcode < op->opcode ||
+		    (entry->opcode == op->opcode &&
+		     entry->mod->elem_idx < mod->elem_idx)) {
+			break;
+		}
+
+		/* Models are added in order, the first one of the element
+		 * supporting the opcode is kept.
+		 */
+		if (entry->opcode == op->opcode &&
+		    entry->mod->elem_idx == mod->elem_idx) {
+			return;
+		}
+	}
+
+	if (op_index_count == ARRAY_SIZE(op_index)) {
+		BT_WARN("Too many opcodes to index");
+		op_index_count = -1;
+		return;
+	}
+
+	memmove(&op_index[i + 1], &op_index[i],
+		(op_index_count - i) * sizeof(op_index[0]));
+
+	entry = &op_index[i];
+	entry->opcode = op->opcode;
+	entry->mod = mod;
+	entry->op = op;
+	op_index_count++;
+}
+
+static void op_index_build(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+			   bool vnd, bool primary, void *user_data)
+{
+	const struct bt_mesh_model_op *op;
+
+	for (op = mod->op; op->func && op_index_count >= 0; op++) {
+		op_index_add(mod, vnd, op);
+	}
+}
+
+/* First entry of an opcode, or the end of the index if it isn't found */
+static struct op_index_entry *op_index_find(uint32_t opcode)
+{
+	int lo = 0, hi = op_index_count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (op_index[mid].opcode < opcode) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return &op_index[lo];
+}
+#endif /* CONFIG_BT_MESH_ACCESS_OP_INDEX */
+
 int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 {
 	int err;
@@ -371,6 +466,13 @@ int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 	err = 0;
 	bt_mesh_model_foreach(mod_init, &err);
 
+#if defined(CONFIG_BT_MESH_ACCESS_OP_INDEX)
+	if (!err) {
+		op_index_count = 0;
+		bt_mesh_model_foreach(op_index_build, NULL);
+	}
+#endif
+
 	return err;
 }
 
@@ -627,6 +729,34 @@ static int get_opcode(struct net_buf_simple *buf, uint32_t *opcode)
 	CODE_UNREACHABLE;
 }
 
+static void model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf,
+		       struct bt_mesh_model *model,
+		       const struct bt_mesh_model_op *op, uint32_t opcode)
+{
+	struct net_buf_simple_state state;
+
+	if (!model_has_key(model, rx->ctx.app_idx)) {
+		return;
+	}
+
+	if (!model_has_dst(model, rx->ctx.recv_dst)) {
+		return;
+	}
+
+	if (buf->len < op->min_len) {
+		BT_ERR("Too short message for OpCode 0x%08x", opcode);
+		return;
+	}
+
+	/* The callback will likely parse the buffer, so
+	 * store the parsing state in case multiple models
+	 * receive the message.
+	 */
+	net_buf_simple_save(buf, &state);
+	op->func(model, &rx->ctx, buf);
+	net_buf_simple_restore(buf, &state);
+}
+
 void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 {
 	struct bt_mesh_model *model;
@@ -645,35 +775,27 @@ void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 
 	BT_DBG("OpCode 0x%08x", opcode);
 
-	for (i = 0; i < dev_comp->elem_count; i++) {
-		struct net_buf_simple_state state;
-
-		op = find_op(&dev_comp->elem[i], opcode, &model);
-		if (!op) {
-			BT_DBG("No OpCode 0x%08x for elem %d", opcode, i);
-			continue;
-		}
+#if defined(CONFIG_BT_MESH_ACCESS_OP_INDEX)
+	if (op_index_count >= 0) {
+		struct op_index_entry *entry = op_index_find(opcode);
 
-		if (!model_has_key(model, rx->ctx.app_idx)) {
-			continue;
+		for (; entry < &op_index[op_index_count] &&
+		       entry->opcode == opcode; entry++) {
+			model_recv(rx, buf, entry->mod, entry->op, opcode);
 		}
 
-		if (!model_has_dst(model, rx->ctx.recv_dst)) {
-			continue;
-		}
+		return;
+	}
+#endif /* CONFIG_BT_MESH_ACCESS_OP_INDEX */
 
-		if (buf->len < op->min_len) {
-			BT_ERR("Too short message for OpCode 0x%08x", opcode);
+	for (i = 0; i < dev_comp->elem_count; i++) {
+		op = find_op(&dev_comp->elem[i], opcode, &model);
+		if (!op) {
+			BT_DBG("No OpCode 0x%08x for elem %d", opcode, i);
 			continue;
 		}
 
-		/* The callback will likely parse the buffer, so
-		 * store the parsing state in case multiple models
-		 * receive the message.
-		 */
-		net_buf_simple_save(buf, &state);
-		op->func(model, &rx->ctx, buf);
-		net_buf_simple_restore(buf, &state);
+		model_recv(rx, buf, model, op, opcode);
 	}
 }
 
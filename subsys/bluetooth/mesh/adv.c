@@ -60,6 +60,31 @@ static struct bt_mesh_adv *adv_alloc(int id)
 	return &adv_pool[id];
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+#if BT_MESH_RELAY_ADV_SETS
+K_FIFO_DEFINE(bt_mesh_adv_relay_queue);
+#endif
+
+static void relay_buf_destroy(struct net_buf *buf)
+{
+	adv_buf_destroy(buf);
+
+	/* Resume relaying of the queued packets */
+	bt_mesh_net_relay_resume();
+}
+
+NET_BUF_POOL_DEFINE(relay_buf_pool, CONFIG_BT_MESH_RELAY_BUF_COUNT,
+		    BT_MESH_ADV_DATA_SIZE, BT_MESH_ADV_USER_DATA_SIZE,
+		    relay_buf_destroy);
+
+static struct bt_mesh_adv relay_adv_pool[CONFIG_BT_MESH_RELAY_BUF_COUNT];
+
+static struct bt_mesh_adv *relay_adv_alloc(int id)
+{
+	return &relay_adv_pool[id];
+}
+#endif /* CONFIG_BT_MESH_RELAY_QUEUE */
+
 struct net_buf *bt_mesh_adv_create_from_pool(struct net_buf_pool *pool,
 					     bt_mesh_adv_alloc_t get_id,
 					     enum bt_mesh_adv_type type,
@@ -96,6 +121,21 @@ struct net_buf *bt_mesh_adv_create(enum bt_mesh_adv_type type, uint8_t xmit,
 					    xmit, timeout);
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+struct net_buf *bt_mesh_adv_relay_create(uint8_t xmit)
+{
+	struct net_buf *buf;
+
+	buf = bt_mesh_adv_create_from_pool(&relay_buf_pool, relay_adv_alloc,
+					   BT_MESH_ADV_DATA, xmit, K_NO_WAIT);
+	if (buf) {
+		BT_MESH_ADV(buf)->relay = 1U;
+	}
+
+	return buf;
+}
+#endif
+
 void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 		      void *cb_data)
 {
@@ -106,6 +146,14 @@ void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 	BT_MESH_ADV(buf)->cb_data = cb_data;
 	BT_MESH_ADV(buf)->busy = 1U;
 
+#if BT_MESH_RELAY_ADV_SETS
+	if (BT_MESH_ADV(buf)->relay) {
+		net_buf_put(&bt_mesh_adv_relay_queue, net_buf_ref(buf));
+		bt_mesh_adv_relay_ready();
+		return;
+	}
+#endif
+
 	net_buf_put(&bt_mesh_adv_queue, net_buf_ref(buf));
 	bt_mesh_adv_buf_ready();
 }
@@ -18,6 +18,13 @@
 #define BT_MESH_SCAN_INTERVAL_MS 30
 #define BT_MESH_SCAN_WINDOW_MS   30
 
+/* Number of extended advertising sets dedicated to relayed packets */
+#if defined(CONFIG_BT_MESH_RELAY_ADV_SETS)
+#define BT_MESH_RELAY_ADV_SETS CONFIG_BT_MESH_RELAY_ADV_SETS
+#else
+#define BT_MESH_RELAY_ADV_SETS 0
+#endif
+
 enum bt_mesh_adv_type {
 	BT_MESH_ADV_PROV,
 	BT_MESH_ADV_DATA,
@@ -36,7 +43,8 @@ struct bt_mesh_adv {
 
 	uint8_t      type:2,
 		  started:1,
-		  busy:1;
+		  busy:1,
+		  relay:1;
 
 	uint8_t      xmit;
 };
@@ -45,6 +53,9 @@ typedef struct bt_mesh_adv *(*bt_mesh_adv_alloc_t)(int id);
 
 extern struct k_fifo bt_mesh_adv_queue;
 
+/* Relayed packets waiting for one of the relay advertising sets */
+extern struct k_fifo bt_mesh_adv_relay_queue;
+
 /* Lookup table for Advertising data types for bt_mesh_adv_type: */
 extern const uint8_t bt_mesh_adv_type[BT_MESH_ADV_TYPES];
 
@@ -57,6 +68,9 @@ struct net_buf *bt_mesh_adv_create_from_pool(struct net_buf_pool *pool,
 					     enum bt_mesh_adv_type type,
 					     uint8_t xmit, k_timeout_t timeout);
 
+/* Allocate a buffer from the relay pool, never blocks */
+struct net_buf *bt_mesh_adv_relay_create(uint8_t xmit);
+
 void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 		      void *cb_data);
 
@@ -72,6 +86,8 @@ int bt_mesh_adv_enable(void);
 
 void bt_mesh_adv_buf_ready(void);
 
+void bt_mesh_adv_relay_ready(void);
+
 int bt_mesh_adv_start(const struct bt_le_adv_param *param, int32_t duration,
 		      const struct bt_data *ad, size_t ad_len,
 		      const struct bt_data *sd, size_t sd_len);
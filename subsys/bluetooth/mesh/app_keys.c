@@ -208,6 +208,13 @@ static void app_key_del(struct app_key *app)
 
 	app_key_evt(app, BT_MESH_KEY_DELETED);
 
+	if (IS_ENABLED(CONFIG_BT_MESH_CRYPTO_CACHE)) {
+		bt_mesh_crypto_cache_evict(app->keys[0].val);
+		if (app->updated) {
+			bt_mesh_crypto_cache_evict(app->keys[1].val);
+		}
+	}
+
 	app->net_idx = BT_MESH_KEY_UNUSED;
 	app->app_idx = BT_MESH_KEY_UNUSED;
 	(void)memset(app->keys, 0, sizeof(app->keys));
@@ -219,6 +226,10 @@ static void app_key_revoke(struct app_key *app)
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_MESH_CRYPTO_CACHE)) {
+		bt_mesh_crypto_cache_evict(app->keys[0].val);
+	}
+
 	memcpy(&app->keys[0], &app->keys[1], sizeof(app->keys[0]));
 	memset(&app->keys[1], 0, sizeof(app->keys[1]));
 	app->updated = false;
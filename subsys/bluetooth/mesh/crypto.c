@@ -9,6 +9,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <zephyr.h>
 #include <toolchain.h>
 #include <zephyr/types.h>
 #include <sys/byteorder.h>
@@ -33,30 +34,363 @@
 #define NET_MIC_LEN(pdu) (((pdu)[1] & 0x80) ? 8 : 4)
 #define APP_MIC_LEN(aszmic) ((aszmic) ? 8 : 4)
 
-int bt_mesh_aes_cmac(const uint8_t key[16], struct bt_mesh_sg *sg,
-		     size_t sg_len, uint8_t mac[16])
-{
+enum {
+	SALT_SMK2,
+	SALT_SMK3,
+	SALT_SMK4,
+	SALT_NKIK,
+	SALT_NKBK,
+	SALT_COUNT,
+};
+
+static const char *const salt_strs[SALT_COUNT] = {
+	[SALT_SMK2] = "smk2",
+	[SALT_SMK3] = "smk3",
+	[SALT_SMK4] = "smk4",
+	[SALT_NKIK] = "nkik",
+	[SALT_NKBK] = "nkbk",
+};
+
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+/* Output of a key derivation function, identified by the salt of the
+ * function, its key and, for k2, its P parameter.
+ */
+struct derived {
+	uint8_t n[16];
+	uint8_t p[9];
+	uint8_t p_len;
+	uint8_t salt;
+	bool valid;
+	uint8_t out[33];
+	uint32_t used;
+};
+
+/* AES key schedule and CMAC subkeys of a beacon key */
+struct cmac_key {
+	uint8_t key[16];
+	bool valid;
+	uint32_t used;
 	struct tc_aes_key_sched_struct sched;
 	struct tc_cmac_struct state;
+};
 
-	if (tc_cmac_setup(&state, key, &sched) == TC_CRYPTO_FAIL) {
+static struct {
+	struct k_spinlock lock;
+	uint32_t used;
+	uint8_t salts[SALT_COUNT][16];
+	uint8_t salts_valid;
+	struct derived derived[CONFIG_BT_MESH_CRYPTO_CACHE_SIZE];
+	struct cmac_key cmac[CONFIG_BT_MESH_CRYPTO_CACHE_BEACON_KEYS];
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t cmac_hits;
+	uint32_t cmac_misses;
+} cache;
+
+/* The salts are constants, they are computed once. The salt is computed
+ * outside of the lock, and stored under the lock, as the other threads may
+ * read it at the same time.
+ */
+static int salt_get(int idx, uint8_t salt[16])
+{
+	k_spinlock_key_t key;
+	bool valid;
+	int err;
+
+	key = k_spin_lock(&cache.lock);
+	valid = cache.salts_valid & BIT(idx);
+	if (valid) {
+		memcpy(salt, cache.salts[idx], 16);
+	}
+	k_spin_unlock(&cache.lock, key);
+
+	if (valid) {
+		return 0;
+	}
+
+	err = bt_mesh_s1(salt_strs[idx], salt);
+	if (err) {
+		return err;
+	}
+
+	key = k_spin_lock(&cache.lock);
+	memcpy(cache.salts[idx], salt, 16);
+	cache.salts_valid |= BIT(idx);
+	k_spin_unlock(&cache.lock, key);
+
+	return 0;
+}
+
+static bool derived_match(const struct derived *entry, int salt,
+			  const uint8_t n[16], const uint8_t *p, size_t p_len)
+{
+	return entry->valid && entry->salt == salt && entry->p_len == p_len &&
+	       !memcmp(entry->n, n, 16) &&
+	       (!p_len || !memcmp(entry->p, p, p_len));
+}
+
+static bool derived_get(int salt, const uint8_t n[16], const uint8_t *p,
+			size_t p_len, uint8_t *out, size_t out_len)
+{
+	k_spinlock_key_t key;
+	bool found = false;
+
+	if (p_len > sizeof(cache.derived[0].p)) {
+		return false;
+	}
+
+	key = k_spin_lock(&cache.lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cache.derived); i++) {
+		struct derived *entry = &cache.derived[i];
+
+		if (derived_match(entry, salt, n, p, p_len)) {
+			entry->used = ++cache.used;
+			memcpy(out, entry->out, out_len);
+			found = true;
+			break;
+		}
+	}
+
+	if (found) {
+		cache.hits++;
+	} else {
+		cache.misses++;
+	}
+
+	k_spin_unlock(&cache.lock, key);
+
+	return found;
+}
+
+static void derived_add(int salt, const uint8_t n[16], const uint8_t *p,
+			size_t p_len, const uint8_t *out, size_t out_len)
+{
+	struct derived *entry = NULL;
+	k_spinlock_key_t key;
+
+	if (p_len > sizeof(cache.derived[0].p)) {
+		return;
+	}
+
+	key = k_spin_lock(&cache.lock);
+
+	/* Replace the least recently used entry */
+	for (int i = 0; i < ARRAY_SIZE(cache.derived); i++) {
+		if (!cache.derived[i].valid) {
+			entry = &cache.derived[i];
+			break;
+		}
+
+		if (!entry || cache.derived[i].used < entry->used) {
+			entry = &cache.derived[i];
+		}
+	}
+
+	entry->valid = true;
+	entry->salt = salt;
+	entry->p_len = p_len;
+	entry->used = ++cache.used;
+	memcpy(entry->n, n, 16);
+	memcpy(entry->out, out, out_len);
+	if (p_len) {
+		memcpy(entry->p, p, p_len);
+	}
+
+	k_spin_unlock(&cache.lock, key);
+}
+
+/* Beacon keys are used for every secure network beacon sent or received,
+ * their key schedule and CMAC subkeys are kept instead of being computed
+ * for each beacon.
+ */
+static int beacon_cmac_setup(const uint8_t beacon_key[16],
+			     struct tc_cmac_struct *state,
+			     struct tc_aes_key_sched_struct *sched)
+{
+	struct cmac_key *entry = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache.lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cache.cmac); i++) {
+		if (cache.cmac[i].valid &&
+		    !memcmp(cache.cmac[i].key, beacon_key, 16)) {
+			entry = &cache.cmac[i];
+			break;
+		}
+	}
+
+	if (entry) {
+		entry->used = ++cache.used;
+		*sched = entry->sched;
+		*state = entry->state;
+		cache.cmac_hits++;
+	} else {
+		cache.cmac_misses++;
+	}
+
+	k_spin_unlock(&cache.lock, key);
+
+	if (entry) {
+		state->sched = sched;
+		return 0;
+	}
+
+	if (tc_cmac_setup(state, beacon_key, sched) == TC_CRYPTO_FAIL) {
+		return -EIO;
+	}
+
+	key = k_spin_lock(&cache.lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cache.cmac); i++) {
+		if (!cache.cmac[i].valid) {
+			entry = &cache.cmac[i];
+			break;
+		}
+
+		if (!entry || cache.cmac[i].used < entry->used) {
+			entry = &cache.cmac[i];
+		}
+	}
+
+	entry->valid = true;
+	entry->used = ++cache.used;
+	memcpy(entry->key, beacon_key, 16);
+	entry->sched = *sched;
+	entry->state = *state;
+
+	k_spin_unlock(&cache.lock, key);
+
+	return 0;
+}
+
+void bt_mesh_crypto_cache_evict(const uint8_t key[16])
+{
+	k_spinlock_key_t lock_key;
+
+	lock_key = k_spin_lock(&cache.lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cache.derived); i++) {
+		if (cache.derived[i].valid &&
+		    !memcmp(cache.derived[i].n, key, 16)) {
+			(void)memset(&cache.derived[i], 0,
+				     sizeof(cache.derived[i]));
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cache.cmac); i++) {
+		if (cache.cmac[i].valid && !memcmp(cache.cmac[i].key, key, 16)) {
+			(void)memset(&cache.cmac[i], 0, sizeof(cache.cmac[i]));
+		}
+	}
+
+	k_spin_unlock(&cache.lock, lock_key);
+}
+
+void bt_mesh_crypto_cache_clear(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache.lock);
+
+	(void)memset(cache.derived, 0, sizeof(cache.derived));
+	(void)memset(cache.cmac, 0, sizeof(cache.cmac));
+	cache.hits = 0U;
+	cache.misses = 0U;
+	cache.cmac_hits = 0U;
+	cache.cmac_misses = 0U;
+
+	k_spin_unlock(&cache.lock, key);
+}
+
+void bt_mesh_crypto_cache_stats_get(struct bt_mesh_crypto_cache_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	(void)memset(stats, 0, sizeof(*stats));
+
+	key = k_spin_lock(&cache.lock);
+
+	for (int i = 0; i < ARRAY_SIZE(cache.derived); i++) {
+		stats->entries += cache.derived[i].valid;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cache.cmac); i++) {
+		stats->beacon_keys += cache.cmac[i].valid;
+	}
+
+	stats->hits = cache.hits;
+	stats->misses = cache.misses;
+	stats->beacon_hits = cache.cmac_hits;
+	stats->beacon_misses = cache.cmac_misses;
+
+	k_spin_unlock(&cache.lock, key);
+}
+#else
+static inline int salt_get(int idx, uint8_t salt[16])
+{
+	return bt_mesh_s1(salt_strs[idx], salt);
+}
+
+static inline bool derived_get(int salt, const uint8_t n[16],
+			       const uint8_t *p, size_t p_len, uint8_t *out,
+			       size_t out_len)
+{
+	return false;
+}
+
+static inline void derived_add(int salt, const uint8_t n[16],
+			       const uint8_t *p, size_t p_len,
+			       const uint8_t *out, size_t out_len)
+{
+}
+
+static inline int beacon_cmac_setup(const uint8_t beacon_key[16],
+				    struct tc_cmac_struct *state,
+				    struct tc_aes_key_sched_struct *sched)
+{
+	if (tc_cmac_setup(state, beacon_key, sched) == TC_CRYPTO_FAIL) {
 		return -EIO;
 	}
 
+	return 0;
+}
+#endif /* CONFIG_BT_MESH_CRYPTO_CACHE */
+
+/* Computes the MAC with a CMAC state fresh from tc_cmac_setup(). The state is
+ * erased by tc_cmac_final().
+ */
+static int cmac_sg(struct tc_cmac_struct *state, struct bt_mesh_sg *sg,
+		   size_t sg_len, uint8_t mac[16])
+{
 	for (; sg_len; sg_len--, sg++) {
-		if (tc_cmac_update(&state, sg->data,
+		if (tc_cmac_update(state, sg->data,
 				   sg->len) == TC_CRYPTO_FAIL) {
 			return -EIO;
 		}
 	}
 
-	if (tc_cmac_final(mac, &state) == TC_CRYPTO_FAIL) {
+	if (tc_cmac_final(mac, state) == TC_CRYPTO_FAIL) {
 		return -EIO;
 	}
 
 	return 0;
 }
 
+int bt_mesh_aes_cmac(const uint8_t key[16], struct bt_mesh_sg *sg,
+		     size_t sg_len, uint8_t mac[16])
+{
+	struct tc_aes_key_sched_struct sched;
+	struct tc_cmac_struct state;
+
+	if (tc_cmac_setup(&state, key, &sched) == TC_CRYPTO_FAIL) {
+		return -EIO;
+	}
+
+	return cmac_sg(&state, sg, sg_len, mac);
+}
+
 int bt_mesh_k1(const uint8_t *ikm, size_t ikm_len, const uint8_t salt[16],
 	       const char *info, uint8_t okm[16])
 {
@@ -73,9 +407,12 @@ int bt_mesh_k1(const uint8_t *ikm, size_t ikm_len, const uint8_t salt[16],
 int bt_mesh_k2(const uint8_t n[16], const uint8_t *p, size_t p_len,
 	       uint8_t net_id[1], uint8_t enc_key[16], uint8_t priv_key[16])
 {
+	struct tc_aes_key_sched_struct sched;
+	struct tc_cmac_struct t_state;
+	struct tc_cmac_struct state;
 	struct bt_mesh_sg sg[3];
 	uint8_t salt[16];
-	uint8_t out[16];
+	uint8_t out[33];
 	uint8_t t[16];
 	uint8_t pad;
 	int err;
@@ -83,7 +420,11 @@ int bt_mesh_k2(const uint8_t n[16], const uint8_t *p, size_t p_len,
 	BT_DBG("n %s", bt_hex(n, 16));
 	BT_DBG("p %s", bt_hex(p, p_len));
 
-	err = bt_mesh_s1("smk2", salt);
+	if (derived_get(SALT_SMK2, n, p, p_len, out, sizeof(out))) {
+		goto done;
+	}
+
+	err = salt_get(SALT_SMK2, salt);
 	if (err) {
 		return err;
 	}
@@ -93,6 +434,11 @@ int bt_mesh_k2(const uint8_t n[16], const uint8_t *p, size_t p_len,
 		return err;
 	}
 
+	/* The three blocks are computed with the same key T */
+	if (tc_cmac_setup(&t_state, t, &sched) == TC_CRYPTO_FAIL) {
+		return -EIO;
+	}
+
 	pad = 0x01;
 
 	sg[0].data = NULL;
@@ -102,32 +448,39 @@ int bt_mesh_k2(const uint8_t n[16], const uint8_t *p, size_t p_len,
 	sg[2].data = &pad;
 	sg[2].len  = sizeof(pad);
 
-	err = bt_mesh_aes_cmac(t, sg, ARRAY_SIZE(sg), out);
+	state = t_state;
+	err = cmac_sg(&state, sg, ARRAY_SIZE(sg), &out[17]);
 	if (err) {
 		return err;
 	}
 
-	net_id[0] = out[15] & 0x7f;
+	out[0] = out[32] & 0x7f;
 
-	sg[0].data = out;
-	sg[0].len  = sizeof(out);
+	sg[0].data = &out[17];
+	sg[0].len  = 16;
 	pad = 0x02;
 
-	err = bt_mesh_aes_cmac(t, sg, ARRAY_SIZE(sg), out);
+	state = t_state;
+	err = cmac_sg(&state, sg, ARRAY_SIZE(sg), &out[1]);
 	if (err) {
 		return err;
 	}
 
-	memcpy(enc_key, out, 16);
-
+	sg[0].data = &out[1];
 	pad = 0x03;
 
-	err = bt_mesh_aes_cmac(t, sg, ARRAY_SIZE(sg), out);
+	state = t_state;
+	err = cmac_sg(&state, sg, ARRAY_SIZE(sg), &out[17]);
 	if (err) {
 		return err;
 	}
 
-	memcpy(priv_key, out, 16);
+	derived_add(SALT_SMK2, n, p, p_len, out, sizeof(out));
+
+done:
+	net_id[0] = out[0];
+	memcpy(enc_key, &out[1], 16);
+	memcpy(priv_key, &out[17], 16);
 
 	BT_DBG("NID 0x%02x enc_key %s", net_id[0], bt_hex(enc_key, 16));
 	BT_DBG("priv_key %s", bt_hex(priv_key, 16));
@@ -142,7 +495,11 @@ int bt_mesh_k3(const uint8_t n[16], uint8_t out[8])
 	uint8_t t[16];
 	int err;
 
-	err = bt_mesh_s1("smk3", tmp);
+	if (derived_get(SALT_SMK3, n, NULL, 0, out, 8)) {
+		return 0;
+	}
+
+	err = salt_get(SALT_SMK3, tmp);
 	if (err) {
 		return err;
 	}
@@ -159,6 +516,8 @@ int bt_mesh_k3(const uint8_t n[16], uint8_t out[8])
 
 	memcpy(out, tmp + 8, 8);
 
+	derived_add(SALT_SMK3, n, NULL, 0, out, 8);
+
 	return 0;
 }
 
@@ -169,7 +528,11 @@ int bt_mesh_k4(const uint8_t n[16], uint8_t out[1])
 	uint8_t t[16];
 	int err;
 
-	err = bt_mesh_s1("smk4", tmp);
+	if (derived_get(SALT_SMK4, n, NULL, 0, out, 1)) {
+		return 0;
+	}
+
+	err = salt_get(SALT_SMK4, tmp);
 	if (err) {
 		return err;
 	}
@@ -186,6 +549,8 @@ int bt_mesh_k4(const uint8_t n[16], uint8_t out[1])
 
 	out[0] = tmp[15] & BIT_MASK(6);
 
+	derived_add(SALT_SMK4, n, NULL, 0, out, 1);
+
 	return 0;
 }
 
@@ -193,14 +558,38 @@ int bt_mesh_id128(const uint8_t n[16], const char *s, uint8_t out[16])
 {
 	const char *id128 = "id128\x01";
 	uint8_t salt[16];
-	int err;
+	int idx, err;
+
+	for (idx = SALT_NKIK; idx < SALT_COUNT; idx++) {
+		if (!strcmp(s, salt_strs[idx])) {
+			break;
+		}
+	}
+
+	if (idx == SALT_COUNT) {
+		err = bt_mesh_s1(s, salt);
+		if (err) {
+			return err;
+		}
+
+		return bt_mesh_k1(n, 16, salt, id128, out);
+	}
+
+	if (derived_get(idx, n, NULL, 0, out, 16)) {
+		return 0;
+	}
 
-	err = bt_mesh_s1(s, salt);
+	err = salt_get(idx, salt);
 	if (err) {
 		return err;
 	}
 
-	return bt_mesh_k1(n, 16, salt, id128, out);
+	err = bt_mesh_k1(n, 16, salt, id128, out);
+	if (!err) {
+		derived_add(idx, n, NULL, 0, out, 16);
+	}
+
+	return err;
 }
 
 static void create_proxy_nonce(uint8_t nonce[13], const uint8_t *pdu,
@@ -534,7 +923,10 @@ int bt_mesh_beacon_auth(const uint8_t beacon_key[16], uint8_t flags,
 			const uint8_t net_id[8], uint32_t iv_index,
 			uint8_t auth[8])
 {
+	struct tc_aes_key_sched_struct sched;
+	struct tc_cmac_struct state;
 	uint8_t msg[13], tmp[16];
+	struct bt_mesh_sg sg = { msg, sizeof(msg) };
 	int err;
 
 	BT_DBG("BeaconKey %s", bt_hex(beacon_key, 16));
@@ -547,7 +939,12 @@ int bt_mesh_beacon_auth(const uint8_t beacon_key[16], uint8_t flags,
 
 	BT_DBG("BeaconMsg %s", bt_hex(msg, sizeof(msg)));
 
-	err = bt_mesh_aes_cmac_one(beacon_key, msg, sizeof(msg), tmp);
+	err = beacon_cmac_setup(beacon_key, &state, &sched);
+	if (err) {
+		return err;
+	}
+
+	err = cmac_sg(&state, &sg, 1, tmp);
 	if (!err) {
 		memcpy(auth, tmp, 8);
 	}
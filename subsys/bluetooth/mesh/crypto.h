@@ -165,3 +165,20 @@ int bt_mesh_prov_decrypt(const uint8_t key[16], uint8_t nonce[13],
 
 int bt_mesh_prov_encrypt(const uint8_t key[16], uint8_t nonce[13],
 			 const uint8_t data[25], uint8_t out[25 + 8]);
+
+/* Key derivation cache statistics */
+struct bt_mesh_crypto_cache_stats {
+	uint32_t hits;          /* k2, k3, k4 and id128 outputs found */
+	uint32_t misses;        /* k2, k3, k4 and id128 outputs computed */
+	uint32_t beacon_hits;   /* Beacon key CMAC contexts found */
+	uint32_t beacon_misses; /* Beacon key CMAC contexts computed */
+	uint16_t entries;       /* Cached derivation outputs */
+	uint16_t beacon_keys;   /* Cached beacon key CMAC contexts */
+};
+
+/* Drop the cached material derived from or set up for the given key */
+void bt_mesh_crypto_cache_evict(const uint8_t key[16]);
+
+void bt_mesh_crypto_cache_clear(void);
+
+void bt_mesh_crypto_cache_stats_get(struct bt_mesh_crypto_cache_stats *stats);
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/types.h>
+
+#include "hash_index.h"
+
+static inline uint32_t hash_home(const struct bt_mesh_hash_index *index,
+				 uint32_t key)
+{
+	/* Multiplicative hashing, the well mixed high bits select the slot */
+	return ((uint64_t)(key * 2654435761U) * index->size) >> 32;
+}
+
+static inline uint32_t hash_next(const struct bt_mesh_hash_index *index,
+				 uint32_t slot)
+{
+	return (slot + 1 == index->size) ? 0 : slot + 1;
+}
+
+/* Slot of a key, or the free slot ending its probe sequence */
+static uint32_t hash_slot(const struct bt_mesh_hash_index *index,
+			  uint32_t key)
+{
+	uint32_t slot = hash_home(index, key);
+
+	while (index->slots[slot].entry && index->slots[slot].key != key) {
+		slot = hash_next(index, slot);
+	}
+
+	return slot;
+}
+
+int bt_mesh_hash_index_find(const struct bt_mesh_hash_index *index,
+			    uint32_t key)
+{
+	uint32_t slot = hash_slot(index, key);
+
+	if (!index->slots[slot].entry) {
+		return -ENOENT;
+	}
+
+	return index->slots[slot].entry - 1;
+}
+
+void bt_mesh_hash_index_add(struct bt_mesh_hash_index *index, uint32_t key,
+			    uint16_t entry)
+{
+	uint32_t slot = hash_slot(index, key);
+
+	index->slots[slot].key = key;
+	index->slots[slot].entry = entry + 1;
+}
+
+void bt_mesh_hash_index_del(struct bt_mesh_hash_index *index, uint32_t key,
+			    uint16_t entry)
+{
+	uint32_t slot = hash_slot(index, key);
+	uint32_t next, home;
+
+	if (index->slots[slot].entry != entry + 1) {
+		return;
+	}
+
+	/* Shift back the following slots of the cluster which would not be
+	 * reachable from their home slot anymore, instead of leaving a
+	 * tombstone.
+	 */
+	for (next = hash_next(index, slot); index->slots[next].entry;
+	     next = hash_next(index, next)) {
+		home = hash_home(index, index->slots[next].key);
+
+		/* Keep the slot if its home is cyclically in (slot, next] */
+		if ((slot < next) ? (home > slot && home <= next) :
+				    (home > slot || home <= next)) {
+			continue;
+		}
+
+		index->slots[slot] = index->slots[next];
+		slot = next;
+	}
+
+	index->slots[slot].entry = 0U;
+}
+
+void bt_mesh_hash_index_clear(struct bt_mesh_hash_index *index)
+{
+	(void)memset(index->slots, 0, index->size * sizeof(index->slots[0]));
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Open addressing index of the entries of a table, by 32-bit key. The index
+ * has twice as many slots as the table has entries, so that probe sequences
+ * stay short and always end on a free slot.
+ */
+
+struct bt_mesh_hash_slot {
+	uint32_t key;
+	/* Table entry + 1, 0 for free slots */
+	uint32_t entry;
+};
+
+struct bt_mesh_hash_index {
+	struct bt_mesh_hash_slot *slots;
+	uint32_t size;
+};
+
+#define BT_MESH_HASH_INDEX_DEFINE(_name, _entries)                            \
+	static struct bt_mesh_hash_slot _name##_slots[2 * (_entries)];         \
+	static struct bt_mesh_hash_index _name = {                             \
+		.slots = _name##_slots,                                        \
+		.size = 2 * (_entries),                                        \
+	}
+
+/* Get the table entry of a key, or -ENOENT if the key isn't indexed */
+int bt_mesh_hash_index_find(const struct bt_mesh_hash_index *index,
+			    uint32_t key);
+
+/* Index a table entry, replacing the entry of the same key if any */
+void bt_mesh_hash_index_add(struct bt_mesh_hash_index *index, uint32_t key,
+			    uint16_t entry);
+
+/* Remove a table entry from the index, if the key is indexed to it */
+void bt_mesh_hash_index_del(struct bt_mesh_hash_index *index, uint32_t key,
+			    uint16_t entry);
+
+void bt_mesh_hash_index_clear(struct bt_mesh_hash_index *index);
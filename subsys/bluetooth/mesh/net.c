@@ -38,6 +38,7 @@
 #include "settings.h"
 #include "prov.h"
 #include "cfg.h"
+#include "hash_index.h"
 
 #define LOOPBACK_MAX_PDU_LEN (BT_MESH_NET_HDR_LEN + 16)
 #define LOOPBACK_USER_DATA_SIZE sizeof(struct bt_mesh_subnet *)
@@ -79,11 +80,15 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-	      seq : 17;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+/* Message cache entries pack the source (MSb always 0) with the 17 LSbs of
+ * the sequence number.
+ */
+#define MSG_CACHE_KEY(src, seq) (((uint32_t)(src) << 17) | \
+				 ((seq) & BIT_MASK(17)))
+
+static uint32_t msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
+BT_MESH_HASH_INDEX_DEFINE(msg_cache_index, CONFIG_BT_MESH_MSG_CACHE_SIZE);
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -95,22 +100,27 @@ NET_BUF_POOL_DEFINE(loopback_buf_pool, CONFIG_BT_MESH_LOOPBACK_BUFS,
 
 static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static int   dup_cache_next;
+BT_MESH_HASH_INDEX_DEFINE(dup_cache_index, CONFIG_BT_MESH_MSG_CACHE_SIZE);
 
 static bool check_dup(struct net_buf_simple *data)
 {
 	const uint8_t *tail = net_buf_simple_tail(data);
 	uint32_t val;
-	int i;
 
 	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
 
-	for (i = 0; i < ARRAY_SIZE(dup_cache); i++) {
-		if (dup_cache[i] == val) {
-			return true;
-		}
+	if (bt_mesh_hash_index_find(&dup_cache_index, val) >= 0) {
+		return true;
 	}
 
-	dup_cache[dup_cache_next++] = val;
+	/* Evict the oldest value */
+	bt_mesh_hash_index_del(&dup_cache_index, dup_cache[dup_cache_next],
+			       dup_cache_next);
+
+	dup_cache[dup_cache_next] = val;
+	bt_mesh_hash_index_add(&dup_cache_index, val, dup_cache_next);
+
+	dup_cache_next++;
 	dup_cache_next %= ARRAY_SIZE(dup_cache);
 
 	return false;
@@ -118,26 +128,32 @@ static bool check_dup(struct net_buf_simple *data)
 
 static bool msg_cache_match(struct net_buf_simple *pdu)
 {
-	uint16_t i;
-
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
-	}
-
-	return false;
+	return bt_mesh_hash_index_find(&msg_cache_index,
+				       MSG_CACHE_KEY(SRC(pdu->data),
+						     SEQ(pdu->data))) >= 0;
 }
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
 	rx->msg_cache_idx = msg_cache_next++;
-	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
-	msg_cache[rx->msg_cache_idx].seq = rx->seq;
+
+	/* Evict the oldest message */
+	bt_mesh_hash_index_del(&msg_cache_index, msg_cache[rx->msg_cache_idx],
+			       rx->msg_cache_idx);
+
+	msg_cache[rx->msg_cache_idx] = MSG_CACHE_KEY(rx->ctx.addr, rx->seq);
+	bt_mesh_hash_index_add(&msg_cache_index, msg_cache[rx->msg_cache_idx],
+			       rx->msg_cache_idx);
+
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
 }
 
+static void msg_cache_del(uint16_t idx)
+{
+	bt_mesh_hash_index_del(&msg_cache_index, msg_cache[idx], idx);
+	msg_cache[idx] = MSG_CACHE_KEY(BT_MESH_ADDR_UNASSIGNED, 0);
+}
+
 static void store_iv(bool only_duration)
 {
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_IV_PENDING);
@@ -179,6 +195,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 	}
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	bt_mesh_hash_index_clear(&msg_cache_index);
 	msg_cache_next = 0U;
 
 	bt_mesh.iv_index = iv_index;
@@ -634,36 +651,128 @@ static bool relay_to_adv(enum bt_mesh_net_if net_if)
 	}
 }
 
-static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
-			      struct bt_mesh_net_rx *rx)
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+/* Relayed packets are queued in their decrypted form, and encrypted with the
+ * current keys of their subnet when an advertising buffer of the relay pool
+ * is available.
+ */
+BUILD_ASSERT(BT_MESH_RELAY_PDU_MAX_LEN == BT_MESH_NET_MAX_PDU_LEN);
+
+BT_MESH_RELAY_QUEUE_DEFINE(relay_queue, CONFIG_BT_MESH_RELAY_QUEUE_SIZE);
+static struct k_work relay_work;
+
+static void relay_enqueue(struct net_buf_simple *sbuf,
+			  struct bt_mesh_net_rx *rx, uint8_t transmit,
+			  bool to_proxy, bool to_adv)
+{
+	struct bt_mesh_relay_pdu pdu = {
+		.iv_index = BT_MESH_NET_IVI_RX(rx),
+		.net_idx = rx->sub->net_idx,
+		.dst = rx->ctx.recv_dst,
+		.transmit = transmit,
+		.friend_cred = rx->friend_cred,
+		.to_proxy = to_proxy,
+		.to_adv = to_adv,
+		.len = sbuf->len,
+	};
+	int err;
+
+	memcpy(pdu.data, sbuf->data, sbuf->len);
+
+	err = bt_mesh_relay_queue_add(&relay_queue, &pdu);
+	if (err == -ENOMEM) {
+		BT_WARN("Relay queue full");
+	}
+
+	if (!err) {
+		k_work_submit(&relay_work);
+	}
+}
+
+static bool relay_send(const struct bt_mesh_relay_pdu *pdu,
+		       struct net_buf *buf)
 {
 	const struct bt_mesh_net_cred *cred;
-	struct net_buf *buf;
-	uint8_t transmit;
+	struct bt_mesh_subnet *sub;
 
-	if (rx->ctx.recv_ttl <= 1U) {
-		return;
+	/* The subnet may have been deleted while the packet was queued */
+	sub = bt_mesh_subnet_get(pdu->net_idx);
+	if (!sub) {
+		return false;
 	}
 
-	if (rx->net_if == BT_MESH_NET_IF_ADV &&
-	    !rx->friend_cred &&
-	    bt_mesh_relay_get() != BT_MESH_RELAY_ENABLED &&
-	    bt_mesh_gatt_proxy_get() != BT_MESH_GATT_PROXY_ENABLED) {
-		return;
+	cred = &sub->keys[SUBNET_KEY_TX_IDX(sub)].msg;
+
+	net_buf_add_mem(buf, pdu->data, pdu->len);
+
+	if (pdu->friend_cred) {
+		buf->data[0] &= 0x80; /* Clear everything except IVI */
+		buf->data[0] |= cred->nid;
 	}
 
-	BT_DBG("TTL %u CTL %u dst 0x%04x", rx->ctx.recv_ttl, rx->ctl,
-	       rx->ctx.recv_dst);
+	if (net_encrypt(&buf->b, cred, pdu->iv_index, false)) {
+		BT_ERR("Re-encrypting failed");
+		return false;
+	}
 
-	/* The Relay Retransmit state is only applied to adv-adv relaying.
-	 * Anything else (like GATT to adv, or locally originated packets)
-	 * use the Network Transmit state.
+	if (pdu->to_proxy) {
+		bt_mesh_proxy_relay(buf, pdu->dst);
+	}
+
+	if (pdu->to_adv) {
+		bt_mesh_adv_send(buf, NULL, NULL);
+	}
+
+	return true;
+}
+
+static void relay_work_handler(struct k_work *work)
+{
+	const struct bt_mesh_relay_pdu *pdu;
+	struct net_buf *buf;
+	bool relayed;
+
+	/* Only this handler removes packets, so the head of the queue stays
+	 * valid until it is removed.
 	 */
-	if (rx->net_if == BT_MESH_NET_IF_ADV && !rx->friend_cred) {
-		transmit = bt_mesh_relay_retransmit_get();
-	} else {
-		transmit = bt_mesh_net_transmit_get();
+	while ((pdu = bt_mesh_relay_queue_peek(&relay_queue))) {
+		/* Resubmitted by bt_mesh_net_relay_resume() when a buffer of
+		 * the relay pool is freed.
+		 */
+		buf = bt_mesh_adv_relay_create(pdu->transmit);
+		if (!buf) {
+			return;
+		}
+
+		relayed = relay_send(pdu, buf);
+		net_buf_unref(buf);
+
+		bt_mesh_relay_queue_remove(&relay_queue, relayed);
 	}
+}
+
+void bt_mesh_net_relay_resume(void)
+{
+	k_work_submit(&relay_work);
+}
+
+void bt_mesh_relay_stats_get(struct bt_mesh_relay_stats *stats)
+{
+	bt_mesh_relay_queue_stats_get(&relay_queue, stats);
+}
+
+void bt_mesh_relay_stats_reset(void)
+{
+	bt_mesh_relay_queue_stats_reset(&relay_queue);
+}
+#endif /* CONFIG_BT_MESH_RELAY_QUEUE */
+
+#if !defined(CONFIG_BT_MESH_RELAY_QUEUE)
+static void relay_now(struct net_buf_simple *sbuf, struct bt_mesh_net_rx *rx,
+		      uint8_t transmit, bool to_proxy, bool to_adv)
+{
+	const struct bt_mesh_net_cred *cred;
+	struct net_buf *buf;
 
 	buf = bt_mesh_adv_create(BT_MESH_ADV_DATA, transmit, K_NO_WAIT);
 	if (!buf) {
@@ -671,10 +780,6 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		return;
 	}
 
-	/* Leave CTL bit intact */
-	sbuf->data[1] &= 0x80;
-	sbuf->data[1] |= rx->ctx.recv_ttl - 1U;
-
 	net_buf_add_mem(buf, sbuf->data, sbuf->len);
 
 	cred = &rx->sub->keys[SUBNET_KEY_TX_IDX(rx->sub)].msg;
@@ -696,23 +801,72 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		goto done;
 	}
 
-	/* When the Friend node relays message for lpn, the message will be
-	 * retransmitted using the managed master security credentials and
-	 * the Network PDU shall be retransmitted to all network interfaces.
-	 */
-	if (IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY) &&
-	    (rx->friend_cred ||
-	     bt_mesh_gatt_proxy_get() == BT_MESH_GATT_PROXY_ENABLED)) {
+	if (to_proxy) {
 		bt_mesh_proxy_relay(buf, rx->ctx.recv_dst);
 	}
 
-	if (relay_to_adv(rx->net_if) || rx->friend_cred) {
+	if (to_adv) {
 		bt_mesh_adv_send(buf, NULL, NULL);
 	}
 
 done:
 	net_buf_unref(buf);
 }
+#endif /* !CONFIG_BT_MESH_RELAY_QUEUE */
+
+static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
+			      struct bt_mesh_net_rx *rx)
+{
+	uint8_t transmit;
+	bool to_proxy, to_adv;
+
+	if (rx->ctx.recv_ttl <= 1U) {
+		return;
+	}
+
+	if (rx->net_if == BT_MESH_NET_IF_ADV &&
+	    !rx->friend_cred &&
+	    bt_mesh_relay_get() != BT_MESH_RELAY_ENABLED &&
+	    bt_mesh_gatt_proxy_get() != BT_MESH_GATT_PROXY_ENABLED) {
+		return;
+	}
+
+	BT_DBG("TTL %u CTL %u dst 0x%04x", rx->ctx.recv_ttl, rx->ctl,
+	       rx->ctx.recv_dst);
+
+	/* The Relay Retransmit state is only applied to adv-adv relaying.
+	 * Anything else (like GATT to adv, or locally originated packets)
+	 * use the Network Transmit state.
+	 */
+	if (rx->net_if == BT_MESH_NET_IF_ADV && !rx->friend_cred) {
+		transmit = bt_mesh_relay_retransmit_get();
+	} else {
+		transmit = bt_mesh_net_transmit_get();
+	}
+
+	/* When the Friend node relays message for lpn, the message will be
+	 * retransmitted using the managed master security credentials and
+	 * the Network PDU shall be retransmitted to all network interfaces.
+	 */
+	to_proxy = (IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY) &&
+		    (rx->friend_cred ||
+		     bt_mesh_gatt_proxy_get() == BT_MESH_GATT_PROXY_ENABLED));
+	to_adv = (relay_to_adv(rx->net_if) || rx->friend_cred);
+
+	if (!to_proxy && !to_adv) {
+		return;
+	}
+
+	/* Leave CTL bit intact */
+	sbuf->data[1] &= 0x80;
+	sbuf->data[1] |= rx->ctx.recv_ttl - 1U;
+
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+	relay_enqueue(sbuf, rx, transmit, to_proxy, to_adv);
+#else
+	relay_now(sbuf, rx, transmit, to_proxy, to_adv);
+#endif
+}
 
 void bt_mesh_net_header_parse(struct net_buf_simple *buf,
 			      struct bt_mesh_net_rx *rx)
@@ -828,7 +982,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
+		msg_cache_del(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
@@ -879,6 +1033,10 @@ void bt_mesh_net_init(void)
 	k_work_init_delayable(&bt_mesh.ivu_timer, ivu_refresh);
 
 	k_work_init(&bt_mesh.local_work, bt_mesh_net_local);
+
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+	k_work_init(&relay_work, relay_work_handler);
+#endif
 }
 
 static int net_set(const char *name, size_t len_rd, settings_read_cb read_cb,
@@ -7,6 +7,7 @@
  */
 
 #include "subnet.h"
+#include "relay_queue.h"
 
 #define BT_MESH_IV_UPDATE(flags)   ((flags >> 1) & 0x01)
 #define BT_MESH_KEY_REFRESH(flags) (flags & 0x01)
@@ -280,6 +281,12 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 
 void bt_mesh_net_loopback_clear(uint16_t net_idx);
 
+/* Resume relaying once a relay advertising buffer has been freed */
+void bt_mesh_net_relay_resume(void);
+
+void bt_mesh_relay_stats_get(struct bt_mesh_relay_stats *stats);
+void bt_mesh_relay_stats_reset(void);
+
 uint32_t bt_mesh_next_seq(void);
 
 void bt_mesh_net_init(void);
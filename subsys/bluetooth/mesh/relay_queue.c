@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <string.h>
+
+#include "relay_queue.h"
+
+static struct bt_mesh_relay_pdu *pdu_get(struct bt_mesh_relay_queue *queue,
+					 uint8_t i)
+{
+	return &queue->pdus[(queue->head + i) % queue->size];
+}
+
+static bool queued(struct bt_mesh_relay_queue *queue,
+		   const struct bt_mesh_relay_pdu *pdu)
+{
+	for (uint8_t i = 0; i < queue->count; i++) {
+		/* SEQ and SRC identify the packet */
+		if (!memcmp(&pdu_get(queue, i)->data[2], &pdu->data[2], 5)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int bt_mesh_relay_queue_add(struct bt_mesh_relay_queue *queue,
+			    const struct bt_mesh_relay_pdu *pdu)
+{
+	k_spinlock_key_t key;
+	int err = 0;
+
+	key = k_spin_lock(&queue->lock);
+
+	if (queued(queue, pdu)) {
+		queue->stats.dropped_dup++;
+		err = -EALREADY;
+	} else if (queue->count == queue->size) {
+		queue->stats.dropped_full++;
+		err = -ENOMEM;
+	} else {
+		*pdu_get(queue, queue->count) = *pdu;
+		queue->count++;
+		queue->stats.queued++;
+		queue->stats.max_depth = MAX(queue->stats.max_depth,
+					     queue->count);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	return err;
+}
+
+const struct bt_mesh_relay_pdu *
+bt_mesh_relay_queue_peek(struct bt_mesh_relay_queue *queue)
+{
+	const struct bt_mesh_relay_pdu *pdu = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&queue->lock);
+
+	if (queue->count) {
+		pdu = pdu_get(queue, 0);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	return pdu;
+}
+
+void bt_mesh_relay_queue_remove(struct bt_mesh_relay_queue *queue,
+				bool relayed)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&queue->lock);
+
+	if (queue->count) {
+		queue->head = (queue->head + 1) % queue->size;
+		queue->count--;
+
+		if (relayed) {
+			queue->stats.relayed++;
+		}
+	}
+
+	k_spin_unlock(&queue->lock, key);
+}
+
+void bt_mesh_relay_queue_stats_get(struct bt_mesh_relay_queue *queue,
+				   struct bt_mesh_relay_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&queue->lock);
+	*stats = queue->stats;
+	stats->depth = queue->count;
+	k_spin_unlock(&queue->lock, key);
+}
+
+void bt_mesh_relay_queue_stats_reset(struct bt_mesh_relay_queue *queue)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&queue->lock);
+	(void)memset(&queue->stats, 0, sizeof(queue->stats));
+	k_spin_unlock(&queue->lock, key);
+}
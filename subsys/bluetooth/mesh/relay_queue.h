@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Queue of the packets waiting to be relayed, in their decrypted form. The
+ * packets are encrypted with the current keys of their subnet when they are
+ * removed from the queue. A packet already in the queue, identified by its
+ * SRC and SEQ, is not queued again.
+ */
+
+/* Largest network PDU, BT_MESH_NET_MAX_PDU_LEN */
+#define BT_MESH_RELAY_PDU_MAX_LEN 29
+
+struct bt_mesh_relay_pdu {
+	uint32_t iv_index;
+	uint16_t net_idx;
+	uint16_t dst;
+	uint8_t  transmit;
+	uint8_t  friend_cred:1,
+		 to_proxy:1,
+		 to_adv:1;
+	uint8_t  len;
+	uint8_t  data[BT_MESH_RELAY_PDU_MAX_LEN];
+};
+
+/* Relay queue statistics */
+struct bt_mesh_relay_stats {
+	uint32_t queued;       /* Packets added to the relay queue */
+	uint32_t relayed;      /* Packets encrypted and sent */
+	uint32_t dropped_dup;  /* Packets dropped, already in the queue */
+	uint32_t dropped_full; /* Packets dropped, the queue was full */
+	uint16_t depth;        /* Packets currently in the queue */
+	uint16_t max_depth;    /* Highest number of packets in the queue */
+};
+
+struct bt_mesh_relay_queue {
+	struct bt_mesh_relay_pdu *pdus;
+	uint8_t size;
+	uint8_t head;
+	uint8_t count;
+	struct k_spinlock lock;
+	struct bt_mesh_relay_stats stats;
+};
+
+#define BT_MESH_RELAY_QUEUE_DEFINE(_name, _size)                              \
+	static struct bt_mesh_relay_pdu _name##_pdus[_size];                   \
+	static struct bt_mesh_relay_queue _name = {                            \
+		.pdus = _name##_pdus,                                          \
+		.size = (_size),                                               \
+	}
+
+/* Add a packet at the tail of the queue. Returns -EALREADY if the packet is
+ * already queued, or -ENOMEM if the queue is full.
+ */
+int bt_mesh_relay_queue_add(struct bt_mesh_relay_queue *queue,
+			    const struct bt_mesh_relay_pdu *pdu);
+
+/* Get the packet at the head of the queue, or NULL if the queue is empty.
+ * Packets are only removed by the caller, so the packet stays valid until
+ * the caller removes it.
+ */
+const struct bt_mesh_relay_pdu *
+bt_mesh_relay_queue_peek(struct bt_mesh_relay_queue *queue);
+
+/* Remove the packet at the head of the queue, counting it if it was sent */
+void bt_mesh_relay_queue_remove(struct bt_mesh_relay_queue *queue,
+				bool relayed);
+
+void bt_mesh_relay_queue_stats_get(struct bt_mesh_relay_queue *queue,
+				   struct bt_mesh_relay_stats *stats);
+
+void bt_mesh_relay_queue_stats_reset(struct bt_mesh_relay_queue *queue);
@@ -30,6 +30,7 @@
 #include "net.h"
 #include "rpl.h"
 #include "settings.h"
+#include "hash_index.h"
 
 /* Replay Protection List information for persistent storage. */
 struct rpl_val {
@@ -40,11 +41,46 @@ struct rpl_val {
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 
+/* Entries of the replay list by source address */
+BT_MESH_HASH_INDEX_DEFINE(rpl_index, CONFIG_BT_MESH_CRPL);
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	int idx = bt_mesh_hash_index_find(&rpl_index, src);
+
+	return (idx < 0) ? NULL : &replay_list[idx];
+}
+
+static struct bt_mesh_rpl *rpl_free_find(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void rpl_src_set(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+	rpl->src = src;
+	bt_mesh_hash_index_add(&rpl_index, src, rpl_idx(rpl));
+}
+
+static void rpl_free(struct bt_mesh_rpl *rpl)
+{
+	bt_mesh_hash_index_del(&rpl_index, rpl->src, rpl_idx(rpl));
+	(void)memset(rpl, 0, sizeof(*rpl));
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -62,7 +98,7 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 		BT_DBG("Cleared RPL");
 	}
 
-	(void)memset(rpl, 0, sizeof(*rpl));
+	rpl_free(rpl);
 	atomic_clear_bit(store, rpl_idx(rpl));
 }
 
@@ -94,7 +130,12 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	/* Slot newly allocated by bt_mesh_rpl_check */
+	if (rpl->src != rx->ctx.addr) {
+		bt_mesh_hash_index_del(&rpl_index, rpl->src, rpl_idx(rpl));
+		rpl_src_set(rpl, rx->ctx.addr);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -111,7 +152,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -123,11 +164,15 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	/* Existing slot for given address */
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -135,27 +180,21 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
-
-				return false;
-			} else {
-				return true;
-			}
+	/* Empty slot */
+	rpl = rpl_free_find();
+	if (rpl) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
 	BT_ERR("RPL is full!");
@@ -170,34 +209,19 @@ void bt_mesh_rpl_clear(void)
 		schedule_rpl_clear();
 	} else {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		bt_mesh_hash_index_clear(&rpl_index);
 	}
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl = rpl_free_find();
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	if (rpl) {
+		rpl_src_set(rpl, src);
 	}
 
-	return NULL;
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -215,7 +239,7 @@ void bt_mesh_rpl_reset(void)
 				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 					clear_rpl(rpl);
 				} else {
-					(void)memset(rpl, 0, sizeof(*rpl));
+					rpl_free(rpl);
 				}
 			} else {
 				rpl->old_iv = true;
@@ -247,7 +271,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
-			(void)memset(entry, 0, sizeof(*entry));
+			rpl_free(entry);
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -329,20 +353,27 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 		bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (addr != BT_MESH_ADDR_ALL_NODES &&
-		    addr != replay_list[i].src) {
-			continue;
+	if (addr != BT_MESH_ADDR_ALL_NODES) {
+		struct bt_mesh_rpl *rpl = bt_mesh_rpl_find(addr);
+
+		if (!rpl) {
+			return;
 		}
 
 		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
-			store_pending_rpl(&replay_list[i]);
+			store_pending_rpl(rpl);
 		} else {
-			clear_rpl(&replay_list[i]);
+			clear_rpl(rpl);
 		}
 
-		if (addr != BT_MESH_ADDR_ALL_NODES) {
-			break;
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+			store_pending_rpl(&replay_list[i]);
+		} else {
+			clear_rpl(&replay_list[i]);
 		}
 	}
 }
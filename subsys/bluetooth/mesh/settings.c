@@ -128,6 +128,14 @@ void bt_mesh_settings_store_cancel(enum bt_mesh_settings_flag flag)
 
 static void store_pending(struct k_work *work)
 {
+	/* The stored items are independent, so an atomic commit which fails
+	 * when they do not all fit in the staging buffer is not used.
+	 */
+	bool txn = IS_ENABLED(CONFIG_SETTINGS_TXN) &&
+		   !IS_ENABLED(CONFIG_SETTINGS_TXN_ATOMIC) &&
+		   !settings_txn_begin();
+	int err;
+
 	BT_DBG("");
 
 	if (atomic_test_and_clear_bit(pending_flags,
@@ -185,6 +193,14 @@ static void store_pending(struct k_work *work)
 				      BT_MESH_SETTINGS_CDB_PENDING)) {
 		bt_mesh_cdb_pending_store();
 	}
+
+	if (txn) {
+		err = settings_txn_commit();
+		if (err) {
+			BT_ERR("Failed to commit pending settings (err %d)",
+			       err);
+		}
+	}
 }
 
 void bt_mesh_settings_init(void)
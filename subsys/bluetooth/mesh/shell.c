@@ -28,6 +28,7 @@
 #include "transport.h"
 #include "foundation.h"
 #include "settings.h"
+#include "crypto.h"
 
 #define CID_NVAL   0xffff
 
@@ -769,6 +770,50 @@ static int cmd_rpl_clear(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+static int cmd_relay_stats(const struct shell *shell, size_t argc,
+			   char *argv[])
+{
+	struct bt_mesh_relay_stats stats;
+
+	bt_mesh_relay_stats_get(&stats);
+
+	shell_print(shell, "Relay queue depth %u (max %u)", stats.depth,
+		    stats.max_depth);
+	shell_print(shell, "Queued %u, relayed %u", stats.queued,
+		    stats.relayed);
+	shell_print(shell, "Dropped: queue full %u, duplicate %u",
+		    stats.dropped_full, stats.dropped_dup);
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		bt_mesh_relay_stats_reset();
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+static int cmd_crypto_cache(const struct shell *shell, size_t argc,
+			    char *argv[])
+{
+	struct bt_mesh_crypto_cache_stats stats;
+
+	bt_mesh_crypto_cache_stats_get(&stats);
+
+	shell_print(shell, "Derived keys: %u entries, %u hits, %u misses",
+		    stats.entries, stats.hits, stats.misses);
+	shell_print(shell, "Beacon keys: %u entries, %u hits, %u misses",
+		    stats.beacon_keys, stats.beacon_hits, stats.beacon_misses);
+
+	if (argc > 1 && !strcmp(argv[1], "clear")) {
+		bt_mesh_crypto_cache_clear();
+	}
+
+	return 0;
+}
+#endif
+
 static int cmd_beacon(const struct shell *shell, size_t argc, char *argv[])
 {
 	uint8_t status;
@@ -2673,6 +2718,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(mesh_cmds,
 		      cmd_iv_update_test, 2, 0),
 #endif
 	SHELL_CMD_ARG(rpl-clear, NULL, NULL, cmd_rpl_clear, 1, 0),
+#if defined(CONFIG_BT_MESH_RELAY_QUEUE)
+	SHELL_CMD_ARG(relay-stats, NULL, "[reset]", cmd_relay_stats, 1, 1),
+#endif
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+	SHELL_CMD_ARG(crypto-cache, NULL, "[clear]", cmd_crypto_cache, 1, 1),
+#endif
 
 	/* Provisioning operations */
 #if defined(CONFIG_BT_MESH_PB_GATT)
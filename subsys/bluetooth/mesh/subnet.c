@@ -193,6 +193,19 @@ void bt_mesh_subnet_store(uint16_t net_idx)
 	update_subnet_settings(net_idx, true);
 }
 
+static void keys_evict(struct bt_mesh_subnet_keys *keys)
+{
+	if (!IS_ENABLED(CONFIG_BT_MESH_CRYPTO_CACHE) || !keys->valid) {
+		return;
+	}
+
+	/* The network credentials, friendship credentials and NetID are
+	 * derived from the NetKey.
+	 */
+	bt_mesh_crypto_cache_evict(keys->net);
+	bt_mesh_crypto_cache_evict(keys->beacon);
+}
+
 static void key_refresh(struct bt_mesh_subnet *sub, uint8_t new_phase)
 {
 	BT_DBG("Phase 0x%02x -> 0x%02x", sub->kr_phase, new_phase);
@@ -216,6 +229,7 @@ static void key_refresh(struct bt_mesh_subnet *sub, uint8_t new_phase)
 		__fallthrough;
 	case BT_MESH_KR_NORMAL:
 		sub->kr_phase = BT_MESH_KR_NORMAL;
+		keys_evict(&sub->keys[0]);
 		memcpy(&sub->keys[0], &sub->keys[1], sizeof(sub->keys[0]));
 		sub->keys[1].valid = 0U;
 		subnet_evt(sub, BT_MESH_KEY_REVOKED);
@@ -272,6 +286,11 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 	bt_mesh_net_loopback_clear(sub->net_idx);
 
 	subnet_evt(sub, BT_MESH_KEY_DELETED);
+
+	for (int i = 0; i < ARRAY_SIZE(sub->keys); i++) {
+		keys_evict(&sub->keys[i]);
+	}
+
 	(void)memset(sub, 0, sizeof(*sub));
 	sub->net_idx = BT_MESH_KEY_UNUSED;
 }
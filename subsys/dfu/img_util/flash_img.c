@@ -79,9 +79,19 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	/* The image keeps being received while the previous blocks are
+	 * written.
+	 */
+	return stream_flash_init_pipelined(&ctx->stream, flash_dev, ctx->buf,
+			CONFIG_IMG_BLOCK_BUF_SIZE, FLASH_IMG_BUF_CNT,
+			ctx->flash_area->fa_off, ctx->flash_area->fa_size,
+			NULL);
+#else
 	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+#endif
 }
 
 int flash_img_init(struct flash_img_context *ctx)
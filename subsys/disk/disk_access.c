@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -23,6 +25,16 @@ static sys_dlist_t disk_access_list;
 /* lock to protect storage layer registration */
 static struct k_mutex mutex;
 
+/* The sectors of a cached disk have to go through the cache */
+static inline bool disk_cached(const struct disk_info *disk)
+{
+#ifdef CONFIG_DISK_CACHE
+	return disk->cache_erase_sectors != 0U;
+#else
+	return false;
+#endif
+}
+
 struct disk_info *disk_access_get_di(const char *name)
 {
 	struct disk_info *disk = NULL, *itr;
@@ -61,6 +73,11 @@ int disk_access_init(const char *pdrv)
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
 		rc = disk->ops->init(disk);
+#ifdef CONFIG_DISK_CACHE
+		if (rc == 0) {
+			disk_cache_attach(disk);
+		}
+#endif
 	}
 
 	return rc;
@@ -87,7 +104,11 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +122,77 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
+	}
+
+	return rc;
+}
+
+int disk_access_readv(const char *pdrv, const struct disk_iovec *iov,
+		      size_t iovcnt, uint32_t start_sector)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	int rc = -EINVAL;
+
+	if ((disk == NULL) || (disk->ops == NULL) ||
+				(disk->ops->read == NULL) || (iovcnt == 0)) {
+		return rc;
+	}
+
+	if ((disk->ops->readv != NULL) && !disk_cached(disk)) {
+		return disk->ops->readv(disk, iov, iovcnt, start_sector);
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_read(disk, iov[i].buf, start_sector,
+				     iov[i].num_sector);
+#else
+		rc = disk->ops->read(disk, iov[i].buf, start_sector,
+				     iov[i].num_sector);
+#endif
+		if (rc != 0) {
+			break;
+		}
+
+		start_sector += iov[i].num_sector;
+	}
+
+	return rc;
+}
+
+int disk_access_writev(const char *pdrv, const struct disk_iovec *iov,
+		       size_t iovcnt, uint32_t start_sector)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	int rc = -EINVAL;
+
+	if ((disk == NULL) || (disk->ops == NULL) ||
+				(disk->ops->write == NULL) || (iovcnt == 0)) {
+		return rc;
+	}
+
+	if ((disk->ops->writev != NULL) && !disk_cached(disk)) {
+		return disk->ops->writev(disk, iov, iovcnt, start_sector);
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_write(disk, iov[i].buf, start_sector,
+				      iov[i].num_sector);
+#else
+		rc = disk->ops->write(disk, iov[i].buf, start_sector,
+				      iov[i].num_sector);
+#endif
+		if (rc != 0) {
+			break;
+		}
+
+		start_sector += iov[i].num_sector;
 	}
 
 	return rc;
@@ -114,6 +205,14 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			rc = disk_cache_sync(disk);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +260,12 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#ifdef CONFIG_DISK_CACHE
+	rc = disk_cache_detach(disk);
+	if (rc != 0) {
+		LOG_ERR("disk cache write back failed!!");
+	}
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistred", disk->name);
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+#include <sys/dlist.h>
+#include <sys/util.h>
+#include <drivers/disk.h>
+
+#include "disk_cache.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define COALESCE_SECTORS CONFIG_DISK_CACHE_COALESCE_SECTORS
+#define XFER_SECTORS MAX(CONFIG_DISK_CACHE_COALESCE_SECTORS, \
+			 CONFIG_DISK_CACHE_READ_AHEAD)
+/* Accesses bigger than this go straight to the disk */
+#define BYPASS_SECTORS (CONFIG_DISK_CACHE_BLOCKS / 2)
+
+struct cache_block {
+	/* Node in the LRU list */
+	sys_dnode_t node;
+	/* Disk of the cached sector, NULL for a free block */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	uint8_t __aligned(4) data[SECTOR_SIZE];
+};
+
+static struct cache_block blocks[CONFIG_DISK_CACHE_BLOCKS];
+
+/* Most recently used block first, free blocks are at the tail. The blocks
+ * join the list when they are first allocated.
+ */
+static sys_dlist_t lru_list = SYS_DLIST_STATIC_INIT(&lru_list);
+static size_t blocks_linked;
+
+/* Staging buffer for the coalesced writes and the read ahead */
+static uint8_t __aligned(4) xfer_buf[XFER_SECTORS * SECTOR_SIZE];
+
+static K_MUTEX_DEFINE(cache_lock);
+
+/* The cache is meant to be small, a linear search is cheaper than the disk
+ * access it saves.
+ */
+static struct cache_block *block_find(struct disk_info *disk, uint32_t sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && (blocks[i].sector == sector)) {
+			return &blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void block_touch(struct cache_block *block)
+{
+	sys_dlist_remove(&block->node);
+	sys_dlist_prepend(&lru_list, &block->node);
+}
+
+static void block_drop(struct cache_block *block)
+{
+	block->disk = NULL;
+	block->dirty = false;
+	sys_dlist_remove(&block->node);
+	sys_dlist_append(&lru_list, &block->node);
+}
+
+/* Write the modified sectors in the range with a single driver call, from
+ * the first to the last one. The clean sectors in between are taken from
+ * the cache or read from the disk, so that the range is rewritten once.
+ */
+static int range_flush(struct disk_info *disk, uint32_t first, uint32_t count)
+{
+	struct cache_block *block;
+	uint32_t start = UINT32_MAX;
+	uint32_t end = 0U;
+	uint32_t run;
+	int rc;
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty &&
+		    (blocks[i].sector - first < count)) {
+			start = MIN(start, blocks[i].sector);
+			end = MAX(end, blocks[i].sector + 1U);
+		}
+	}
+
+	if (start == UINT32_MAX) {
+		return 0;
+	}
+
+	for (uint32_t sector = start; sector < end; sector += run) {
+		uint8_t *buf = &xfer_buf[(sector - start) * SECTOR_SIZE];
+
+		block = block_find(disk, sector);
+		if (block) {
+			memcpy(buf, block->data, SECTOR_SIZE);
+			run = 1U;
+			continue;
+		}
+
+		/* Read the consecutive missing sectors at once */
+		for (run = 1U; sector + run < end; run++) {
+			if (block_find(disk, sector + run)) {
+				break;
+			}
+		}
+
+		rc = disk->ops->read(disk, buf, sector, run);
+		if (rc) {
+			LOG_ERR("Read of %u sectors at %u failed: %d", run,
+				sector, rc);
+			return rc;
+		}
+	}
+
+	rc = disk->ops->write(disk, xfer_buf, start, end - start);
+	if (rc) {
+		LOG_ERR("Write back of %u sectors at %u failed: %d",
+			end - start, start, rc);
+		return rc;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) &&
+		    (blocks[i].sector - start < end - start)) {
+			blocks[i].dirty = false;
+		}
+	}
+
+	return 0;
+}
+
+/* Write the modified sectors sharing the write window of sector. Windows are
+ * aligned to the erase blocks, so that each erase block is rewritten once.
+ */
+static int window_flush(struct disk_info *disk, uint32_t sector)
+{
+	uint32_t erase = disk->cache_erase_sectors;
+	uint32_t window = COALESCE_SECTORS;
+
+	if (erase <= COALESCE_SECTORS) {
+		window -= COALESCE_SECTORS % erase;
+	}
+
+	return range_flush(disk, sector - sector % window, window);
+}
+
+/* Get the least recently used block for a new sector. A modified block is
+ * written back first, unless may_flush is false: then NULL is returned.
+ */
+static struct cache_block *block_alloc(struct disk_info *disk, uint32_t sector,
+				       bool may_flush, int *err)
+{
+	struct cache_block *block;
+
+	*err = 0;
+	if (blocks_linked < ARRAY_SIZE(blocks)) {
+		block = &blocks[blocks_linked++];
+		sys_dlist_append(&lru_list, &block->node);
+	} else {
+		block = CONTAINER_OF(sys_dlist_peek_tail(&lru_list),
+				     struct cache_block, node);
+	}
+
+	if (block->disk && block->dirty) {
+		if (!may_flush) {
+			return NULL;
+		}
+
+		*err = window_flush(block->disk, block->sector);
+		if (*err) {
+			return NULL;
+		}
+	}
+
+	block->disk = disk;
+	block->sector = sector;
+	block->dirty = false;
+	block_touch(block);
+
+	return block;
+}
+
+/* Copy the sectors of the range which are in the cache, they are at least as
+ * recent as the disk content.
+ */
+static void range_overlay(struct disk_info *disk, uint8_t *data_buf,
+			  uint32_t start_sector, uint32_t num_sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) &&
+		    (blocks[i].sector - start_sector < num_sector)) {
+			memcpy(&data_buf[(blocks[i].sector - start_sector) *
+					 SECTOR_SIZE],
+			       blocks[i].data, SECTOR_SIZE);
+		}
+	}
+}
+
+static void read_ahead(struct disk_info *disk, uint32_t sector)
+{
+	struct cache_block *block;
+	uint32_t count;
+	int err;
+
+	if (sector >= disk->cache_sector_count) {
+		return;
+	}
+
+	count = MIN(CONFIG_DISK_CACHE_READ_AHEAD,
+		    disk->cache_sector_count - sector);
+	if (!count || block_find(disk, sector)) {
+		return;
+	}
+
+	if (disk->ops->read(disk, xfer_buf, sector, count)) {
+		return;
+	}
+
+	/* The read ahead does not write back modified blocks, xfer_buf is
+	 * in use and it is not worth delaying the read for.
+	 */
+	for (uint32_t i = 0; i < count; i++) {
+		if (block_find(disk, sector + i)) {
+			continue;
+		}
+
+		block = block_alloc(disk, sector + i, false, &err);
+		if (!block) {
+			break;
+		}
+		memcpy(block->data, &xfer_buf[i * SECTOR_SIZE], SECTOR_SIZE);
+	}
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct cache_block *block;
+	uint32_t sector, run;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!disk->cache_erase_sectors) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		goto end;
+	}
+
+	if (num_sector > BYPASS_SECTORS) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (!rc) {
+			range_overlay(disk, data_buf, start_sector,
+				      num_sector);
+		}
+		goto end;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i += run) {
+		sector = start_sector + i;
+		block = block_find(disk, sector);
+		if (block) {
+			memcpy(&data_buf[i * SECTOR_SIZE], block->data,
+			       SECTOR_SIZE);
+			block_touch(block);
+			run = 1U;
+			continue;
+		}
+
+		/* Read the consecutive missing sectors at once */
+		for (run = 1U; i + run < num_sector; run++) {
+			if (block_find(disk, sector + run)) {
+				break;
+			}
+		}
+
+		rc = disk->ops->read(disk, &data_buf[i * SECTOR_SIZE], sector,
+				     run);
+		if (rc) {
+			goto end;
+		}
+
+		for (uint32_t j = 0; j < run; j++) {
+			block = block_alloc(disk, sector + j, true, &rc);
+			if (!block) {
+				goto end;
+			}
+			memcpy(block->data, &data_buf[(i + j) * SECTOR_SIZE],
+			       SECTOR_SIZE);
+		}
+	}
+
+	if (CONFIG_DISK_CACHE_READ_AHEAD &&
+	    (start_sector == disk->cache_read_next)) {
+		read_ahead(disk, start_sector + num_sector);
+	}
+
+end:
+	disk->cache_read_next = start_sector + num_sector;
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct cache_block *block;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!disk->cache_erase_sectors) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto end;
+	}
+
+	if (num_sector > BYPASS_SECTORS) {
+		/* The cached sectors are overwritten, including the modified
+		 * ones.
+		 */
+		for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+			if ((blocks[i].disk == disk) &&
+			    (blocks[i].sector - start_sector < num_sector)) {
+				block_drop(&blocks[i]);
+			}
+		}
+
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto end;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		block = block_find(disk, start_sector + i);
+		if (block) {
+			block_touch(block);
+		} else {
+			block = block_alloc(disk, start_sector + i, true, &rc);
+			if (!block) {
+				goto end;
+			}
+		}
+
+		memcpy(block->data, &data_buf[i * SECTOR_SIZE], SECTOR_SIZE);
+		block->dirty = true;
+	}
+
+end:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+static int cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty) {
+			rc = window_flush(disk, blocks[i].sector);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	rc = cache_sync(disk);
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+void disk_cache_attach(struct disk_info *disk)
+{
+	uint32_t sector_size = 0U;
+	uint32_t erase_sectors = 0U;
+	uint32_t sector_count = 0U;
+
+	if (!disk->ops->ioctl ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size) ||
+	    (sector_size != SECTOR_SIZE)) {
+		LOG_DBG("Disk %s not cached", disk->name);
+		return;
+	}
+
+	if (disk->ops->ioctl(disk, DISK_IOCTL_GET_ERASE_BLOCK_SZ,
+			     &erase_sectors) || !erase_sectors) {
+		erase_sectors = 1U;
+	}
+
+	/* Without sector count there is no read ahead */
+	(void)disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			       &sector_count);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	disk->cache_erase_sectors = erase_sectors;
+	disk->cache_sector_count = sector_count;
+	disk->cache_read_next = UINT32_MAX;
+	k_mutex_unlock(&cache_lock);
+}
+
+int disk_cache_detach(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	rc = cache_sync(disk);
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (blocks[i].disk == disk) {
+			block_drop(&blocks[i]);
+		}
+	}
+	disk->cache_erase_sectors = 0U;
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
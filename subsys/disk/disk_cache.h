@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <drivers/disk.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Get the geometry of an initialized disk and enable its caching */
+void disk_cache_attach(struct disk_info *disk);
+
+/* Write back and drop the cached sectors of a disk */
+int disk_cache_detach(struct disk_info *disk);
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back the modified sectors of a disk */
+int disk_cache_sync(struct disk_info *disk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -128,6 +128,284 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 	return 0;
 }
 
+#ifdef CONFIG_FS_CACHE
+static struct fs_cache_stats cache_stats;
+
+int fs_cache_stats_get(struct fs_cache_stats *stats)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	*stats = cache_stats;
+	k_mutex_unlock(&mutex);
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_FS_STAT_CACHE
+/* Result of a fs_stat() call, either found or -ENOENT */
+struct stat_cache_entry {
+	const struct fs_mount_t *mp; /* NULL if unused */
+	uint32_t used; /* Time of last use, for LRU replacement */
+	int rc;
+	struct fs_dirent entry;
+	char path[CONFIG_FS_STAT_CACHE_PATH_MAX];
+};
+
+static struct stat_cache_entry stat_cache[CONFIG_FS_STAT_CACHE_ENTRIES];
+static uint32_t stat_cache_clock;
+/* Incremented by invalidations, so that results of fs_stat() calls which
+ * raced with a modification are not stored.
+ */
+static uint32_t stat_cache_gen;
+
+static bool stat_cache_lookup(const char *path, struct fs_dirent *entry,
+			      int *rc, uint32_t *gen)
+{
+	bool found = false;
+
+	k_mutex_lock(&mutex, K_FOREVER);
+
+	*gen = stat_cache_gen;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stat_cache); i++) {
+		struct stat_cache_entry *ce = &stat_cache[i];
+
+		if (ce->mp != NULL && strcmp(ce->path, path) == 0) {
+			ce->used = ++stat_cache_clock;
+			*entry = ce->entry;
+			*rc = ce->rc;
+			found = true;
+			break;
+		}
+	}
+
+	if (found) {
+		cache_stats.stat_hits++;
+	} else {
+		cache_stats.stat_misses++;
+	}
+
+	k_mutex_unlock(&mutex);
+
+	return found;
+}
+
+static void stat_cache_store(const struct fs_mount_t *mp, const char *path,
+			     int rc, const struct fs_dirent *entry,
+			     uint32_t gen)
+{
+	struct stat_cache_entry *ce = NULL;
+
+	if ((rc != 0 && rc != -ENOENT) ||
+	    strlen(path) >= CONFIG_FS_STAT_CACHE_PATH_MAX) {
+		return;
+	}
+
+	k_mutex_lock(&mutex, K_FOREVER);
+
+	if (gen == stat_cache_gen) {
+		/* Replace an unused entry or the least recently used one */
+		for (size_t i = 0; i < ARRAY_SIZE(stat_cache); i++) {
+			if (stat_cache[i].mp == NULL) {
+				ce = &stat_cache[i];
+				break;
+			}
+			if (ce == NULL || (int32_t)(stat_cache[i].used -
+						    ce->used) < 0) {
+				ce = &stat_cache[i];
+			}
+		}
+
+		ce->mp = mp;
+		ce->used = ++stat_cache_clock;
+		ce->rc = rc;
+		if (rc == 0) {
+			ce->entry = *entry;
+		}
+		strcpy(ce->path, path);
+	}
+
+	k_mutex_unlock(&mutex);
+}
+
+/* Invalidate the entries of a path and of the paths below it, or all the
+ * entries of a mount point when path is NULL.
+ */
+static void stat_cache_invalidate(const struct fs_mount_t *mp,
+				  const char *path)
+{
+	size_t len = (path != NULL) ? strlen(path) : 0;
+
+	k_mutex_lock(&mutex, K_FOREVER);
+
+	stat_cache_gen++;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stat_cache); i++) {
+		struct stat_cache_entry *ce = &stat_cache[i];
+
+		if (ce->mp != mp) {
+			continue;
+		}
+
+		if (path != NULL && (strncmp(ce->path, path, len) != 0 ||
+				     (ce->path[len] != '\0' &&
+				      ce->path[len] != '/'))) {
+			continue;
+		}
+
+		ce->mp = NULL;
+		cache_stats.stat_invalidations++;
+	}
+
+	k_mutex_unlock(&mutex);
+}
+#else
+static inline void stat_cache_invalidate(const struct fs_mount_t *mp,
+					 const char *path)
+{
+}
+#endif /* CONFIG_FS_STAT_CACHE */
+
+#ifdef CONFIG_FS_READ_AHEAD
+/* Number of consecutive reads of a file after which it is read ahead */
+#define RA_SEQ_READS 2
+
+struct fs_read_ahead {
+	bool used;
+	size_t window; /* Size of the next read ahead */
+	size_t len; /* Number of bytes in data */
+	size_t pos; /* Number of bytes of data already returned */
+	uint8_t data[CONFIG_FS_READ_AHEAD_SIZE];
+};
+
+static struct fs_read_ahead ra_pool[CONFIG_FS_READ_AHEAD_FILES];
+
+static struct fs_read_ahead *ra_alloc(size_t size)
+{
+	struct fs_read_ahead *ra = NULL;
+
+	k_mutex_lock(&mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ra_pool); i++) {
+		if (!ra_pool[i].used) {
+			ra = &ra_pool[i];
+			ra->used = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&mutex);
+
+	if (ra != NULL) {
+		ra->window = MIN(4 * size, sizeof(ra->data));
+		ra->len = 0;
+		ra->pos = 0;
+	}
+
+	return ra;
+}
+
+static void ra_release(struct fs_file_t *zfp)
+{
+	if (zfp->ra != NULL) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		zfp->ra->used = false;
+		k_mutex_unlock(&mutex);
+		zfp->ra = NULL;
+	}
+
+	zfp->ra_seq = 0;
+}
+
+/* Release the read-ahead buffer of a file before an operation depending on
+ * its position, which is moved back to the first byte not returned yet.
+ */
+static int ra_drop(struct fs_file_t *zfp)
+{
+	struct fs_read_ahead *ra = zfp->ra;
+	int rc = 0;
+
+	if (ra != NULL && ra->pos < ra->len) {
+		rc = zfp->mp->fs->lseek(zfp, -(off_t)(ra->len - ra->pos),
+					FS_SEEK_CUR);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	ra_release(zfp);
+
+	return rc;
+}
+
+/* The counters are read by fs_cache_stats_get() under the mutex */
+static void ra_stats_inc(uint32_t *counter)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	(*counter)++;
+	k_mutex_unlock(&mutex);
+}
+
+static ssize_t ra_read(struct fs_file_t *zfp, void *ptr, size_t size)
+{
+	struct fs_read_ahead *ra = zfp->ra;
+	size_t copied = 0;
+	size_t remaining;
+	ssize_t rc;
+
+	if (zfp->ra_seq < UINT8_MAX) {
+		zfp->ra_seq++;
+	}
+
+	if (ra != NULL) {
+		copied = MIN(size, ra->len - ra->pos);
+		memcpy(ptr, ra->data + ra->pos, copied);
+		ra->pos += copied;
+
+		if (copied == size) {
+			ra_stats_inc(&cache_stats.ra_hits);
+			return size;
+		}
+	} else if (zfp->ra_seq >= RA_SEQ_READS &&
+		   size < CONFIG_FS_READ_AHEAD_SIZE &&
+		   zfp->mp->fs->lseek != NULL) {
+		ra = ra_alloc(size);
+		zfp->ra = ra;
+	}
+
+	remaining = size - copied;
+
+	/* The buffer is empty from here, large reads bypass it */
+	if (ra == NULL || remaining >= ra->window) {
+		rc = zfp->mp->fs->read(zfp, (uint8_t *)ptr + copied,
+				       remaining);
+		if (rc < 0) {
+			return (copied > 0) ? copied : rc;
+		}
+
+		return copied + rc;
+	}
+
+	rc = zfp->mp->fs->read(zfp, ra->data, ra->window);
+	if (rc < 0) {
+		ra->len = 0;
+		ra->pos = 0;
+		return (copied > 0) ? copied : rc;
+	}
+
+	ra_stats_inc(&cache_stats.ra_fills);
+
+	ra->len = rc;
+	ra->pos = MIN(ra->len, remaining);
+	memcpy((uint8_t *)ptr + copied, ra->data, ra->pos);
+
+	/* Grow the window while the file is read sequentially */
+	ra->window = MIN(2 * ra->window, sizeof(ra->data));
+
+	return copied + ra->pos;
+}
+#endif /* CONFIG_FS_READ_AHEAD */
+
 /* File operations */
 int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 {
@@ -170,6 +448,10 @@ int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 		return rc;
 	}
 
+	if (flags & FS_O_CREATE) {
+		stat_cache_invalidate(mp, file_name);
+	}
+
 	return rc;
 }
 
@@ -191,6 +473,15 @@ int fs_close(struct fs_file_t *zfp)
 		return rc;
 	}
 
+	/* The size of a written file may only be updated by its closing */
+	if (zfp->flags & FS_O_WRITE) {
+		stat_cache_invalidate(zfp->mp, NULL);
+	}
+
+#ifdef CONFIG_FS_READ_AHEAD
+	ra_release(zfp);
+#endif
+
 	zfp->mp = NULL;
 
 	return rc;
@@ -208,7 +499,11 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FS_READ_AHEAD
+	rc = ra_read(zfp, ptr, size);
+#else
 	rc = zfp->mp->fs->read(zfp, ptr, size);
+#endif
 	if (rc < 0) {
 		LOG_ERR("file read error (%d)", rc);
 	}
@@ -228,11 +523,21 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FS_READ_AHEAD
+	rc = ra_drop(zfp);
+	if (rc < 0) {
+		LOG_ERR("file write error (%d)", rc);
+		return rc;
+	}
+#endif
+
 	rc = zfp->mp->fs->write(zfp, ptr, size);
 	if (rc < 0) {
 		LOG_ERR("file write error (%d)", rc);
 	}
 
+	stat_cache_invalidate(zfp->mp, NULL);
+
 	return rc;
 }
 
@@ -248,6 +553,14 @@ int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FS_READ_AHEAD
+	rc = ra_drop(zfp);
+	if (rc < 0) {
+		LOG_ERR("file seek error (%d)", rc);
+		return rc;
+	}
+#endif
+
 	rc = zfp->mp->fs->lseek(zfp, offset, whence);
 	if (rc < 0) {
 		LOG_ERR("file seek error (%d)", rc);
@@ -273,6 +586,13 @@ off_t fs_tell(struct fs_file_t *zfp)
 		LOG_ERR("file tell error (%d)", rc);
 	}
 
+#ifdef CONFIG_FS_READ_AHEAD
+	/* Data read ahead has not been returned yet */
+	if (rc >= 0 && zfp->ra != NULL) {
+		rc -= zfp->ra->len - zfp->ra->pos;
+	}
+#endif
+
 	return rc;
 }
 
@@ -288,11 +608,21 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FS_READ_AHEAD
+	rc = ra_drop(zfp);
+	if (rc < 0) {
+		LOG_ERR("file truncate error (%d)", rc);
+		return rc;
+	}
+#endif
+
 	rc = zfp->mp->fs->truncate(zfp, length);
 	if (rc < 0) {
 		LOG_ERR("file truncate error (%d)", rc);
 	}
 
+	stat_cache_invalidate(zfp->mp, NULL);
+
 	return rc;
 }
 
@@ -313,6 +643,8 @@ int fs_sync(struct fs_file_t *zfp)
 		LOG_ERR("file sync error (%d)", rc);
 	}
 
+	stat_cache_invalidate(zfp->mp, NULL);
+
 	return rc;
 }
 
@@ -503,6 +835,8 @@ int fs_mkdir(const char *abs_path)
 		LOG_ERR("failed to create directory (%d)", rc);
 	}
 
+	stat_cache_invalidate(mp, abs_path);
+
 	return rc;
 }
 
@@ -536,6 +870,8 @@ int fs_unlink(const char *abs_path)
 		LOG_ERR("failed to unlink path (%d)", rc);
 	}
 
+	stat_cache_invalidate(mp, abs_path);
+
 	return rc;
 }
 
@@ -576,6 +912,9 @@ int fs_rename(const char *from, const char *to)
 		LOG_ERR("failed to rename file or dir (%d)", rc);
 	}
 
+	stat_cache_invalidate(mp, from);
+	stat_cache_invalidate(mp, to);
+
 	return rc;
 }
 
@@ -600,10 +939,24 @@ int fs_stat(const char *abs_path, struct fs_dirent *entry)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FS_STAT_CACHE
+	uint32_t gen = 0U;
+
+	if (entry != NULL && stat_cache_lookup(abs_path, entry, &rc, &gen)) {
+		return rc;
+	}
+#endif
+
 	rc = mp->fs->stat(mp, abs_path, entry);
 	if (rc < 0) {
 		LOG_ERR("failed get file or dir stat (%d)", rc);
 	}
+
+#ifdef CONFIG_FS_STAT_CACHE
+	if (entry != NULL) {
+		stat_cache_store(mp, abs_path, rc, entry, gen);
+	}
+#endif
 	return rc;
 }
 
@@ -739,6 +1092,8 @@ int fs_unmount(struct fs_mount_t *mp)
 		goto unmount_err;
 	}
 
+	stat_cache_invalidate(mp, NULL);
+
 	/* clear file system interface */
 	mp->fs = NULL;
 
@@ -16,6 +16,43 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+static K_THREAD_STACK_DEFINE(nvs_gc_stack,
+			     CONFIG_NVS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q nvs_gc_workq;
+static atomic_t nvs_gc_workq_started;
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+static void nvs_lookup_cache_clear(struct nvs_fs *fs)
+{
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+}
+
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
+/* Return the address where the search for the most recent ate of id should
+ * start, or NVS_LOOKUP_CACHE_NO_ADDR when it is known that there is no such
+ * ate. Without the lookup cache this is always the newest ate. With the cache
+ * it is the most recent ate of all the ids sharing the cache position, the
+ * walk from there finds the ate of id (if any) without reading the newer ate's
+ * of the other ids.
+ */
+static inline uint32_t nvs_lookup_start(struct nvs_fs *fs, uint16_t id)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#else
+	return fs->ate_wra;
+#endif
+}
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -96,6 +133,13 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* 0xFFFF is used by close and gc done ate's, it is not cached */
+	if (!rc && (entry->id != 0xFFFF)) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] =
+			fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -457,6 +501,58 @@ static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 	}
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* Walk through all ate's from newest to oldest and store the address of the
+ * first (most recent) valid ate found for each cache position.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	nvs_lookup_cache_clear(fs);
+	addr = fs->ate_wra;
+
+	while (1) {
+		/* nvs_prev_ate() moves addr to the previous ate */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+
+		if ((ate.id != 0xFFFF) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    nvs_ate_valid(fs, &ate)) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* Remove the cache entries pointing to a sector that is about to be erased.
+ * Valid data has already been moved out of the sector by gc, which updated
+ * the cache, so the remaining entries only refer to outdated or deleted ids.
+ */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] >> ADDR_SECT_SHIFT) == sector) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
+
 /* allocation entry close (this closes the current sector) by writing offset
  * of last ate to the sector end.
  */
@@ -498,26 +594,34 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
-/* garbage collection: the address ate_wra has been updated to the new sector
- * that has just been started. The data to gc is in the sector after this new
- * sector.
+/* garbage collection is done in three parts, so that the background gc can
+ * move the entries of a sector in several steps: nvs_gc_begin finds the
+ * entries of the sector to gc, nvs_gc_move moves the ones that have no newer
+ * copy and nvs_gc_end marks the gc as finished and erases the sector.
  */
-static int nvs_gc(struct nvs_fs *fs)
+
+/* nvs_gc_begin: the address ate_wra has been updated to the new sector that
+ * has just been started. The data to gc is in the sector after this new
+ * sector. Sets gc_addr to the last ate and stop_addr to the first ate of
+ * that sector, returns 1 when the sector is not closed and holds nothing to
+ * move.
+ */
+static int nvs_gc_begin(struct nvs_fs *fs, uint32_t *gc_addr,
+			uint32_t *stop_addr)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
+	uint32_t addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &addr);
+	addr += fs->sector_size - ate_size;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -525,24 +629,46 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		return 1;
 	}
 
-	stop_addr = gc_addr - ate_size;
+	*stop_addr = addr - ate_size;
 
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
+		addr &= ADDR_SECT_MASK;
+		addr += close_ate.offset;
 	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
+		rc = nvs_recover_last_ate(fs, &addr);
 		if (rc) {
 			return rc;
 		}
 	}
 
+	*gc_addr = addr;
+	return 0;
+}
+
+/* nvs_gc_move: walk the ate's of the gc sector from gc_addr towards stop_addr
+ * and copy the entries that have no newer copy to the write sector. At most
+ * cnt ate's are handled, data_end is lowered to the data offset of the last
+ * one so that it bounds the data left to move. Returns 1 once stop_addr is
+ * reached.
+ */
+static int nvs_gc_move(struct nvs_fs *fs, uint32_t *gc_addr,
+		       uint32_t stop_addr, uint16_t *data_end, uint32_t cnt)
+{
+	int rc;
+	struct nvs_ate gc_ate, wlk_ate;
+	uint32_t gc_prev_addr, wlk_addr, wlk_prev_addr, data_addr;
+
 	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		if (cnt == 0U) {
+			return 0;
+		}
+		cnt--;
+
+		gc_prev_addr = *gc_addr;
+		rc = nvs_prev_ate(fs, gc_addr, &gc_ate);
 		if (rc) {
 			return rc;
 		}
@@ -551,7 +677,13 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-		wlk_addr = fs->ate_wra;
+		*data_end = gc_ate.offset;
+
+		wlk_addr = nvs_lookup_start(fs, gc_ate.id);
+		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+			/* not expected as gc_ate is valid, walk everything */
+			wlk_addr = fs->ate_wra;
+		}
 		do {
 			wlk_prev_addr = wlk_addr;
 			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
@@ -594,7 +726,20 @@ static int nvs_gc(struct nvs_fs *fs)
 		}
 	} while (gc_prev_addr != stop_addr);
 
-gc_done:
+	return 1;
+}
+
+/* nvs_gc_end: finish the gc of the sector after the write sector */
+static int nvs_gc_end(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t sec_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -609,6 +754,10 @@ gc_done:
 		}
 	}
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -617,11 +766,245 @@ gc_done:
 	return 0;
 }
 
+/* garbage collection of the sector after the write sector in one go */
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t gc_addr, stop_addr;
+	uint16_t data_end;
+
+	rc = nvs_gc_begin(fs, &gc_addr, &stop_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (rc == 0) {
+		rc = nvs_gc_move(fs, &gc_addr, stop_addr, &data_end,
+				 UINT32_MAX);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return nvs_gc_end(fs);
+}
+
+#ifdef CONFIG_NVS_GC_STATS
+/* nvs_gc_stats_update accounts the duration of a garbage collection or, in
+ * the background, of one of its steps. done is set by the last step.
+ */
+static void nvs_gc_stats_update(struct nvs_fs *fs, bool background,
+				uint32_t cycles, bool done)
+{
+	uint32_t us = k_cyc_to_us_ceil32(cycles);
+
+	if (background) {
+		fs->gc_stats.bg_count += done ? 1U : 0U;
+		fs->gc_stats.bg_max_us = MAX(fs->gc_stats.bg_max_us, us);
+		fs->gc_stats.bg_total_us += us;
+	} else {
+		fs->gc_stats.fg_count += done ? 1U : 0U;
+		fs->gc_stats.fg_max_us = MAX(fs->gc_stats.fg_max_us, us);
+		fs->gc_stats.fg_total_us += us;
+	}
+}
+#endif
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+/* nvs_bg_gc_needed returns true when the free space in the write sector is
+ * below the background gc threshold.
+ */
+static bool nvs_bg_gc_needed(struct nvs_fs *fs, uint32_t factor)
+{
+	uint32_t threshold;
+
+	threshold = fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100U;
+
+	return (fs->ate_wra - fs->data_wra) < (factor * threshold);
+}
+
+/* nvs_bg_gc_reserve returns the space the gc in progress still needs in the
+ * write sector: the data and ate's left to move and the gc done ate.
+ */
+static uint32_t nvs_bg_gc_reserve(struct nvs_fs *fs)
+{
+	size_t ate_size;
+
+	if (!fs->gc_active) {
+		return 0U;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	return fs->gc_data_end + (fs->gc_stop_addr - fs->gc_addr) + ate_size;
+}
+
+/* nvs_bg_gc_step starts a gc by closing the write sector when none is in
+ * progress and moves at most cnt ate's of the gc sector. Returns 1 once the
+ * gc is finished and the sector erased.
+ */
+static int nvs_bg_gc_step(struct nvs_fs *fs, uint32_t cnt)
+{
+	int rc;
+
+	if (!fs->gc_active) {
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc_begin(fs, &fs->gc_addr, &fs->gc_stop_addr);
+		if (rc < 0) {
+			return rc;
+		}
+
+		fs->gc_active = (rc == 0);
+		fs->gc_data_end = (uint16_t)(fs->gc_addr & ADDR_OFFS_MASK);
+	}
+
+	if (fs->gc_active) {
+		rc = nvs_gc_move(fs, &fs->gc_addr, fs->gc_stop_addr,
+				 &fs->gc_data_end, cnt);
+		if (rc <= 0) {
+			return rc;
+		}
+		fs->gc_active = false;
+	}
+
+	rc = nvs_gc_end(fs);
+	if (rc) {
+		return rc;
+	}
+
+	/* If the moved entries already fill most of the new write sector,
+	 * reclaiming it early again would only wear the flash, wait until
+	 * it is full.
+	 */
+	fs->gc_armed = !nvs_bg_gc_needed(fs, 2U);
+
+	return 1;
+}
+#endif
+
+/* close the write sector and gc the oldest sector, or complete the
+ * background gc in progress. This is the unit of space reclaim for the
+ * writes.
+ */
+static int nvs_sector_reclaim(struct nvs_fs *fs)
+{
+	int rc;
+#ifdef CONFIG_NVS_GC_STATS
+	uint32_t start = k_cycle_get_32();
+#endif
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	rc = nvs_bg_gc_step(fs, UINT32_MAX);
+	if (rc > 0) {
+		rc = 0;
+	}
+#else
+	rc = nvs_sector_close(fs);
+	if (!rc) {
+		rc = nvs_gc(fs);
+	}
+#endif
+
+#ifdef CONFIG_NVS_GC_STATS
+	nvs_gc_stats_update(fs, false, k_cycle_get_32() - start, true);
+#endif
+
+	return rc;
+}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+/* Every run of the work does one step of the gc and, as long as the gc is not
+ * finished, submits itself again, so that the mutex is released between the
+ * steps.
+ */
+static void nvs_bg_gc_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+#ifdef CONFIG_NVS_GC_STATS
+	uint32_t start = k_cycle_get_32();
+#endif
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready ||
+	    (!fs->gc_active && !(fs->gc_armed && nvs_bg_gc_needed(fs, 1U)))) {
+		goto end;
+	}
+
+	if (!fs->gc_active) {
+		LOG_DBG("Background gc of sector after %d",
+			fs->ate_wra >> ADDR_SECT_SHIFT);
+	}
+
+	rc = nvs_bg_gc_step(fs, CONFIG_NVS_BACKGROUND_GC_STEP);
+
+#ifdef CONFIG_NVS_GC_STATS
+	nvs_gc_stats_update(fs, true, k_cycle_get_32() - start, rc > 0);
+#endif
+
+	if (rc < 0) {
+		LOG_ERR("Background gc failed: %d", rc);
+	} else if (rc == 0) {
+		(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+	}
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+static void nvs_bg_gc_init(struct nvs_fs *fs)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nvs_gc",
+	};
+
+	if (atomic_cas(&nvs_gc_workq_started, 0, 1)) {
+		k_work_queue_start(&nvs_gc_workq, nvs_gc_stack,
+				   K_THREAD_STACK_SIZEOF(nvs_gc_stack),
+				   CONFIG_NVS_BACKGROUND_GC_PRIORITY, &cfg);
+	}
+
+	k_work_init(&fs->gc_work, nvs_bg_gc_handler);
+	fs->gc_armed = true;
+	fs->gc_active = false;
+}
+#endif
+
+/* possible data write after last ate write, update data_wra */
+static int nvs_data_wra_recover(struct nvs_fs *fs)
+{
+	int rc;
+	size_t empty_len;
+
+	while (fs->ate_wra > fs->data_wra) {
+		empty_len = fs->ate_wra - fs->data_wra;
+
+		rc = nvs_flash_cmp_const(fs, fs->data_wra,
+					 fs->flash_parameters->erase_value,
+					 empty_len);
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
+			break;
+		}
+
+		fs->data_wra += fs->flash_parameters->write_block_size;
+	}
+
+	return 0;
+}
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate last_ate;
-	size_t ate_size, empty_len;
+	size_t ate_size;
 	/* Initialize addr to 0 for the case fs->sector_count == 0. This
 	 * should never happen as this is verified in nvs_init() but both
 	 * Coverity and GCC believe the contrary.
@@ -770,6 +1153,17 @@ static int nvs_startup(struct nvs_fs *fs)
 			goto end;
 		}
 		LOG_INF("No GC Done marker found: restarting gc");
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* Writes done between the steps of a background gc are
+		 * stored in the write sector, so it is kept and the gc is
+		 * resumed: the entries that were already moved have a newer
+		 * copy and are not moved again.
+		 */
+		rc = nvs_data_wra_recover(fs);
+		if (rc) {
+			goto end;
+		}
+#else
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
 			goto end;
@@ -777,24 +1171,21 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+#endif
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+		/* gc uses the cache to find the latest ate's */
+		rc = nvs_lookup_cache_rebuild(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
 		rc = nvs_gc(fs);
 		goto end;
 	}
 
-	/* possible data write after last ate write, update data_wra */
-	while (fs->ate_wra > fs->data_wra) {
-		empty_len = fs->ate_wra - fs->data_wra;
-
-		rc = nvs_flash_cmp_const(fs, fs->data_wra, erase_value,
-				empty_len);
-		if (rc < 0) {
-			goto end;
-		}
-		if (!rc) {
-			break;
-		}
-
-		fs->data_wra += fs->flash_parameters->write_block_size;
+	rc = nvs_data_wra_recover(fs);
+	if (rc) {
+		goto end;
 	}
 
 	/* If the ate_wra is pointing to the first ate write location in a
@@ -819,6 +1210,13 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!rc) {
+		rc = nvs_lookup_cache_rebuild(fs);
+	}
+#endif
+
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -827,12 +1225,19 @@ int nvs_clear(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr;
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -840,6 +1245,14 @@ int nvs_clear(struct nvs_fs *fs)
 			return rc;
 		}
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_clear(fs);
+#endif
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	fs->gc_active = false;
+#endif
+
 	return 0;
 }
 
@@ -849,9 +1262,27 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	int rc;
 	struct flash_pages_info info;
 	size_t write_block_size;
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work_sync sync;
+
+	/* A re-initialized file system might have a pending gc, which takes
+	 * the mutex, so it is cancelled before the mutex is initialized.
+	 */
+	if (fs->gc_work_init) {
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+#endif
 
 	k_mutex_init(&fs->nvs_lock);
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	nvs_bg_gc_init(fs);
+	fs->gc_work_init = true;
+#endif
+#ifdef CONFIG_NVS_GC_STATS
+	(void)memset(&fs->gc_stats, 0, sizeof(fs->gc_stats));
+#endif
+
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
 		LOG_ERR("No valid flash device found");
@@ -915,6 +1346,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	struct nvs_ate wlk_ate;
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
+	uint32_t reserved_space = 0U;
 	bool prev_found = false;
 
 	if (!fs->ready) {
@@ -935,10 +1367,10 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
@@ -999,7 +1431,15 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			goto end;
 		}
 
-		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* keep the space a background gc in progress still needs,
+		 * the gc is completed first when the entry does not fit.
+		 */
+		reserved_space = nvs_bg_gc_reserve(fs);
+#endif
+
+		if (fs->ate_wra >=
+		    (fs->data_wra + reserved_space + required_space)) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
 			if (rc) {
@@ -1008,18 +1448,18 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			break;
 		}
 
-
-		rc = nvs_sector_close(fs);
-		if (rc) {
-			goto end;
-		}
-
-		rc = nvs_gc(fs);
+		rc = nvs_sector_reclaim(fs);
 		if (rc) {
 			goto end;
 		}
 		gc_count++;
 	}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (fs->gc_armed && nvs_bg_gc_needed(fs, 1U)) {
+		(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+	}
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -1053,7 +1493,10 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return -ENOENT;
+	}
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -1151,3 +1594,21 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats)
+{
+#ifdef CONFIG_NVS_GC_STATS
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->gc_stats;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
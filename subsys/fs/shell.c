@@ -409,6 +409,30 @@ static int cmd_statvfs(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+#ifdef CONFIG_FS_CACHE
+static int cmd_cache(const struct shell *shell, size_t argc, char **argv)
+{
+	struct fs_cache_stats stats;
+	int err;
+
+	err = fs_cache_stats_get(&stats);
+	if (err < 0) {
+		shell_error(shell, "Failed to get cache statistics (%d)", err);
+		return -ENOEXEC;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "stat cache: hits %u, misses %u, invalidations %u\n",
+		      stats.stat_hits, stats.stat_misses,
+		      stats.stat_invalidations);
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "read-ahead: hits %u, fills %u\n",
+		      stats.ra_hits, stats.ra_fills);
+
+	return 0;
+}
+#endif
+
 static int cmd_write(const struct shell *shell, size_t argc, char **argv)
 {
 	char path[MAX_PATH_LEN];
@@ -564,6 +588,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_fs_mount,
 #endif
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_fs,
+#ifdef CONFIG_FS_CACHE
+	SHELL_CMD(cache, NULL, "Show file system cache statistics", cmd_cache),
+#endif
 	SHELL_CMD(cd, NULL, "Change working directory", cmd_cd),
 	SHELL_CMD(ls, NULL, "List files in current directory", cmd_ls),
 	SHELL_CMD_ARG(mkdir, NULL, "Create directory", cmd_mkdir, 2, 0),
@@ -172,6 +172,13 @@ static int do_net_init(void)
 	return 0;
 }
 
+static uint32_t net_output_flags(void)
+{
+	return LOG_OUTPUT_FLAG_FORMAT_SYSLOG | LOG_OUTPUT_FLAG_TIMESTAMP |
+		(IS_ENABLED(CONFIG_LOG_BACKEND_NET_SYST_ENABLE) ?
+		LOG_OUTPUT_FLAG_FORMAT_SYST : 0);
+}
+
 static void send_output(const struct log_backend *const backend,
 			struct log_msg *msg)
 {
@@ -185,15 +192,37 @@ static void send_output(const struct log_backend *const backend,
 
 	log_msg_get(msg);
 
-	log_output_msg_process(&log_output_net, msg,
-			       LOG_OUTPUT_FLAG_FORMAT_SYSLOG |
-			       LOG_OUTPUT_FLAG_TIMESTAMP |
-			(IS_ENABLED(CONFIG_LOG_BACKEND_NET_SYST_ENABLE) ?
-			LOG_OUTPUT_FLAG_FORMAT_SYST : 0));
+	log_output_msg_process(&log_output_net, msg, net_output_flags());
 
 	log_msg_put(msg);
 }
 
+static void process(const struct log_backend *const backend,
+		    union log_msg2_generic *msg)
+{
+	if (panic_mode) {
+		return;
+	}
+
+	if (!net_init_done && do_net_init() == 0) {
+		net_init_done = true;
+	}
+
+	log_output_msg2_process(&log_output_net, &msg->log,
+				net_output_flags());
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	if (panic_mode || !net_init_done) {
+		return;
+	}
+
+	log_output_dropped_process(&log_output_net, cnt);
+}
+
 static void init_net(struct log_backend const *const backend)
 {
 	ARG_UNUSED(backend);
@@ -240,7 +269,8 @@ static void sync_string(const struct log_backend *const backend,
 const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
-	.put = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? NULL : send_output,
+	.process = IS_ENABLED(CONFIG_LOG2) ? process : NULL,
+	.put = IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) ? send_output : NULL,
 	.put_sync_string = IS_ENABLED(CONFIG_LOG_IMMEDIATE) ?
 							sync_string : NULL,
 	/* Currently we do not send hexdumps over network to remote server
@@ -248,6 +278,10 @@ const struct log_backend_api log_backend_net_api = {
 	 * this can be revisited if needed.
 	 */
 	.put_sync_hexdump = NULL,
+	/* Dropped messages indication is not a valid syslog message, it is
+	 * only sent in the dictionary-based output mode.
+	 */
+	.dropped = IS_ENABLED(CONFIG_LOG_OUTPUT_DICTIONARY) ? dropped : NULL,
 };
 
 /* Note that the backend can be activated only after we have networking
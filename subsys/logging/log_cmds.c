@@ -7,6 +7,7 @@
 #include <shell/shell.h>
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
+#include <stdlib.h>
 #include <string.h>
 
 typedef int (*log_backend_cmd_t)(const struct shell *shell,
@@ -399,6 +400,97 @@ static int cmd_log_strdup_utilization(const struct shell *shell,
 	return 0;
 }
 
+#if defined(CONFIG_LOG_RATE_LIMIT)
+static int cmd_log_rate_limit_status(const struct shell *shell,
+				     size_t argc, char **argv)
+{
+	uint32_t modules_cnt = log_sources_count();
+	uint16_t burst, rate, sample;
+	uint32_t total = 0U;
+
+	log_rate_limit_get(&burst, &rate, &sample);
+	shell_print(shell, "Burst: %u, rate: %u msg/s, sampling: %s%u",
+		    burst, rate, sample ? "1 in " : "", sample);
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "%-40s | %-8s | %-8s | %-8s | %-8s\r\n", "module_name",
+		      severity_lvls[LOG_LEVEL_ERR], severity_lvls[LOG_LEVEL_WRN],
+		      severity_lvls[LOG_LEVEL_INF], severity_lvls[LOG_LEVEL_DBG]);
+	shell_fprintf(shell, SHELL_NORMAL,
+	      "----------------------------------------------------------"
+	      "--------------------------\r\n");
+
+	for (uint32_t i = 0U; i < modules_cnt; i++) {
+		uint32_t cnt[4];
+		uint32_t sum = 0U;
+
+		for (int lvl = LOG_LEVEL_ERR; lvl <= LOG_LEVEL_DBG; lvl++) {
+			cnt[lvl - 1] = log_rate_limit_suppressed_get(i, lvl);
+			sum += cnt[lvl - 1];
+		}
+
+		/* Only sources which were limited are listed. */
+		if (sum == 0U) {
+			continue;
+		}
+
+		total += sum;
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "%-40s | %-8u | %-8u | %-8u | %-8u\r\n",
+			      log_source_name_get(CONFIG_LOG_DOMAIN_ID, i),
+			      cnt[0], cnt[1], cnt[2], cnt[3]);
+	}
+
+	shell_print(shell, "Suppressed messages: %u", total);
+
+	return 0;
+}
+
+static int cmd_log_rate_limit_set(const struct shell *shell,
+				  size_t argc, char **argv)
+{
+	unsigned long burst, rate, sample = 0UL;
+
+	burst = strtoul(argv[1], NULL, 0);
+	rate = strtoul(argv[2], NULL, 0);
+	if (argc > 3) {
+		sample = strtoul(argv[3], NULL, 0);
+	}
+
+	if (burst == 0UL || burst > UINT16_MAX || rate > UINT16_MAX ||
+	    sample > UINT16_MAX) {
+		shell_error(shell, "Invalid parameters");
+		return -EINVAL;
+	}
+
+	log_rate_limit_set(burst, rate, sample);
+
+	return 0;
+}
+
+static int cmd_log_rate_limit_reset(const struct shell *shell,
+				    size_t argc, char **argv)
+{
+	log_rate_limit_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_rate_limit,
+	SHELL_CMD_ARG(reset, NULL,
+		  "Reset rate limiting state and suppressed messages counters.",
+		  cmd_log_rate_limit_reset, 1, 0),
+	SHELL_CMD_ARG(set, NULL,
+		  "'log rate_limit set <burst> <rate> [<sample>]' passes "
+		  "<burst> messages of each module and level, then <rate> "
+		  "messages per second and 1 in <sample> of the others.",
+		  cmd_log_rate_limit_set, 3, 1),
+	SHELL_CMD_ARG(status, NULL,
+		  "Rate limiting parameters and suppressed messages.",
+		  cmd_log_rate_limit_status, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+#endif /* CONFIG_LOG_RATE_LIMIT */
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
@@ -448,6 +540,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_stat,
 	SHELL_CMD(halt, NULL, "Halt logging", cmd_log_self_halt),
 	SHELL_CMD_ARG(list_backends, NULL, "Lists logger backends.",
 		      cmd_log_backends_list, 1, 0),
+	SHELL_COND_CMD(CONFIG_LOG_RATE_LIMIT, rate_limit,
+		       COND_CODE_1(CONFIG_LOG_RATE_LIMIT,
+				   (&sub_log_rate_limit), (NULL)),
+		       "Rate limiting commands.", NULL),
 	SHELL_CMD(status, NULL, "Logger status", cmd_log_self_status),
 	SHELL_COND_CMD_ARG(CONFIG_LOG_STRDUP_POOL_PROFILING, strdup_utilization,
 			NULL, "Get utilization of string duplicates pool",
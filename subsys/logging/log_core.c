@@ -39,6 +39,12 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_PROCESS_THREAD_STACK_SIZE 1
 #endif
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+#define LOG_BUFFER_CNT CONFIG_MP_NUM_CPUS
+#else
+#define LOG_BUFFER_CNT 1
+#endif
+
 #ifndef CONFIG_LOG_STRDUP_MAX_STRING
 /* Required to suppress compiler warnings related to array subscript above array bounds.
  * log_strdup explicitly accesses element with index of (sizeof(log_strdup_buf.buf) - 2).
@@ -59,6 +65,13 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+#define LOG_BUFFER_WLEN (ROUND_DOWN(CONFIG_LOG_BUFFER_SIZE / LOG_BUFFER_CNT, \
+				    Z_LOG_MSG2_ALIGNMENT) / sizeof(int))
+#else
+#define LOG_BUFFER_WLEN (CONFIG_LOG_BUFFER_SIZE / sizeof(int))
+#endif
+
 struct log_strdup_buf {
 	atomic_t refcount;
 	char buf[CONFIG_LOG_STRDUP_MAX_STRING + 1]; /* for termination */
@@ -84,7 +97,7 @@ static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
 static atomic_t buffered_cnt;
-static atomic_t dropped_cnt;
+static atomic_t dropped_cnt[LOG_BUFFER_CNT];
 static k_tid_t proc_tid;
 static uint32_t log_strdup_in_use;
 static uint32_t log_strdup_max;
@@ -94,16 +107,25 @@ static struct k_timer log_process_thread_timer;
 static log_timestamp_t dummy_timestamp(void);
 static log_timestamp_get_t timestamp_func = dummy_timestamp;
 
-struct mpsc_pbuf_buffer log_buffer;
+/* With CONFIG_LOG_BUFFER_PER_CPU each CPU allocates messages from its own
+ * buffer. Messages are committed and freed to the buffer they were allocated
+ * from, which is found from the message address as the thread may have
+ * migrated to another CPU in the meantime.
+ */
+static struct mpsc_pbuf_buffer log_buffers[LOG_BUFFER_CNT];
 static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_CNT][LOG_BUFFER_WLEN];
+
+/* Oldest message claimed from each buffer but not yet processed. Used for
+ * merging the buffers in timestamp order.
+ */
+static union log_msg2_generic *pending_msg[LOG_BUFFER_CNT];
+static struct k_spinlock claim_lock;
 
 static void notify_drop(struct mpsc_pbuf_buffer *buffer,
 			union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
 	.notify_drop = notify_drop,
 	.get_wlen = log_msg2_generic_get_wlen,
 	.flags = IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -845,27 +867,192 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 #include <syscalls/log_buffered_cnt_mrsh.c>
 #endif
 
+/* Index of the buffer used by the current CPU. */
+static inline uint32_t cpu_buffer_idx(void)
+{
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	unsigned int key = arch_irq_lock();
+	uint32_t idx = arch_curr_cpu()->id;
+
+	arch_irq_unlock(key);
+
+	return idx;
+#else
+	return 0;
+#endif
+}
+
 void z_log_dropped(void)
 {
-	atomic_inc(&dropped_cnt);
+	atomic_inc(&dropped_cnt[cpu_buffer_idx()]);
 }
 
 uint32_t z_log_dropped_read_and_clear(void)
 {
-	return atomic_set(&dropped_cnt, 0);
+	uint32_t dropped = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		dropped += atomic_set(&dropped_cnt[i], 0);
+	}
+
+	return dropped;
 }
 
 bool z_log_dropped_pending(void)
 {
-	return dropped_cnt > 0;
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if (atomic_get(&dropped_cnt[i]) > 0) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 static void notify_drop(struct mpsc_pbuf_buffer *buffer,
 			union mpsc_pbuf_generic *item)
 {
-	z_log_dropped();
+	atomic_inc(&dropped_cnt[buffer - log_buffers]);
 }
 
+#ifdef CONFIG_LOG_RATE_LIMIT
+static uint16_t rate_limit_burst = CONFIG_LOG_RATE_LIMIT_BURST;
+static uint16_t rate_limit_rate = CONFIG_LOG_RATE_LIMIT_RATE;
+static uint16_t rate_limit_sample = CONFIG_LOG_RATE_LIMIT_SAMPLE;
+
+/* Take a token from the bucket, fails if the bucket is empty. */
+static bool rate_limit_take(struct log_source_rate_limit *rl, uint16_t burst)
+{
+	atomic_val_t used;
+
+	do {
+		used = atomic_get(&rl->used);
+		if (used >= burst) {
+			return false;
+		}
+	} while (!atomic_cas(&rl->used, used, used + 1));
+
+	return true;
+}
+
+/* Return tokens to an empty bucket for the time elapsed since the last
+ * refill. Only the time corresponding to the returned tokens is consumed so
+ * that slow sources are not starved by rounding. The context which moves the
+ * stamp forward returns the tokens, concurrent ones try again later.
+ */
+static void rate_limit_refill(struct log_source_rate_limit *rl,
+			      uint16_t burst, uint16_t rate)
+{
+	atomic_val_t stamp = atomic_get(&rl->stamp);
+	atomic_val_t used = atomic_get(&rl->used);
+	uint32_t now = k_uptime_get_32();
+	uint32_t tokens;
+	bool refilled;
+
+	tokens = MIN((uint64_t)(now - (uint32_t)stamp) * rate / MSEC_PER_SEC,
+		     burst);
+	if (tokens == 0U) {
+		return;
+	}
+
+	if (tokens == burst) {
+		refilled = atomic_cas(&rl->stamp, stamp, now);
+	} else {
+		refilled = atomic_cas(&rl->stamp, stamp,
+				      stamp + tokens * MSEC_PER_SEC / rate);
+	}
+
+	/* Other contexts can only take tokens until the stamp moves, so the
+	 * bucket did not lose more than the used tokens read above.
+	 */
+	if (refilled) {
+		atomic_sub(&rl->used, MIN(tokens, used));
+	}
+}
+
+bool z_log_rate_limit_check(struct log_source_dynamic_data *source,
+			    uint8_t level)
+{
+	struct log_source_rate_limit *rl;
+	uint16_t burst = rate_limit_burst;
+	uint16_t rate = rate_limit_rate;
+	uint16_t sample = rate_limit_sample;
+	atomic_val_t limited;
+	bool pass;
+
+	if (source == NULL || level < LOG_LEVEL_ERR || level > LOG_LEVEL_DBG) {
+		return true;
+	}
+
+	rl = &source->rate_limit[level - 1U];
+
+	/* The clock is only read when the bucket is empty. */
+	if (rate_limit_take(rl, burst)) {
+		return true;
+	}
+
+	if (rate != 0U) {
+		rate_limit_refill(rl, burst, rate);
+		if (rate_limit_take(rl, burst)) {
+			return true;
+		}
+	}
+
+	limited = atomic_inc(&rl->limited) + 1;
+	pass = (sample != 0U) && ((limited % sample) == 0);
+	if (!pass) {
+		atomic_inc(&rl->suppressed);
+	}
+
+	return pass;
+}
+
+void log_rate_limit_set(uint16_t burst, uint16_t rate, uint16_t sample)
+{
+	rate_limit_burst = MAX(burst, 1);
+	rate_limit_rate = rate;
+	rate_limit_sample = sample;
+}
+
+void log_rate_limit_get(uint16_t *burst, uint16_t *rate, uint16_t *sample)
+{
+	*burst = rate_limit_burst;
+	*rate = rate_limit_rate;
+	*sample = rate_limit_sample;
+}
+
+uint32_t log_rate_limit_suppressed_get(uint32_t source_id, uint32_t level)
+{
+	struct log_source_dynamic_data *source;
+
+	if (source_id >= log_sources_count() ||
+	    level < LOG_LEVEL_ERR || level > LOG_LEVEL_DBG) {
+		return 0;
+	}
+
+	source = &__log_dynamic_start[source_id];
+
+	return (uint32_t)atomic_get(&source->rate_limit[level - 1U].suppressed);
+}
+
+void log_rate_limit_reset(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	for (uint32_t i = 0; i < log_sources_count(); i++) {
+		struct log_source_rate_limit *rl =
+			__log_dynamic_start[i].rate_limit;
+
+		for (int j = 0; j < LOG_LEVEL_DBG; j++, rl++) {
+			atomic_set(&rl->used, 0);
+			atomic_set(&rl->limited, 0);
+			atomic_set(&rl->suppressed, 0);
+			atomic_set(&rl->stamp, now);
+		}
+	}
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
 uint32_t log_src_cnt_get(uint32_t domain_id)
 {
 	return log_sources_count();
@@ -1311,7 +1498,23 @@ void log_hexdump_from_user(struct log_msg_ids src_level, const char *metadata,
 
 void z_log_msg2_init(void)
 {
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = buf32[i];
+		config.size = ARRAY_SIZE(buf32[i]);
+		mpsc_pbuf_init(&log_buffers[i], &config);
+	}
+}
+
+/* Get the buffer from which the message was allocated. */
+static struct mpsc_pbuf_buffer *msg_buffer(void *msg)
+{
+	if (LOG_BUFFER_CNT == 1) {
+		return &log_buffers[0];
+	}
+
+	return &log_buffers[((uint32_t *)msg - buf32[0]) / LOG_BUFFER_WLEN];
 }
 
 static uint32_t log_diff_timestamp(void)
@@ -1329,7 +1532,7 @@ void z_log_msg2_put_trace(struct log_msg2_trace trace)
 
 	trace.hdr.timestamp = IS_ENABLED(CONFIG_LOG_TRACE_SHORT_TIMESTAMP) ?
 				log_diff_timestamp() : timestamp_func();
-	mpsc_pbuf_put_word(&log_buffer, generic.buf);
+	mpsc_pbuf_put_word(&log_buffers[cpu_buffer_idx()], generic.buf);
 }
 
 void z_log_msg2_put_trace_ptr(struct log_msg2_trace trace, void *data)
@@ -1340,12 +1543,14 @@ void z_log_msg2_put_trace_ptr(struct log_msg2_trace trace, void *data)
 
 	trace.hdr.timestamp = IS_ENABLED(CONFIG_LOG_TRACE_SHORT_TIMESTAMP) ?
 				log_diff_timestamp() : timestamp_func();
-	mpsc_pbuf_put_word_ext(&log_buffer, generic.buf, data);
+	mpsc_pbuf_put_word_ext(&log_buffers[cpu_buffer_idx()], generic.buf,
+			       data);
 }
 
 struct log_msg2 *z_log_msg2_alloc(uint32_t wlen)
 {
-	return (struct log_msg2 *)mpsc_pbuf_alloc(&log_buffer, wlen,
+	return (struct log_msg2 *)mpsc_pbuf_alloc(&log_buffers[cpu_buffer_idx()],
+				wlen,
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
 }
 
@@ -1363,27 +1568,86 @@ void z_log_msg2_commit(struct log_msg2 *msg)
 		return;
 	}
 
-	mpsc_pbuf_commit(&log_buffer, (union mpsc_pbuf_generic *)msg);
+	mpsc_pbuf_commit(msg_buffer(msg), (union mpsc_pbuf_generic *)msg);
 
 	if (IS_ENABLED(CONFIG_LOG2_MODE_DEFERRED)) {
 		z_log_msg_post_finalize();
 	}
 }
 
+/* Return true if message @p a was created before message @p b. Traces are
+ * always treated as the oldest ones since their timestamp may be truncated
+ * (CONFIG_LOG_TRACE_SHORT_TIMESTAMP) and is not compared with the one of
+ * log messages.
+ */
+static bool msg_before(union log_msg2_generic *a, union log_msg2_generic *b)
+{
+	log_timestamp_t diff;
+
+	if (!z_log_item_is_msg(a) || !z_log_item_is_msg(b)) {
+		return !z_log_item_is_msg(a);
+	}
+
+	/* Wrap safe comparison. */
+	diff = b->log.hdr.timestamp - a->log.hdr.timestamp;
+
+	return diff <= ((log_timestamp_t)-1 / 2);
+}
+
 union log_msg2_generic *z_log_msg2_claim(void)
 {
-	return (union log_msg2_generic *)mpsc_pbuf_claim(&log_buffer);
+	union log_msg2_generic *msg = NULL;
+	k_spinlock_key_t key;
+	int oldest = -1;
+
+	if (LOG_BUFFER_CNT == 1) {
+		return (union log_msg2_generic *)mpsc_pbuf_claim(&log_buffers[0]);
+	}
+
+	/* Each buffer is in order so the oldest message is one of the
+	 * buffer heads. At most one message per buffer is kept claimed.
+	 */
+	key = k_spin_lock(&claim_lock);
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if (pending_msg[i] == NULL) {
+			pending_msg[i] = (union log_msg2_generic *)
+					mpsc_pbuf_claim(&log_buffers[i]);
+		}
+
+		if (pending_msg[i] != NULL &&
+		    (oldest < 0 || msg_before(pending_msg[i],
+					      pending_msg[oldest]))) {
+			oldest = i;
+		}
+	}
+
+	if (oldest >= 0) {
+		msg = pending_msg[oldest];
+		pending_msg[oldest] = NULL;
+	}
+
+	k_spin_unlock(&claim_lock, key);
+
+	return msg;
 }
 
 void z_log_msg2_free(union log_msg2_generic *msg)
 {
-	mpsc_pbuf_free(&log_buffer, (union mpsc_pbuf_generic *)msg);
+	mpsc_pbuf_free(msg_buffer(msg), (union mpsc_pbuf_generic *)msg);
 }
 
 
 bool z_log_msg2_pending(void)
 {
-	return mpsc_pbuf_is_pending(&log_buffer);
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if (pending_msg[i] != NULL ||
+		    mpsc_pbuf_is_pending(&log_buffers[i])) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 static void log_process_thread_timer_expiry_fn(struct k_timer *timer)
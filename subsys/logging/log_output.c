@@ -5,6 +5,7 @@
  */
 
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
 #include <sys/__assert.h>
@@ -586,6 +587,11 @@ void log_output_msg2_process(const struct log_output *output,
 	bool raw_string = (level == LOG_LEVEL_INTERNAL_RAW_STRING);
 	uint32_t prefix_offset;
 
+	if (IS_ENABLED(CONFIG_LOG_OUTPUT_DICTIONARY)) {
+		log_dict_output_msg2_process(output, msg, flags);
+		return;
+	}
+
 	if (IS_ENABLED(CONFIG_LOG_MIPI_SYST_ENABLE) &&
 	    flags & LOG_OUTPUT_FLAG_FORMAT_SYST) {
 		__ASSERT_NO_MSG(0);
@@ -730,6 +736,11 @@ void log_output_dropped_process(const struct log_output *output, uint32_t cnt)
 			" messages dropped ---\r\n" DROPPED_COLOR_POSTFIX;
 	log_output_func_t outf = output->func;
 
+	if (IS_ENABLED(CONFIG_LOG_OUTPUT_DICTIONARY)) {
+		log_dict_output_dropped_process(output, cnt);
+		return;
+	}
+
 	cnt = MIN(cnt, 9999);
 	len = snprintk(buf, sizeof(buf), "%d", cnt);
 
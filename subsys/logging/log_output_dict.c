@@ -10,7 +10,9 @@
 #include <logging/log_output.h>
 #include <logging/log_output_dict.h>
 #include <sys/__assert.h>
+#include <sys/crc.h>
 #include <sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,6 +26,54 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Write data through the output buffer so that the backend receives the
+ * record in as few chunks as possible (e.g. one datagram per record).
+ */
+static void dict_write(const struct log_output *output, const void *data,
+		       size_t len, uint16_t *crc)
+{
+	const uint8_t *src = data;
+	size_t chunk;
+
+	if (crc != NULL) {
+		*crc = crc16_ccitt(*crc, src, len);
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
+		buffer_write(output->func, (uint8_t *)src, len,
+			     output->control_block->ctx);
+		return;
+	}
+
+	while (len > 0) {
+		if (output->control_block->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - output->control_block->offset);
+		memcpy(&output->buf[output->control_block->offset], src, chunk);
+		output->control_block->offset += chunk;
+		src += chunk;
+		len -= chunk;
+	}
+}
+
+static void frame_start(const struct log_output *output, size_t len)
+{
+	struct log_dict_output_frame_hdr_t hdr = {
+		.sync = { LOG_DICT_OUTPUT_FRAME_SYNC0,
+			  LOG_DICT_OUTPUT_FRAME_SYNC1 },
+		.len = len,
+	};
+
+	dict_write(output, &hdr, sizeof(hdr), NULL);
+}
+
+static void frame_end(const struct log_output *output, uint16_t crc)
+{
+	dict_write(output, &crc, sizeof(crc), NULL);
+}
+
 void log_dict_output_msg2_process(const struct log_output *output,
 				  struct log_msg2 *msg, uint32_t flags)
 {
@@ -44,19 +94,29 @@ void log_dict_output_msg2_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output);
+	size_t pkg_len, data_len;
+	uint8_t *pkg = log_msg2_get_package(msg, &pkg_len);
+	uint8_t *data = log_msg2_get_data(msg, &data_len);
+	uint16_t crc = 0xFFFF;
+	uint16_t *crcp = NULL;
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		frame_start(output, sizeof(output_hdr) + pkg_len + data_len);
+		crcp = &crc;
+	}
+
+	dict_write(output, &output_hdr, sizeof(output_hdr), crcp);
 
-	size_t len;
-	uint8_t *data = log_msg2_get_package(msg, &len);
+	if (pkg_len > 0U) {
+		dict_write(output, pkg, pkg_len, crcp);
+	}
 
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (data_len > 0U) {
+		dict_write(output, data, data_len, crcp);
 	}
 
-	data = log_msg2_get_data(msg, &len);
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		frame_end(output, crc);
 	}
 
 	log_output_flush(output);
@@ -65,10 +125,22 @@ void log_dict_output_msg2_process(const struct log_output *output,
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
 	struct log_dict_output_dropped_msg_t msg;
+	uint16_t crc = 0xFFFF;
+	uint16_t *crcp = NULL;
 
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output);
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		frame_start(output, sizeof(msg));
+		crcp = &crc;
+	}
+
+	dict_write(output, &msg, sizeof(msg), crcp);
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		frame_end(output, crc);
+	}
+
+	log_output_flush(output);
 }
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <stddef.h>
 #include <string.h>
 #include <sys/byteorder.h>
+#include <kernel_structs.h>
 
 #include <net/buf.h>
 
@@ -74,6 +75,124 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+/* Only the buffers of fixed size pools are cached: the other pools allocate
+ * their data from a shared heap anyway.
+ */
+static bool cpu_cache_enabled(struct net_buf_pool *pool)
+{
+	return pool->alloc->cb == &net_buf_fixed_cb;
+}
+
+bool net_buf_cpu_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_cpu_cache *cache;
+	k_spinlock_key_t key;
+	bool cached = false;
+	unsigned int irq;
+
+	if (!cpu_cache_enabled(pool)) {
+		return false;
+	}
+
+	/* The thread can't migrate to another CPU with interrupts locked */
+	irq = arch_irq_lock();
+	cache = &pool->cpu_cache[_current_cpu->id];
+	key = k_spin_lock(&cache->lock);
+
+	/* Waiting threads only get the buffers put in the LIFO */
+	if (!atomic_get(&pool->waiters) &&
+	    cache->count < ARRAY_SIZE(cache->bufs)) {
+		cache->bufs[cache->count++] = buf;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	return cached;
+}
+
+static struct net_buf *cpu_cache_get(struct net_buf_pool *pool)
+{
+	struct net_buf_cpu_cache *cache;
+	struct net_buf *buf = NULL;
+	k_spinlock_key_t key;
+	unsigned int irq;
+
+	if (!cpu_cache_enabled(pool)) {
+		return NULL;
+	}
+
+	irq = arch_irq_lock();
+	cache = &pool->cpu_cache[_current_cpu->id];
+	key = k_spin_lock(&cache->lock);
+
+	if (cache->count) {
+		buf = cache->bufs[--cache->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	return buf;
+}
+
+/* Move the buffers cached by all the CPUs to the LIFO. Called with
+ * pool->waiters incremented, so that no buffer gets cached afterwards.
+ */
+static void cpu_cache_flush(struct net_buf_pool *pool)
+{
+	struct net_buf *bufs[CONFIG_NET_BUF_CPU_CACHE_SIZE];
+
+	if (!cpu_cache_enabled(pool)) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(pool->cpu_cache); i++) {
+		struct net_buf_cpu_cache *cache = &pool->cpu_cache[i];
+		k_spinlock_key_t key;
+		uint8_t count;
+
+		key = k_spin_lock(&cache->lock);
+		count = cache->count;
+		memcpy(bufs, cache->bufs, count * sizeof(bufs[0]));
+		cache->count = 0U;
+		k_spin_unlock(&cache->lock, key);
+
+		while (count) {
+			k_lifo_put(&pool->free, bufs[--count]);
+		}
+	}
+}
+#endif /* CONFIG_NET_BUF_CPU_CACHE */
+
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+static void alloc_trace(struct net_buf *buf, void *site)
+{
+	buf->trace.site = site;
+	buf->trace.owner = k_current_get();
+	buf->trace.time = k_uptime_get_32();
+}
+
+void net_buf_pool_trace_foreach(struct net_buf_pool *pool,
+				net_buf_trace_cb_t cb, void *user_data)
+{
+	uint16_t count = pool->buf_count - pool->uninit_count;
+
+	/* Buffers which were never allocated are at the end of the array,
+	 * the free ones have no reference.
+	 */
+	for (uint16_t i = 0; i < count; i++) {
+		struct net_buf *buf = &pool->__bufs[i];
+
+		if (buf->ref) {
+			cb(buf, user_data);
+		}
+	}
+}
+#endif /* CONFIG_NET_BUF_ALLOC_TRACE */
+
 void net_buf_reset(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf->flags == 0U);
@@ -238,6 +357,13 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+	buf = cpu_cache_get(pool);
+	if (buf) {
+		goto success;
+	}
+#endif
+
 	/* We need to lock interrupts temporarily to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -270,6 +396,14 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	irq_unlock(key);
 
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+	/* Buffers freed from now on go to the LIFO, where this thread can
+	 * get them.
+	 */
+	atomic_inc(&pool->waiters);
+	cpu_cache_flush(pool);
+#endif
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -298,6 +432,9 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 	}
 #else
 	buf = k_lifo_get(&pool->free, timeout);
+#endif
+#if defined(CONFIG_NET_BUF_CPU_CACHE)
+	atomic_dec(&pool->waiters);
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
@@ -344,6 +481,9 @@ success:
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 	atomic_dec(&pool->avail_count);
 	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+#endif
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	alloc_trace(buf, __builtin_return_address(0));
 #endif
 	return buf;
 }
@@ -354,17 +494,31 @@ struct net_buf *net_buf_alloc_fixed_debug(struct net_buf_pool *pool,
 					  int line)
 {
 	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
+	struct net_buf *buf;
 
-	return net_buf_alloc_len_debug(pool, fixed->data_size, timeout, func,
-				       line);
+	buf = net_buf_alloc_len_debug(pool, fixed->data_size, timeout, func,
+				      line);
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	if (buf) {
+		alloc_trace(buf, __builtin_return_address(0));
+	}
+#endif
+	return buf;
 }
 #else
 struct net_buf *net_buf_alloc_fixed(struct net_buf_pool *pool,
 				    k_timeout_t timeout)
 {
 	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
+	struct net_buf *buf;
 
-	return net_buf_alloc_len(pool, fixed->data_size, timeout);
+	buf = net_buf_alloc_len(pool, fixed->data_size, timeout);
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	if (buf) {
+		alloc_trace(buf, __builtin_return_address(0));
+	}
+#endif
+	return buf;
 }
 #endif
 
@@ -392,6 +546,9 @@ struct net_buf *net_buf_alloc_with_data(struct net_buf_pool *pool,
 
 	net_buf_simple_init_with_data(&buf->b, data, size);
 	buf->flags = NET_BUF_EXTERNAL_DATA;
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	alloc_trace(buf, __builtin_return_address(0));
+#endif
 
 	return buf;
 }
@@ -1245,6 +1245,22 @@ static int get_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int get_context_stats(struct net_context *context,
+			     void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_STATS)
+	memcpy(value, &context->stats, sizeof(struct net_stats_context));
+
+	if (len) {
+		*len = sizeof(struct net_stats_context);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1635,6 +1651,13 @@ static int context_sendto(struct net_context *context,
 		net_pkt_set_priority(pkt, priority);
 	}
 
+	/* The TX queue time of this context is measured from here until
+	 * the packet is handed to the network driver.
+	 */
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS)) {
+		net_pkt_set_queue_time(pkt, k_cycle_get_32());
+	}
+
 	/* If there is ancillary data in msghdr, then we need to add that
 	 * to net_pkt as there is no other way to store it.
 	 */
@@ -1839,6 +1862,7 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 	 * the packet.
 	 */
 	if (!context->recv_cb) {
+		net_stats_update_context_drop(context);
 		goto unlock;
 	}
 
@@ -2236,6 +2260,10 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = set_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_STATS:
+		/* Statistics are read-only */
+		ret = -EINVAL;
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2273,6 +2301,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = get_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_STATS:
+		ret = get_context_stats(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
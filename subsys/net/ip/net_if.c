@@ -257,6 +257,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
+		if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS) && context) {
+			net_stats_update_context_tx_queue_time(
+				context, net_pkt_queue_time(pkt),
+				k_cycle_get_32());
+		}
+
 		status = net_if_l2(iface)->send(iface, pkt);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
@@ -302,6 +308,14 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		net_stats_update_bytes_sent(iface, status);
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS) && context) {
+		if (status < 0) {
+			net_stats_update_context_drop(context);
+		} else {
+			net_stats_update_context_pkt_sent(context);
+		}
+	}
+
 	if (context) {
 		NET_DBG("Calling context send cb %p status %d",
 			context, status);
@@ -1389,6 +1389,42 @@ static void context_cb(struct net_context *context, void *user_data)
 
 	(*count)++;
 }
+
+#if defined(CONFIG_NET_CONTEXT_STATS)
+static uint32_t context_stats_avg(uint64_t sum, net_stats_t count)
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	return (uint32_t)(sum / (uint64_t)count);
+}
+
+static void context_stats_cb(struct net_context *context, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	struct net_stats_context stats;
+	size_t len = sizeof(stats);
+
+	if (net_context_get_option(context, NET_OPT_STATS, &stats, &len) < 0) {
+		return;
+	}
+
+	PR("[%2d] %p\t%u/%u\t%u/%u\t%u\t%u\t%u ms\t%u us\t%u us\n",
+	   (*count) + 1, context,
+	   stats.pkts.tx, stats.bytes.sent,
+	   stats.pkts.rx, stats.bytes.received,
+	   stats.drop, stats.retransmit, stats.rtt,
+	   context_stats_avg(stats.rx_queue_time.sum,
+			     stats.rx_queue_time.count),
+	   context_stats_avg(stats.tx_queue_time.sum,
+			     stats.tx_queue_time.count));
+
+	(*count)++;
+}
+#endif /* CONFIG_NET_CONTEXT_STATS */
 #endif /* CONFIG_NET_OFFLOAD || CONFIG_NET_NATIVE */
 
 #if CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -2015,6 +2051,17 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 		PR("No connections\n");
 	}
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+	if (count > 0) {
+		PR("\n     Context   \tSent pkts/bytes\tRecv pkts/bytes\t"
+		   "Drop\tRexmit\tRTT\tRX queue\tTX queue\n");
+
+		count = 0;
+
+		net_context_foreach(context_stats_cb, &user_data);
+	}
+#endif
+
 #if CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG
 	PR("\n     Handler    Callback  \tProto\tLocal           \tRemote\n");
 
@@ -3645,6 +3692,44 @@ static void context_info(struct net_context *context, void *user_data)
 	info->pos++;
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 }
+
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+static void buf_trace_cb(struct net_buf *buf, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	const char *name = k_thread_name_get(buf->trace.owner);
+
+	if (*count == 0) {
+		PR("Buf\t\tRef\tAge (ms)\tSite\t\tOwner\n");
+	}
+
+	PR("%p\t%u\t%u\t\t%p\t%p %s\n", buf, buf->ref,
+	   k_uptime_get_32() - buf->trace.time, buf->trace.site,
+	   buf->trace.owner, name ? name : "");
+
+	(*count)++;
+}
+
+static void buf_trace_print(const struct shell *shell,
+			    struct net_buf_pool *pool, const char *name)
+{
+	struct net_shell_user_data user_data;
+	int count = 0;
+
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	PR("\nAllocated %s buffers:\n", name);
+
+	net_buf_pool_trace_foreach(pool, buf_trace_cb, &user_data);
+
+	if (count == 0) {
+		PR("None\n");
+	}
+}
+#endif /* CONFIG_NET_BUF_ALLOC_TRACE */
 #endif /* CONFIG_NET_OFFLOAD || CONFIG_NET_NATIVE */
 
 static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
@@ -3689,6 +3774,11 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	buf_trace_print(shell, rx_data, "RX DATA");
+	buf_trace_print(shell, tx_data, "TX DATA");
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
@@ -619,6 +619,85 @@ static inline void net_stats_add_suspend_end_time(struct net_if *iface,
 #define net_stats_add_suspend_end_time(iface, time)
 #endif
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+#include <net/net_context.h>
+
+static inline void net_stats_update_context_bytes_sent(struct net_context *ctx,
+						       size_t bytes)
+{
+	ctx->stats.bytes.sent += bytes;
+}
+
+static inline void net_stats_update_context_bytes_recv(struct net_context *ctx,
+						       size_t bytes)
+{
+	ctx->stats.bytes.received += bytes;
+}
+
+static inline void net_stats_update_context_pkt_sent(struct net_context *ctx)
+{
+	ctx->stats.pkts.tx++;
+}
+
+static inline void net_stats_update_context_pkt_recv(struct net_context *ctx)
+{
+	ctx->stats.pkts.rx++;
+}
+
+static inline void net_stats_update_context_drop(struct net_context *ctx)
+{
+	ctx->stats.drop++;
+}
+
+static inline void net_stats_update_context_retransmit(struct net_context *ctx)
+{
+	ctx->stats.retransmit++;
+}
+
+/* Smoothed round trip time, alpha = 1/8 as in RFC 6298 */
+static inline void net_stats_update_context_rtt(struct net_context *ctx,
+						uint32_t rtt_ms)
+{
+	if (ctx->stats.rtt == 0U) {
+		ctx->stats.rtt = rtt_ms;
+	} else {
+		ctx->stats.rtt = (7U * ctx->stats.rtt + rtt_ms) / 8U;
+	}
+}
+
+static inline void net_stats_update_context_rx_queue_time(
+					struct net_context *ctx,
+					uint32_t start_time,
+					uint32_t end_time)
+{
+	uint32_t diff = end_time - start_time;
+
+	ctx->stats.rx_queue_time.sum += k_cyc_to_ns_floor64(diff) / 1000;
+	ctx->stats.rx_queue_time.count += 1;
+}
+
+static inline void net_stats_update_context_tx_queue_time(
+					struct net_context *ctx,
+					uint32_t start_time,
+					uint32_t end_time)
+{
+	uint32_t diff = end_time - start_time;
+
+	ctx->stats.tx_queue_time.sum += k_cyc_to_ns_floor64(diff) / 1000;
+	ctx->stats.tx_queue_time.count += 1;
+}
+#else
+#define net_stats_update_context_bytes_sent(ctx, bytes)
+#define net_stats_update_context_bytes_recv(ctx, bytes)
+#define net_stats_update_context_pkt_sent(ctx)
+#define net_stats_update_context_pkt_recv(ctx)
+#define net_stats_update_context_drop(ctx)
+#define net_stats_update_context_retransmit(ctx)
+#define net_stats_update_context_rtt(ctx, rtt_ms)
+#define net_stats_update_context_rx_queue_time(ctx, start_time, end_time)
+#define net_stats_update_context_tx_queue_time(ctx, start_time, end_time)
+#endif /* CONFIG_NET_CONTEXT_STATS */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT) \
 	&& defined(CONFIG_NET_NATIVE)
 /* A simple periodic statistic printer, used only in net core */
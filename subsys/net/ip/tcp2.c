@@ -915,6 +915,52 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_CONTEXT_STATS)
+static void tcp_stats_data_queued(struct tcp *conn)
+{
+	if (tcp_unsent_len(conn) == 0) {
+		conn->unsent_time = k_cycle_get_32();
+	}
+}
+
+static void tcp_stats_data_sent(struct tcp *conn, uint32_t seq_end)
+{
+	net_stats_update_context_pkt_sent(conn->context);
+
+	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		net_stats_update_context_retransmit(conn->context);
+
+		/* Karn's algorithm, do not time retransmitted segments */
+		conn->rtt_pending = false;
+		return;
+	}
+
+	net_stats_update_context_tx_queue_time(conn->context,
+					       conn->unsent_time,
+					       k_cycle_get_32());
+
+	if (!conn->rtt_pending) {
+		conn->rtt_pending = true;
+		conn->rtt_seq = seq_end;
+		conn->rtt_start = k_uptime_get_32();
+	}
+}
+
+static void tcp_stats_data_acked(struct tcp *conn, uint32_t ack)
+{
+	if (conn->rtt_pending && net_tcp_seq_cmp(ack, conn->rtt_seq) >= 0) {
+		conn->rtt_pending = false;
+		net_stats_update_context_rtt(conn->context,
+					     k_uptime_get_32() -
+					     conn->rtt_start);
+	}
+}
+#else
+#define tcp_stats_data_queued(conn)
+#define tcp_stats_data_sent(conn, seq_end)
+#define tcp_stats_data_acked(conn, ack)
+#endif /* CONFIG_NET_CONTEXT_STATS */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
@@ -944,6 +990,8 @@ static int tcp_send_data(struct tcp *conn)
 	if (ret == 0) {
 		conn->unacked_len += len;
 
+		tcp_stats_data_sent(conn, conn->seq + conn->unacked_len);
+
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
@@ -1821,6 +1869,7 @@ next_state:
 					"(total=%zu)", conn, len_acked,
 					conn->send_data_total);
 				net_stats_update_tcp_seg_drop(conn->iface);
+				net_stats_update_context_drop(conn->context);
 				tcp_out(conn, RST);
 				conn_state(conn, TCP_CLOSED);
 				break;
@@ -1834,6 +1883,7 @@ next_state:
 			}
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
+			tcp_stats_data_acked(conn, th_ack(th));
 
 			conn_send_data_dump(conn);
 
@@ -1877,6 +1927,7 @@ next_state:
 				tcp_out(conn, ACK); /* peer has resent */
 
 				net_stats_update_tcp_seg_ackerr(conn->iface);
+				net_stats_update_context_drop(conn->context);
 			} else if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
 				tcp_out_of_order_data(conn, pkt, len,
 						      th_seq(th));
@@ -2112,6 +2163,8 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 
 	len = net_pkt_get_len(pkt);
 
+	tcp_stats_data_queued(conn);
+
 	if (conn->send_data->buffer) {
 		orig_buf = net_buf_frag_last(conn->send_data->buffer);
 	}
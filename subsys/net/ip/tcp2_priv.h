@@ -250,6 +250,12 @@ struct tcp { /* TCP connection */
 	uint16_t recv_win;
 	uint16_t send_win;
 	uint8_t send_data_retries;
+#if defined(CONFIG_NET_CONTEXT_STATS)
+	uint32_t rtt_seq;     /* sequence number acking the timed segment */
+	uint32_t rtt_start;   /* uptime in ms when the timed segment was sent */
+	uint32_t unsent_time; /* cycles when the oldest unsent data was queued */
+	bool rtt_pending : 1;
+#endif
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
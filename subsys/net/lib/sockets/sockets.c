@@ -139,6 +139,7 @@ static void zsock_flush_queue(struct net_context *ctx)
 			net_context_put(p);
 		} else {
 			NET_DBG("discarding pkt %p", p);
+			net_stats_update_context_drop(ctx);
 			net_pkt_unref(p);
 		}
 	}
@@ -379,6 +380,13 @@ static void zsock_received_cb(struct net_context *ctx,
 
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS)) {
+		net_stats_update_context_pkt_recv(ctx);
+		net_stats_update_context_bytes_recv(
+					ctx, net_pkt_remaining_data(pkt));
+		net_pkt_set_queue_time(pkt, k_cycle_get_32());
+	}
+
 	k_fifo_put(&ctx->recv_q, pkt);
 
 unlock:
@@ -685,6 +693,8 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		break;
 	}
 
+	net_stats_update_context_bytes_sent(ctx, status);
+
 	return status;
 }
 
@@ -732,6 +742,8 @@ ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 		return -1;
 	}
 
+	net_stats_update_context_bytes_sent(ctx, status);
+
 	return status;
 }
 
@@ -1086,6 +1098,12 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS) &&
+	    !(flags & ZSOCK_MSG_PEEK)) {
+		net_stats_update_context_rx_queue_time(
+			ctx, net_pkt_queue_time(pkt), k_cycle_get_32());
+	}
+
 	if (!(flags & ZSOCK_MSG_PEEK)) {
 		net_pkt_unref(pkt);
 	} else {
@@ -1198,6 +1216,12 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 						pkt, k_cycle_get_32());
 				}
 
+				if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS)) {
+					net_stats_update_context_rx_queue_time(
+						ctx, net_pkt_queue_time(pkt),
+						k_cycle_get_32());
+				}
+
 				net_pkt_unref(pkt);
 			}
 		} else {
@@ -1683,6 +1707,27 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			return 0;
 		}
+
+		case SO_NET_STATS:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_STATS)) {
+				size_t len = sizeof(struct net_stats_context);
+
+				if (*optlen != len) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_STATS,
+							     optval, &len);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+			break;
 		}
 
 		break;
@@ -33,11 +33,27 @@ extern "C" {
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
 
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+struct settings_nvs_cache_entry {
+	uint16_t name_id;
+	uint16_t name_hash;
+};
+#endif
+
 struct settings_nvs {
 	struct settings_store cf_store;
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const char *flash_dev_name;
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+	/* Name IDs with the hash of the name, entries with a name_id not
+	 * above NVS_NAMECNT_ID are unused. The cache is complete when all the
+	 * names have been loaded and no entry was evicted since then.
+	 */
+	struct settings_nvs_cache_entry cache[CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE];
+	uint16_t cache_next;
+	bool cache_complete;
+#endif
 };
 
 /* register nvs to be a source of settings */
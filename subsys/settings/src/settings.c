@@ -24,6 +24,111 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Static and dynamic handlers sorted by name. It is not used once more
+ * handlers are registered than it can hold.
+ */
+static struct settings_handler_static
+	*handler_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+static size_t handler_index_cnt;
+static bool handler_index_valid;
+
+/* Compare a handler name with the first len characters of name */
+static int handler_name_cmp(const char *hname, const char *name, size_t len)
+{
+	int rc = strncmp(hname, name, len);
+
+	if ((rc == 0) && (hname[len] != '\0')) {
+		rc = 1;
+	}
+
+	return rc;
+}
+
+/* Binary search of the first len characters of name. Returns the position of
+ * the matching handler or, if none is found, of the first handler with a
+ * greater name.
+ */
+static size_t handler_index_find(const char *name, size_t len, bool *found)
+{
+	size_t lo = 0;
+	size_t hi = handler_index_cnt;
+	size_t mid;
+	int rc;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		rc = handler_name_cmp(handler_index[mid]->name, name, len);
+		if (rc == 0) {
+			*found = true;
+			return mid;
+		}
+
+		if (rc < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	*found = false;
+	return lo;
+}
+
+static void handler_index_add(struct settings_handler_static *ch)
+{
+	size_t pos;
+	bool found;
+
+	if (handler_index_cnt == ARRAY_SIZE(handler_index)) {
+		LOG_WRN("Handler index full, using linear lookup");
+		handler_index_valid = false;
+		return;
+	}
+
+	pos = handler_index_find(ch->name, strlen(ch->name), &found);
+	memmove(&handler_index[pos + 1], &handler_index[pos],
+		(handler_index_cnt - pos) * sizeof(handler_index[0]));
+	handler_index[pos] = ch;
+	handler_index_cnt++;
+}
+
+/* Look up the handlers of the name prefixes ending at a name element
+ * boundary, the longest prefix with a handler is the best match.
+ */
+static struct settings_handler_static *handler_index_lookup(const char *name,
+							   const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	size_t len = 0;
+	size_t pos;
+	bool found;
+
+	while (1) {
+		len += settings_name_next(&name[len], NULL);
+
+		pos = handler_index_find(name, len, &found);
+		if (found) {
+			bestmatch = handler_index[pos];
+			if (next) {
+				*next = (name[len] == SETTINGS_NAME_SEPARATOR) ?
+					&name[len + 1] : NULL;
+			}
+		} else if ((pos == handler_index_cnt) ||
+			   strncmp(handler_index[pos]->name, name, len)) {
+			/* No handler name starts with this prefix */
+			break;
+		}
+
+		if (name[len] != SETTINGS_NAME_SEPARATOR) {
+			break;
+		}
+		len++;
+	}
+
+	return bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 void settings_store_init(void);
 
@@ -32,6 +137,13 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	handler_index_cnt = 0;
+	handler_index_valid = true;
+	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		handler_index_add(ch);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 	settings_store_init();
 }
 
@@ -56,6 +168,11 @@ int settings_register(struct settings_handler *handler)
 		}
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (handler_index_valid) {
+		handler_index_add((struct settings_handler_static *)handler);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 end:
 	k_mutex_unlock(&settings_lock);
@@ -145,6 +262,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (handler_index_valid && name) {
+		return handler_index_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 	Z_STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -12,6 +12,7 @@
 #include "settings/settings_nvs.h"
 #include "settings_priv.h"
 #include <storage/flash_map.h>
+#include <sys/crc.h>
 
 #include <logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -48,6 +49,87 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+static uint16_t settings_nvs_cache_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, (const uint8_t *)name, strlen(name));
+}
+
+static void settings_nvs_cache_clear(struct settings_nvs *cf)
+{
+	for (int i = 0; i < ARRAY_SIZE(cf->cache); i++) {
+		cf->cache[i].name_id = NVS_NAMECNT_ID;
+	}
+	cf->cache_next = 0;
+	cf->cache_complete = false;
+}
+
+static void settings_nvs_cache_add(struct settings_nvs *cf, const char *name,
+				   uint16_t name_id)
+{
+	struct settings_nvs_cache_entry *entry = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(cf->cache); i++) {
+		if (cf->cache[i].name_id <= NVS_NAMECNT_ID) {
+			entry = &cf->cache[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		/* Cache is full, evict the entries in a round robin way */
+		entry = &cf->cache[cf->cache_next];
+		cf->cache_next = (cf->cache_next + 1) % ARRAY_SIZE(cf->cache);
+		cf->cache_complete = false;
+	}
+
+	entry->name_id = name_id;
+	entry->name_hash = settings_nvs_cache_hash(name);
+}
+
+static void settings_nvs_cache_remove(struct settings_nvs *cf,
+				      uint16_t name_id)
+{
+	for (int i = 0; i < ARRAY_SIZE(cf->cache); i++) {
+		if (cf->cache[i].name_id == name_id) {
+			cf->cache[i].name_id = NVS_NAMECNT_ID;
+		}
+	}
+}
+
+/* Return the name ID of name if it is in the cache, NVS_NAMECNT_ID otherwise.
+ * rdname is used as buffer to compare the names with matching hashes.
+ */
+static uint16_t settings_nvs_cache_match(struct settings_nvs *cf,
+					 const char *name, char *rdname,
+					 size_t len)
+{
+	uint16_t name_hash = settings_nvs_cache_hash(name);
+	ssize_t rc;
+
+	for (int i = 0; i < ARRAY_SIZE(cf->cache); i++) {
+		if ((cf->cache[i].name_id <= NVS_NAMECNT_ID) ||
+		    (cf->cache[i].name_hash != name_hash)) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->cache[i].name_id, rdname,
+			      len - 1);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[MIN(rc, len - 1)] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			return cf->cache[i].name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -77,6 +159,11 @@ static int settings_nvs_load(struct settings_store *cs,
 
 	name_id = cf->last_name_id + 1;
 
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+	settings_nvs_cache_clear(cf);
+	cf->cache_complete = true;
+#endif
+
 	while (1) {
 
 		name_id--;
@@ -114,6 +201,11 @@ static int settings_nvs_load(struct settings_store *cs,
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_add(cf, name, name_id);
+#endif
+
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -125,9 +217,54 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+	if (ret) {
+		/* Not all the names were loaded */
+		cf->cache_complete = false;
+	}
+#endif
+
 	return ret;
 }
 
+/* Find the name ID of name by reading all the stored names. Returns
+ * NVS_NAMECNT_ID if the name is not found, *free_id is then set to the lowest
+ * unused name ID.
+ */
+static uint16_t settings_nvs_name_find(struct settings_nvs *cf,
+				       const char *name, char *rdname,
+				       size_t len, uint16_t *free_id)
+{
+	uint16_t name_id = cf->last_name_id + 1;
+	ssize_t rc;
+
+	while (1) {
+		name_id--;
+		if (name_id == NVS_NAMECNT_ID) {
+			break;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len - 1);
+
+		if (rc < 0) {
+			/* Error or entry not found */
+			if (rc == -ENOENT) {
+				*free_id = name_id;
+			}
+			continue;
+		}
+
+		rdname[MIN(rc, len - 1)] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			break;
+		}
+	}
+
+	return name_id;
+}
+
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len)
 {
@@ -144,33 +281,32 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
-	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
-	write_name = true;
-
-	while (1) {
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
-		}
-
-		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
-
-		if (rc < 0) {
-			/* Error or entry not found */
-			if (rc == -ENOENT) {
-				write_name_id = name_id;
-			}
-			continue;
-		}
 
-		rdname[rc] = '\0';
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+	name_id = settings_nvs_cache_match(cf, name, rdname, sizeof(rdname));
+	if ((name_id == NVS_NAMECNT_ID) &&
+	    (!cf->cache_complete ||
+	     (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET))) {
+		/* The name may be stored without being in the cache, or all
+		 * the new name IDs are used and a free one has to be found.
+		 */
+		name_id = settings_nvs_name_find(cf, name, rdname,
+						 sizeof(rdname),
+						 &write_name_id);
+	}
+#else
+	name_id = settings_nvs_name_find(cf, name, rdname, sizeof(rdname),
+					 &write_name_id);
+#endif
 
-		if (strcmp(name, rdname)) {
-			continue;
+	if (name_id == NVS_NAMECNT_ID) {
+		if (delete) {
+			return 0;
 		}
-
-		if ((delete) && (name_id == cf->last_name_id)) {
+		write_name = true;
+	} else if (delete) {
+		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
 				       &cf->last_name_id, sizeof(uint16_t));
@@ -182,27 +318,25 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			}
 		}
 
-		if (delete) {
-			rc = nvs_delete(&cf->cf_nvs, name_id);
+		rc = nvs_delete(&cf->cf_nvs, name_id);
 
-			if (rc >= 0) {
-				rc = nvs_delete(&cf->cf_nvs, name_id +
-					NVS_NAME_ID_OFFSET);
-			}
-
-			if (rc < 0) {
-				return rc;
-			}
+		if (rc >= 0) {
+			rc = nvs_delete(&cf->cf_nvs, name_id +
+				NVS_NAME_ID_OFFSET);
+		}
 
-			return 0;
+		if (rc < 0) {
+			return rc;
 		}
-		write_name_id = name_id;
-		write_name = false;
-		break;
-	}
 
-	if (delete) {
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_remove(cf, name_id);
+#endif
+
 		return 0;
+	} else {
+		write_name_id = name_id;
+		write_name = false;
 	}
 
 	/* No free IDs left. */
@@ -223,6 +357,10 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		if (rc < 0) {
 			return rc;
 		}
+
+#ifdef CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_add(cf, name, write_name_id);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
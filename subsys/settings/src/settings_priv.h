@@ -121,6 +121,14 @@ void settings_line_io_init(int (*read_cb)(void *ctx, off_t off, char *buf,
 			  uint8_t io_rwbs);
 
 
+/* Stage a value in the current transaction. Returns 1 if there is no
+ * transaction in progress and the value must be saved directly.
+ */
+int settings_txn_stage(const char *name, const void *value, size_t val_len);
+
+/* Complete a transaction interrupted during an atomic commit. */
+int settings_txn_recover(void);
+
 extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
 extern struct settings_store *settings_save_dst;
@@ -103,6 +103,14 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+	if (IS_ENABLED(CONFIG_SETTINGS_TXN)) {
+		rc = settings_txn_stage(name, value, val_len);
+		if (rc <= 0) {
+			k_mutex_unlock(&settings_lock);
+			return rc;
+		}
+	}
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+#include <sys/byteorder.h>
+
+#include "settings/settings.h"
+#include "settings_priv.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+/* Name of the item holding the journal of an atomic commit */
+#define SETTINGS_TXN_JOURNAL "settings/txn"
+
+/* Staged items are stored one after the other as:
+ *	1 byte:  length of the name including the terminating '\0'
+ *	2 bytes: length of the value (little endian), 0 for a delete
+ *	name, value
+ * With CONFIG_SETTINGS_TXN_ATOMIC the same layout is used for the journal.
+ */
+#define TXN_HDR_LEN 3
+
+struct txn_item {
+	const char *name;
+	const uint8_t *value;
+	size_t val_len;
+	size_t len;
+};
+
+extern struct k_mutex settings_lock;
+
+static uint8_t txn_buf[CONFIG_SETTINGS_TXN_BUF_SIZE];
+static size_t txn_len;
+static k_tid_t txn_owner;
+static bool txn_overflow;
+
+/* Parse the item at offset off, returns false if there is no valid item. */
+static bool txn_item_get(const uint8_t *buf, size_t len, size_t off,
+			 struct txn_item *item)
+{
+	size_t name_len;
+
+	if (off + TXN_HDR_LEN > len) {
+		return false;
+	}
+
+	name_len = buf[off];
+	item->val_len = sys_get_le16(&buf[off + 1]);
+	item->len = TXN_HDR_LEN + name_len + item->val_len;
+	item->name = (const char *)&buf[off + TXN_HDR_LEN];
+	item->value = &buf[off + TXN_HDR_LEN + name_len];
+
+	return (name_len > 0) && (off + item->len <= len) &&
+	       (item->name[name_len - 1] == '\0');
+}
+
+/* Write the items to the back-end, the first error is returned but all the
+ * items are attempted.
+ */
+static int txn_items_save(struct settings_store *cs, const uint8_t *buf,
+			  size_t len)
+{
+	struct txn_item item;
+	int rc = 0;
+	int rc2;
+
+	if (cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	for (size_t off = 0; txn_item_get(buf, len, off, &item);
+	     off += item.len) {
+		rc2 = cs->cs_itf->csi_save(cs, item.name,
+					   item.val_len ?
+					   (const char *)item.value : NULL,
+					   item.val_len);
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	if (cs->cs_itf->csi_save_end) {
+		cs->cs_itf->csi_save_end(cs);
+	}
+
+	return rc;
+}
+
+/* Remove the staged item with the given name, if any. */
+static void txn_item_remove(const char *name)
+{
+	struct txn_item item;
+
+	for (size_t off = 0; txn_item_get(txn_buf, txn_len, off, &item);
+	     off += item.len) {
+		if (strcmp(item.name, name)) {
+			continue;
+		}
+
+		memmove(&txn_buf[off], &txn_buf[off + item.len],
+			txn_len - off - item.len);
+		txn_len -= item.len;
+		return;
+	}
+}
+
+int settings_txn_stage(const char *name, const void *value, size_t val_len)
+{
+	struct settings_store *cs = settings_save_dst;
+	size_t name_len;
+	int rc;
+
+	if (txn_owner != k_current_get()) {
+		return 1;
+	}
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	name_len = strlen(name) + 1;
+	if (!value) {
+		val_len = 0;
+	}
+
+	if ((name_len > UINT8_MAX) || (val_len > UINT16_MAX)) {
+		return -EINVAL;
+	}
+
+	/* Coalesce with a previous save of the same name */
+	txn_item_remove(name);
+
+	if (txn_len + TXN_HDR_LEN + name_len + val_len > sizeof(txn_buf)) {
+		if (IS_ENABLED(CONFIG_SETTINGS_TXN_ATOMIC)) {
+			txn_overflow = true;
+			return -ENOMEM;
+		}
+
+		LOG_DBG("Transaction buffer full, writing staged items");
+		rc = txn_items_save(cs, txn_buf, txn_len);
+		txn_len = 0;
+		if (rc) {
+			return rc;
+		}
+
+		if (TXN_HDR_LEN + name_len + val_len > sizeof(txn_buf)) {
+			return cs->cs_itf->csi_save(cs, name, value, val_len);
+		}
+	}
+
+	txn_buf[txn_len] = name_len;
+	sys_put_le16(val_len, &txn_buf[txn_len + 1]);
+	memcpy(&txn_buf[txn_len + TXN_HDR_LEN], name, name_len);
+	if (val_len) {
+		memcpy(&txn_buf[txn_len + TXN_HDR_LEN + name_len], value,
+		       val_len);
+	}
+	txn_len += TXN_HDR_LEN + name_len + val_len;
+
+	return 0;
+}
+
+int settings_txn_begin(void)
+{
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (txn_owner == k_current_get()) {
+		k_mutex_unlock(&settings_lock);
+		return -EBUSY;
+	}
+
+	/* The lock is kept until the transaction ends */
+	txn_owner = k_current_get();
+	txn_len = 0;
+	txn_overflow = false;
+
+	return 0;
+}
+
+static void txn_end(void)
+{
+	txn_owner = NULL;
+	txn_len = 0;
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_txn_commit(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc;
+
+	if (txn_owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	if (txn_overflow) {
+		txn_end();
+		return -ENOMEM;
+	}
+
+	if (!txn_len) {
+		txn_end();
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_SETTINGS_TXN_ATOMIC)) {
+		/* Once the journal is written the transaction is committed,
+		 * an interrupted write of the items is completed at the next
+		 * initialization.
+		 */
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+					  (const char *)txn_buf, txn_len);
+		if (rc) {
+			txn_end();
+			return rc;
+		}
+	}
+
+	rc = txn_items_save(cs, txn_buf, txn_len);
+
+	if (IS_ENABLED(CONFIG_SETTINGS_TXN_ATOMIC) && !rc) {
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, NULL, 0);
+	}
+
+	txn_end();
+
+	return rc;
+}
+
+void settings_txn_abort(void)
+{
+	if (txn_owner != k_current_get()) {
+		return;
+	}
+
+	txn_end();
+}
+
+#ifdef CONFIG_SETTINGS_TXN_ATOMIC
+static int txn_journal_load_cb(const char *key, size_t len,
+			       settings_read_cb read_cb, void *cb_arg,
+			       void *param)
+{
+	ssize_t rc;
+
+	if (key) {
+		/* Not the journal but an item below it */
+		return 0;
+	}
+
+	/* Some back-ends pass older values first, keep the last one */
+	txn_len = 0;
+
+	if (len > sizeof(txn_buf)) {
+		LOG_ERR("Transaction journal too long (%zu)", len);
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, txn_buf, len);
+	if (rc == (ssize_t)len) {
+		txn_len = len;
+	}
+
+	return 0;
+}
+#endif
+
+int settings_txn_recover(void)
+{
+#ifdef CONFIG_SETTINGS_TXN_ATOMIC
+	struct settings_store *cs = settings_save_dst;
+	int rc;
+
+	if (!cs) {
+		return 0;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	txn_len = 0;
+	rc = settings_load_subtree_direct(SETTINGS_TXN_JOURNAL,
+					  txn_journal_load_cb, NULL);
+	if (!rc && txn_len) {
+		LOG_INF("Completing interrupted settings transaction");
+		rc = txn_items_save(cs, txn_buf, txn_len);
+		if (!rc) {
+			rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+						  NULL, 0);
+		}
+	}
+	txn_len = 0;
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+#else
+	return 0;
+#endif
+}
@@ -39,6 +39,9 @@ static int settings_direct_loader(const char *key, size_t len,
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+			ctx->bytes_submitted = bytes_written;
+#endif
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
 				bytes_written, ctx->bytes_written);
@@ -74,11 +77,25 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+static int pipe_drain(struct stream_flash_ctx *ctx);
+#endif
+
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 {
 	int rc;
 	struct flash_pages_info page;
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	/* Pending writes may target the page */
+	if (ctx->pipe_cnt) {
+		rc = pipe_drain(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+#endif
+
 	rc = flash_get_page_info_by_offs(ctx->fdev, off, &page);
 	if (rc != 0) {
 		LOG_ERR("Error %d while getting page info", rc);
@@ -104,19 +121,275 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
+/* Pad the buffer to the write block size, return the length to write */
+static size_t buf_pad(struct stream_flash_ctx *ctx)
+{
+	size_t fill_length;
+	uint8_t filler;
+
+	fill_length = flash_get_write_block_size(ctx->fdev);
+	if (ctx->buf_bytes % fill_length) {
+		fill_length -= ctx->buf_bytes % fill_length;
+		filler = flash_get_parameters(ctx->fdev)->erase_value;
+
+		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+	} else {
+		fill_length = 0;
+	}
+
+	return ctx->buf_bytes + fill_length;
+}
+
+/* Read back written data into buf and pass it to the callback */
+static int buf_verify(struct stream_flash_ctx *ctx, uint8_t *buf, size_t len,
+		      size_t write_addr)
+{
+	int rc;
+
+	/* Invert to ensure that caller is able to discover a faulty
+	 * flash_read() even if no error code is returned.
+	 */
+	for (int i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
+	}
+
+	rc = flash_read(ctx->fdev, write_addr, buf, len);
+	if (rc != 0) {
+		LOG_ERR("flash read failed: %d", rc);
+		return rc;
+	}
+
+	rc = ctx->callback(buf, len, write_addr);
+	if (rc != 0) {
+		LOG_ERR("callback failed: %d", rc);
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+
+static void pipe_erase_done(const struct device *dev,
+			    struct flash_async_req *req, int result)
+{
+	struct stream_flash_ctx *ctx = req->user_data;
+
+	if (result != 0 && ctx->pipe_err == 0) {
+		ctx->pipe_err = result;
+	}
+}
+
+static void pipe_write_done(const struct device *dev,
+			    struct flash_async_req *req, int result)
+{
+	struct stream_flash_ctx *ctx = req->user_data;
+	struct stream_flash_pipe_buf *pb =
+		CONTAINER_OF(req, struct stream_flash_pipe_buf, write_req);
+
+	pb->result = result;
+	pb->done = true;
+	k_sem_give(&ctx->pipe_sem);
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+
+/* Submit the erase of the page to which off belongs, unless the page has
+ * already been erased. The requests of a device are executed in order, so
+ * the writes submitted afterwards find the page erased.
+ */
+static int pipe_erase_page(struct stream_flash_ctx *ctx,
+			   struct flash_async_req *req, off_t off,
+			   struct flash_pages_info *page)
+{
+	int rc;
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, off, page);
+	if (rc != 0) {
+		LOG_ERR("Error %d while getting page info", rc);
+		return rc;
+	}
+
+	if (page->start_offset <= ctx->last_erased_page_start_offset) {
+		return 0;
+	}
+
+	LOG_DBG("Erasing page at offset 0x%08lx", (long)page->start_offset);
+
+	req->cb = pipe_erase_done;
+	req->signal = NULL;
+	req->user_data = ctx;
+
+	rc = flash_erase_async(ctx->fdev, page->start_offset, page->size, req);
+	if (rc != 0) {
+		LOG_ERR("Error %d while erasing page", rc);
+		return rc;
+	}
+
+	ctx->last_erased_page_start_offset = page->start_offset;
+
+	return 0;
+}
+
+/* Erase the page of the last byte to write, and the page after it so that
+ * the next buffers do not wait for an erase.
+ */
+static int pipe_erase_ahead(struct stream_flash_ctx *ctx,
+			    struct stream_flash_pipe_buf *pb, off_t last)
+{
+	struct flash_pages_info page;
+	off_t next;
+	int rc;
+
+	rc = pipe_erase_page(ctx, &pb->erase_req[0], last, &page);
+	if (rc != 0) {
+		return rc;
+	}
+
+	next = page.start_offset + page.size;
+	if ((size_t)next >= ctx->offset + ctx->available) {
+		return 0;
+	}
+
+	return pipe_erase_page(ctx, &pb->erase_req[1], next, &page);
+}
+
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+
+/* Wait for the write of a buffer and account for its bytes. After an error
+ * the later buffers are not accounted for, so that the number of bytes
+ * written only covers data stored in flash.
+ */
+static int pipe_retire(struct stream_flash_ctx *ctx,
+		       struct stream_flash_pipe_buf *pb)
+{
+	int rc;
+
+	if (!pb->busy) {
+		return ctx->pipe_err;
+	}
+
+	while (!pb->done) {
+		k_sem_take(&ctx->pipe_sem, K_FOREVER);
+	}
+
+	pb->busy = false;
+
+	rc = pb->result;
+	if (rc != 0) {
+		LOG_ERR("flash_write error %d offset=0x%08zx", rc, pb->offset);
+	} else {
+		rc = ctx->pipe_err;
+	}
+
+	if (rc == 0 && ctx->callback) {
+		rc = buf_verify(ctx, pb->buf, pb->len, pb->offset);
+	}
+
+	if (rc != 0) {
+		if (ctx->pipe_err == 0) {
+			ctx->pipe_err = rc;
+		}
+		return rc;
+	}
+
+	ctx->bytes_written += pb->len;
+
+	return 0;
+}
+
+/* Wait for all the writes, oldest first */
+static int pipe_drain(struct stream_flash_ctx *ctx)
+{
+	int rc = 0;
+
+	for (int i = 1; i <= ctx->pipe_cnt && rc == 0; i++) {
+		rc = pipe_retire(ctx,
+				 &ctx->pipe[(ctx->pipe_idx + i) % ctx->pipe_cnt]);
+	}
+
+	return rc;
+}
+
+/* Submit the write of the current buffer and switch to the next one */
+static int pipe_sync(struct stream_flash_ctx *ctx)
+{
+	struct stream_flash_pipe_buf *pb = &ctx->pipe[ctx->pipe_idx];
+	size_t write_addr = ctx->offset + ctx->bytes_submitted;
+	size_t buf_bytes_aligned;
+	int rc;
+
+	if (ctx->pipe_err != 0) {
+		return ctx->pipe_err;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	rc = pipe_erase_ahead(ctx, pb, write_addr + ctx->buf_bytes - 1);
+	if (rc < 0) {
+		LOG_ERR("pipe_erase_ahead err %d offset=0x%08zx", rc,
+			write_addr);
+		return rc;
+	}
+#endif
+
+	buf_bytes_aligned = buf_pad(ctx);
+
+	pb->len = ctx->buf_bytes;
+	pb->offset = write_addr;
+	pb->result = 0;
+	pb->done = false;
+	pb->write_req.cb = pipe_write_done;
+	pb->write_req.signal = NULL;
+	pb->write_req.user_data = ctx;
+
+	rc = flash_write_async(ctx->fdev, write_addr, ctx->buf,
+			       buf_bytes_aligned, &pb->write_req);
+	if (rc != 0) {
+		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
+			write_addr);
+		return rc;
+	}
+
+	pb->busy = true;
+	ctx->bytes_submitted += ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+
+	ctx->pipe_idx = (ctx->pipe_idx + 1) % ctx->pipe_cnt;
+	pb = &ctx->pipe[ctx->pipe_idx];
+	ctx->buf = pb->buf;
+
+	/* The next buffer is filled once its previous write is over */
+	return pipe_retire(ctx, pb);
+}
+
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
+/* Number of bytes written or being written to flash */
+static size_t bytes_queued(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (ctx->pipe_cnt) {
+		return ctx->bytes_submitted;
+	}
+#endif
+	return ctx->bytes_written;
+}
+
 static int flash_sync(struct stream_flash_ctx *ctx)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
 	size_t buf_bytes_aligned;
-	size_t fill_length;
-	uint8_t filler;
-
 
 	if (ctx->buf_bytes == 0) {
 		return 0;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (ctx->pipe_cnt) {
+		return pipe_sync(ctx);
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
@@ -128,17 +401,7 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		}
 	}
 
-	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
-		filler = flash_get_parameters(ctx->fdev)->erase_value;
-
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
-	} else {
-		fill_length = 0;
-	}
-
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
+	buf_bytes_aligned = buf_pad(ctx);
 	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
 
 	if (rc != 0) {
@@ -148,23 +411,8 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	if (ctx->callback) {
-		/* Invert to ensure that caller is able to discover a faulty
-		 * flash_read() even if no error code is returned.
-		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
-		}
-
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
-		if (rc != 0) {
-			LOG_ERR("flash read failed: %d", rc);
-			return rc;
-		}
-
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = buf_verify(ctx, ctx->buf, ctx->buf_bytes, write_addr);
 		if (rc != 0) {
-			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
@@ -186,7 +434,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (bytes_queued(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +464,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	if (flush && rc == 0 && ctx->pipe_cnt) {
+		rc = pipe_drain(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -300,9 +554,48 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->last_erased_page_start_offset = -1;
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+	ctx->pipe_cnt = 0U;
+	ctx->bytes_submitted = 0;
+#endif
+
 	return 0;
 }
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+
+int stream_flash_init_pipelined(struct stream_flash_ctx *ctx,
+				const struct device *fdev, uint8_t *buf,
+				size_t buf_len, size_t buf_cnt, size_t offset,
+				size_t size, stream_flash_callback_t cb)
+{
+	int rc;
+
+	if (buf_cnt < 2 || buf_cnt > CONFIG_STREAM_FLASH_PIPELINE_BUFFERS) {
+		LOG_ERR("Unsupported number of buffers");
+		return -EINVAL;
+	}
+
+	rc = stream_flash_init(ctx, fdev, buf, buf_len, offset, size, cb);
+	if (rc != 0) {
+		return rc;
+	}
+
+	for (int i = 0; i < buf_cnt; i++) {
+		ctx->pipe[i].buf = buf + i * buf_len;
+		ctx->pipe[i].busy = false;
+	}
+
+	k_sem_init(&ctx->pipe_sem, 0, K_SEM_MAX_LIMIT);
+	ctx->pipe_cnt = buf_cnt;
+	ctx->pipe_idx = 0U;
+	ctx->pipe_err = 0;
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_PIPELINE */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 
 int stream_flash_progress_load(struct stream_flash_ctx *ctx,
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/crc.h>
+
+#if defined(CONFIG_CRC_SLICE_BY_4)
+#define CRC_BACKEND "slice-by-4"
+#elif defined(CONFIG_CRC_SLICE_BY_8)
+#define CRC_BACKEND "slice-by-8"
+#elif defined(CONFIG_CRC_HW)
+#define CRC_BACKEND "hw"
+#else
+#define CRC_BACKEND "nibble"
+#endif
+
+#define BUF_SIZE 4096
+#define PERF_ROUNDS 64
+/* Lengths checked at every alignment, around the 4 and 8 byte strides */
+#define CHECK_LEN_MAX 67
+#define CHECK_ALIGN_MAX 8
+
+static uint8_t __aligned(8) buf[BUF_SIZE + CHECK_ALIGN_MAX];
+
+/* Bit at a time references, independent of the implementation under test */
+static uint32_t ref_crc32(uint32_t poly, uint32_t crc, const uint8_t *data,
+			  size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return crc;
+}
+
+static uint32_t ref_crc32_ieee(const uint8_t *data, size_t len)
+{
+	return ~ref_crc32(0xedb88320, 0xffffffff, data, len);
+}
+
+static uint32_t ref_crc32_c(const uint8_t *data, size_t len)
+{
+	return ~ref_crc32(0x82f63b78, 0xffffffff, data, len);
+}
+
+static uint8_t ref_crc8_ccitt(uint8_t crc, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc << 1) ^ ((crc & 0x80) ? 0x07 : 0x00);
+		}
+	}
+
+	return crc;
+}
+
+static void buf_fill(void)
+{
+	uint32_t val = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		val = val * 1103515245U + 12345U;
+		buf[i] = val >> 24;
+	}
+}
+
+/**
+ * @brief Cross check the CRC backend against bitwise references
+ *
+ * @details Every length up to a few strides is computed at every alignment,
+ * in one call and split in two calls at every position.
+ */
+void test_crc_check(void)
+{
+	buf_fill();
+
+	for (size_t align = 0; align < CHECK_ALIGN_MAX; align++) {
+		const uint8_t *data = buf + align;
+
+		for (size_t len = 0; len <= CHECK_LEN_MAX; len++) {
+			uint32_t ieee = ref_crc32_ieee(data, len);
+			uint32_t c = ref_crc32_c(data, len);
+			uint8_t c8 = ref_crc8_ccitt(0xff, data, len);
+
+			zassert_equal(crc32_ieee(data, len), ieee,
+				      "crc32_ieee len %zu align %zu", len,
+				      align);
+			zassert_equal(crc32_c(0, data, len, true, true), c,
+				      "crc32_c len %zu align %zu", len,
+				      align);
+			zassert_equal(crc8_ccitt(0xff, data, len), c8,
+				      "crc8_ccitt len %zu align %zu", len,
+				      align);
+
+			for (size_t split = 0; split <= len; split++) {
+				uint32_t crc;
+
+				crc = crc32_ieee_update(0, data, split);
+				crc = crc32_ieee_update(crc, data + split,
+							len - split);
+				zassert_equal(crc, ieee,
+					      "crc32_ieee split %zu/%zu", split,
+					      len);
+
+				crc = crc32_c(0, data, split, true, false);
+				crc = crc32_c(crc, data + split, len - split,
+					      false, true);
+				zassert_equal(crc, c, "crc32_c split %zu/%zu",
+					      split, len);
+			}
+		}
+	}
+
+	zassert_equal(crc32_ieee(buf, BUF_SIZE), ref_crc32_ieee(buf, BUF_SIZE),
+		      "crc32_ieee of the whole buffer");
+	zassert_equal(crc32_c(0, buf, BUF_SIZE, true, true),
+		      ref_crc32_c(buf, BUF_SIZE),
+		      "crc32_c of the whole buffer");
+	zassert_equal(crc8_ccitt(0xff, buf, BUF_SIZE),
+		      ref_crc8_ccitt(0xff, buf, BUF_SIZE),
+		      "crc8_ccitt of the whole buffer");
+}
+
+static void report(const char *what, uint32_t cycles)
+{
+	uint64_t us = MAX(k_cyc_to_us_ceil64(cycles), 1U);
+	uint64_t bytes = (uint64_t)BUF_SIZE * PERF_ROUNDS;
+
+	TC_PRINT("%s: %s %llu bytes in %llu us, %llu MB/s\n", CRC_BACKEND,
+		 what, bytes, us, bytes / us);
+}
+
+/**
+ * @brief Measure the throughput of the CRC backend
+ *
+ * @details Results are folded into a sum so that no computation is
+ * optimized away.
+ */
+void test_crc_perf(void)
+{
+	uint32_t cycles, sum = 0U;
+
+	buf_fill();
+
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < PERF_ROUNDS; round++) {
+		sum += crc32_ieee(buf, BUF_SIZE);
+	}
+	report("crc32_ieee", k_cycle_get_32() - cycles);
+
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < PERF_ROUNDS; round++) {
+		sum += crc32_c(0, buf, BUF_SIZE, true, true);
+	}
+	report("crc32_c", k_cycle_get_32() - cycles);
+
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < PERF_ROUNDS; round++) {
+		sum += crc8_ccitt(0xff, buf, BUF_SIZE);
+	}
+	report("crc8_ccitt", k_cycle_get_32() - cycles);
+
+	TC_PRINT("%s: checksum %08x\n", CRC_BACKEND, sum);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(crc_perf,
+			 ztest_unit_test(test_crc_check),
+			 ztest_unit_test(test_crc_perf)
+			 );
+	ztest_run_test_suite(crc_perf);
+}
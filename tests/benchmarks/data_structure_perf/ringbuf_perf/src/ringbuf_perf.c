@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/ring_buffer.h>
+#include <sys/ring_buffer_lf.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define PRODUCERS 2
+#define CHUNK_SIZE 16
+/* Bytes written by each producer */
+#define TRANSFER_SIZE (64 * 1024)
+
+enum mode {
+	MODE_LOCKED,
+	MODE_LF_SPSC,
+	MODE_LF_MPSC,
+};
+
+RING_BUF_DECLARE(rb_locked, 1024);
+RING_BUF_LF_DECLARE_POW2(rb_lf, 10);
+static struct k_spinlock lock;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, PRODUCERS + 1, STACK_SIZE);
+static struct k_thread threads[PRODUCERS + 1];
+
+static uint32_t buf_put(enum mode mode, const uint8_t *data, uint32_t size)
+{
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	switch (mode) {
+	case MODE_LOCKED:
+		/* The locked ring buffer needs the lock on both sides as
+		 * soon as the producer and the consumer run concurrently.
+		 */
+		key = k_spin_lock(&lock);
+		len = ring_buf_put(&rb_locked, data, size);
+		k_spin_unlock(&lock, key);
+		return len;
+	case MODE_LF_SPSC:
+		return ring_buf_lf_put(&rb_lf, data, size);
+	default:
+		return ring_buf_lf_mp_put(&rb_lf, data, size);
+	}
+}
+
+static uint32_t buf_get(enum mode mode, uint8_t *data, uint32_t size)
+{
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	if (mode == MODE_LOCKED) {
+		key = k_spin_lock(&lock);
+		len = ring_buf_get(&rb_locked, data, size);
+		k_spin_unlock(&lock, key);
+		return len;
+	}
+
+	return ring_buf_lf_get(&rb_lf, data, size);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	uint8_t chunk[CHUNK_SIZE] = { 0 };
+	uint32_t sent = 0U;
+	uint32_t len;
+
+	while (sent < TRANSFER_SIZE) {
+		len = buf_put(mode, chunk,
+			      MIN(sizeof(chunk), TRANSFER_SIZE - sent));
+		if (len == 0U) {
+			k_yield();
+		}
+		sent += len;
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_INT(p1);
+	uint32_t total = POINTER_TO_INT(p2);
+	uint8_t data[4 * CHUNK_SIZE];
+	uint32_t received = 0U;
+	uint32_t len;
+
+	while (received < total) {
+		len = buf_get(mode, data, sizeof(data));
+		if (len == 0U) {
+			k_yield();
+		}
+		received += len;
+	}
+}
+
+static void run(enum mode mode, int producers, const char *name)
+{
+	uint32_t total = producers * TRANSFER_SIZE;
+	uint32_t cycles;
+	uint64_t us;
+
+	ring_buf_reset(&rb_locked);
+	ring_buf_lf_init(&rb_lf, rb_lf.size, rb_lf.buf);
+
+	cycles = k_cycle_get_32();
+
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, consumer,
+			INT_TO_POINTER(mode), INT_TO_POINTER(total), NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	for (int i = 1; i <= producers; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				INT_TO_POINTER(mode), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i <= producers; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - cycles;
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+
+	TC_PRINT("%s: %u bytes, %u cycles, %llu KiB/s\n", name, total, cycles,
+		 (uint64_t)total * USEC_PER_SEC / 1024 / us);
+}
+
+/**
+ * @brief Compare the throughput of locked and lock-free ring buffers
+ *
+ * @details Each producer thread writes @ref TRANSFER_SIZE bytes in
+ * @ref CHUNK_SIZE byte chunks while one consumer thread reads them. With
+ * CONFIG_SMP the threads run on different CPUs.
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+void test_ringbuf_spsc_perf(void)
+{
+	run(MODE_LOCKED, 1, "ring_buf, spinlock, 1 producer");
+	run(MODE_LF_SPSC, 1, "ring_buf_lf, 1 producer");
+}
+
+void test_ringbuf_mpsc_perf(void)
+{
+	run(MODE_LOCKED, PRODUCERS, "ring_buf, spinlock, 2 producers");
+	run(MODE_LF_MPSC, PRODUCERS, "ring_buf_lf, 2 producers");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ringbuf_perf,
+			 ztest_unit_test(test_ringbuf_spsc_perf),
+			 ztest_unit_test(test_ringbuf_mpsc_perf)
+			 );
+	ztest_run_test_suite(ringbuf_perf);
+}
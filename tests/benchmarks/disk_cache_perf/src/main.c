@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <stats/stats.h>
+#include <storage/disk_access.h>
+
+#define SECTOR_SIZE 512
+/* Sectors written and read sequentially, like a file */
+#define SEQ_SECTORS 128
+/* Sectors rewritten over and over, like a FAT and a directory entry */
+#define HOT_SECTORS 4
+#define HOT_ROUNDS 64
+/* A sync is requested every SYNC_ROUNDS rounds of hot sector writes */
+#define SYNC_ROUNDS 16
+
+static uint8_t __aligned(4) wr_buf[SECTOR_SIZE];
+static uint8_t __aligned(4) rd_buf[SECTOR_SIZE];
+
+/* Sectors transferred with a single vectored access, one buffer per sector */
+#define IOV_SECTORS 8
+#define IOV_ROUNDS 16
+
+static uint8_t __aligned(4) iov_bufs[IOV_SECTORS][SECTOR_SIZE];
+
+static uint32_t *erase_calls;
+
+static int erase_calls_find(struct stats_hdr *hdr, void *arg,
+			    const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_erase_calls")) {
+		erase_calls = (uint32_t *)((uint8_t *)hdr + off);
+		return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t erase_count(void)
+{
+	return erase_calls ? *erase_calls : 0U;
+}
+
+static void sector_fill(uint8_t *buf, uint32_t sector, uint32_t round)
+{
+	for (int i = 0; i < SECTOR_SIZE; i++) {
+		buf[i] = sector + round + i;
+	}
+}
+
+static void disk_sync(const char *disk)
+{
+	int err;
+
+	err = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
+	zassert_equal(err, 0, "Sync failed: %d", err);
+}
+
+static void report(const char *disk, const char *what, uint32_t cycles,
+		   uint32_t erases)
+{
+	TC_PRINT("%s: %s %llu us, %u erases\n", disk, what,
+		 k_cyc_to_us_ceil64(cycles), erases);
+}
+
+static void disk_perf(const char *disk)
+{
+	uint32_t cycles, erases;
+	int err;
+
+	err = disk_access_init(disk);
+	zassert_equal(err, 0, "Disk %s init failed: %d", disk, err);
+
+	/* Sequential write of single sectors, like a file written by FAT */
+	erases = erase_count();
+	cycles = k_cycle_get_32();
+	for (uint32_t sector = 0; sector < SEQ_SECTORS; sector++) {
+		sector_fill(wr_buf, sector, 0);
+		err = disk_access_write(disk, wr_buf, sector, 1);
+		zassert_equal(err, 0, "Write failed: %d", err);
+	}
+	disk_sync(disk);
+	report(disk, "sequential write", k_cycle_get_32() - cycles,
+	       erase_count() - erases);
+
+	/* Sequential read of single sectors */
+	cycles = k_cycle_get_32();
+	for (uint32_t sector = 0; sector < SEQ_SECTORS; sector++) {
+		err = disk_access_read(disk, rd_buf, sector, 1);
+		zassert_equal(err, 0, "Read failed: %d", err);
+		sector_fill(wr_buf, sector, 0);
+		zassert_mem_equal(rd_buf, wr_buf, SECTOR_SIZE,
+				  "Wrong data in sector %u", sector);
+	}
+	report(disk, "sequential read", k_cycle_get_32() - cycles, 0);
+
+	/* Repeated updates of a few sectors of the same erase block */
+	erases = erase_count();
+	cycles = k_cycle_get_32();
+	for (uint32_t round = 1; round <= HOT_ROUNDS; round++) {
+		for (uint32_t sector = 0; sector < HOT_SECTORS; sector++) {
+			sector_fill(wr_buf, sector, round);
+			err = disk_access_write(disk, wr_buf, sector, 1);
+			zassert_equal(err, 0, "Write failed: %d", err);
+		}
+		if (!(round % SYNC_ROUNDS)) {
+			disk_sync(disk);
+		}
+	}
+	report(disk, "hot sector updates", k_cycle_get_32() - cycles,
+	       erase_count() - erases);
+
+	for (uint32_t sector = 0; sector < HOT_SECTORS; sector++) {
+		err = disk_access_read(disk, rd_buf, sector, 1);
+		zassert_equal(err, 0, "Read failed: %d", err);
+		sector_fill(wr_buf, sector, HOT_ROUNDS);
+		zassert_mem_equal(rd_buf, wr_buf, SECTOR_SIZE,
+				  "Wrong data in sector %u", sector);
+	}
+}
+
+/**
+ * @brief Measure disk access patterns of a file system on the RAM disk
+ */
+void test_ram_disk_perf(void)
+{
+	disk_perf(CONFIG_DISK_RAM_VOLUME_NAME);
+}
+
+/**
+ * @brief Measure disk access patterns of a file system on the flash disk
+ *
+ * @details The flash disk is backed by the flash simulator, the number of
+ * erases is reported along with the durations.
+ */
+void test_flash_disk_perf(void)
+{
+	struct stats_hdr *sim_stats;
+
+	sim_stats = stats_group_find("flash_sim_stats");
+	zassert_not_null(sim_stats, "flash_sim_stats not found");
+	stats_walk(sim_stats, erase_calls_find, NULL);
+	zassert_not_null(erase_calls, "flash_erase_calls stat not found");
+
+	disk_perf(CONFIG_DISK_FLASH_VOLUME_NAME);
+}
+
+/**
+ * @brief Compare vectored and per buffer accesses on the RAM disk
+ *
+ * @details Sectors scattered in memory are written and read back with
+ * disk_access_writev() and disk_access_readv(), then one buffer at a time.
+ */
+void test_ram_disk_vectored_perf(void)
+{
+	const char *disk = CONFIG_DISK_RAM_VOLUME_NAME;
+	struct disk_iovec iov[IOV_SECTORS];
+	uint32_t cycles;
+	int err;
+
+	err = disk_access_init(disk);
+	zassert_equal(err, 0, "Disk %s init failed: %d", disk, err);
+
+	for (int i = 0; i < IOV_SECTORS; i++) {
+		/* Reverse order in memory */
+		iov[i].buf = iov_bufs[IOV_SECTORS - 1 - i];
+		iov[i].num_sector = 1U;
+		sector_fill(iov[i].buf, i, 1);
+	}
+
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < IOV_ROUNDS; round++) {
+		err = disk_access_writev(disk, iov, IOV_SECTORS, 0);
+		zassert_equal(err, 0, "Vectored write failed: %d", err);
+	}
+	disk_sync(disk);
+	report(disk, "vectored write", k_cycle_get_32() - cycles, 0);
+
+	/* The sectors are contiguous on the disk */
+	for (uint32_t sector = 0; sector < IOV_SECTORS; sector++) {
+		err = disk_access_read(disk, rd_buf, sector, 1);
+		zassert_equal(err, 0, "Read failed: %d", err);
+		zassert_mem_equal(rd_buf, iov[sector].buf, SECTOR_SIZE,
+				  "Wrong data in sector %u", sector);
+	}
+
+	memset(iov_bufs, 0, sizeof(iov_bufs));
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < IOV_ROUNDS; round++) {
+		err = disk_access_readv(disk, iov, IOV_SECTORS, 0);
+		zassert_equal(err, 0, "Vectored read failed: %d", err);
+	}
+	report(disk, "vectored read", k_cycle_get_32() - cycles, 0);
+
+	for (uint32_t sector = 0; sector < IOV_SECTORS; sector++) {
+		sector_fill(wr_buf, sector, 1);
+		zassert_mem_equal(iov[sector].buf, wr_buf, SECTOR_SIZE,
+				  "Wrong data read for sector %u", sector);
+	}
+
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < IOV_ROUNDS; round++) {
+		for (uint32_t sector = 0; sector < IOV_SECTORS; sector++) {
+			err = disk_access_read(disk, iov[sector].buf, sector,
+					       1);
+			zassert_equal(err, 0, "Read failed: %d", err);
+		}
+	}
+	report(disk, "per buffer read", k_cycle_get_32() - cycles, 0);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(disk_cache_perf,
+			 ztest_unit_test(test_ram_disk_perf),
+			 ztest_unit_test(test_ram_disk_vectored_perf),
+			 ztest_unit_test(test_flash_disk_perf)
+			 );
+	ztest_run_test_suite(disk_cache_perf);
+}
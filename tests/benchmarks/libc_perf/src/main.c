@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <sys/types.h>
+
+#if defined(CONFIG_MINIMAL_LIBC_WORD_ACCESS)
+#define LIBC_MODE "word"
+#else
+#define LIBC_MODE "byte"
+#endif
+
+#define BUF_SIZE 1024
+#define PERF_ROUNDS 64
+/* Bytes copied or scanned by each call, at offsets up to 8 */
+#define LEN (BUF_SIZE - 16)
+
+static char __aligned(8) src[BUF_SIZE];
+static char __aligned(8) dst[BUF_SIZE];
+static char __aligned(8) cmp[BUF_SIZE];
+static char __aligned(8) res[BUF_SIZE];
+
+/*
+ * References, equivalent to the generic minimal libc functions without
+ * CONFIG_MINIMAL_LIBC_WORD_ACCESS. memcpy() copies words when both buffers
+ * have the same alignment, the other ones work a byte at a time.
+ */
+static void *ref_memcpy(void *d, const void *s, size_t n)
+{
+	unsigned char *d_byte = d;
+	const unsigned char *s_byte = s;
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+		while (((uintptr_t)d_byte) & mask) {
+			if (n == 0) {
+				return d;
+			}
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+		while (n >= sizeof(mem_word_t)) {
+			*(d_word++) = *(s_word++);
+			n -= sizeof(mem_word_t);
+		}
+
+		d_byte = (unsigned char *)d_word;
+		s_byte = (const unsigned char *)s_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+
+static void *ref_memmove(void *d, const void *s, size_t n)
+{
+	char *d_byte = d;
+	const char *s_byte = s;
+
+	if ((size_t)(d_byte - s_byte) < n) {
+		while (n > 0) {
+			n--;
+			d_byte[n] = s_byte[n];
+		}
+	} else {
+		while (n > 0) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+	}
+
+	return d;
+}
+
+static int ref_memcmp(const void *m1, const void *m2, size_t n)
+{
+	const char *c1 = m1;
+	const char *c2 = m2;
+
+	if (!n) {
+		return 0;
+	}
+
+	while ((--n > 0) && (*c1 == *c2)) {
+		c1++;
+		c2++;
+	}
+
+	return *c1 - *c2;
+}
+
+static void *ref_memchr(const void *s, int c, size_t n)
+{
+	const unsigned char *p = s;
+
+	for (; n > 0; n--, p++) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+	}
+
+	return NULL;
+}
+
+static size_t ref_strlen(const char *s)
+{
+	size_t n = 0;
+
+	while (*s != '\0') {
+		s++;
+		n++;
+	}
+
+	return n;
+}
+
+static char *ref_strchr(const char *s, int c)
+{
+	char tmp = (char)c;
+
+	while ((*s != tmp) && (*s != '\0')) {
+		s++;
+	}
+
+	return (*s == tmp) ? (char *)s : NULL;
+}
+
+static int ref_strcmp(const char *s1, const char *s2)
+{
+	while ((*s1 == *s2) && (*s1 != '\0')) {
+		s1++;
+		s2++;
+	}
+
+	return *s1 - *s2;
+}
+
+/*
+ * Each case runs once with the libc function and once with its reference.
+ * The source holds a string of LEN - 1 characters at every offset, the
+ * comparison buffer holds the same string.
+ */
+struct libc_case {
+	const char *name;
+	uintptr_t (*libc)(void);
+	uintptr_t (*ref)(void);
+	/* Buffer written by the case */
+	const char *out;
+};
+
+#define LIBC_CASE(_name, _call)						\
+	static uintptr_t _name##_libc(void)				\
+	{								\
+		return (uintptr_t)_call;				\
+	}								\
+	static uintptr_t _name##_ref(void)				\
+	{								\
+		return (uintptr_t)ref_##_call;				\
+	}
+
+LIBC_CASE(memcpy_aligned, memcpy(dst, src, LEN))
+LIBC_CASE(memcpy_unaligned, memcpy(dst + 1, src + 3, LEN))
+LIBC_CASE(memmove_forward, memmove(res, res + 3, LEN))
+LIBC_CASE(memmove_backward, memmove(res + 5, res, LEN))
+LIBC_CASE(memcmp_aligned, memcmp(src, cmp, LEN))
+LIBC_CASE(memcmp_unaligned, memcmp(src + 1, cmp + 1, LEN - 1))
+LIBC_CASE(memchr_unaligned, memchr(src + 1, '\0', LEN))
+LIBC_CASE(strlen_unaligned, strlen(src + 1))
+LIBC_CASE(strchr_unaligned, strchr(src + 1, 'z'))
+LIBC_CASE(strcmp_aligned, strcmp(src, cmp))
+
+#define LIBC_CASE_ENTRY(_name, _out) \
+	{ #_name, _name##_libc, _name##_ref, _out }
+
+static const struct libc_case cases[] = {
+	LIBC_CASE_ENTRY(memcpy_aligned, dst),
+	LIBC_CASE_ENTRY(memcpy_unaligned, dst),
+	LIBC_CASE_ENTRY(memmove_forward, res),
+	LIBC_CASE_ENTRY(memmove_backward, res),
+	LIBC_CASE_ENTRY(memcmp_aligned, dst),
+	LIBC_CASE_ENTRY(memcmp_unaligned, dst),
+	LIBC_CASE_ENTRY(memchr_unaligned, dst),
+	LIBC_CASE_ENTRY(strlen_unaligned, dst),
+	LIBC_CASE_ENTRY(strchr_unaligned, dst),
+	LIBC_CASE_ENTRY(strcmp_aligned, dst),
+};
+
+static void buf_fill(void)
+{
+	for (int i = 0; i < BUF_SIZE; i++) {
+		src[i] = 'a' + (i % 25);
+		res[i] = src[i];
+	}
+
+	src[LEN] = '\0';
+	src[LEN - 1] = 'z';
+	memcpy(cmp, src, sizeof(cmp));
+	memset(dst, 0, sizeof(dst));
+}
+
+/**
+ * @brief Cross check libc functions against their references
+ *
+ * @details Return values and the destination buffers must be identical.
+ */
+void test_libc_check(void)
+{
+	static char __aligned(8) out[2][BUF_SIZE];
+	uintptr_t ret[2];
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		for (int ref = 0; ref < 2; ref++) {
+			buf_fill();
+			ret[ref] = ref ? cases[i].ref() : cases[i].libc();
+			memcpy(out[ref], cases[i].out, BUF_SIZE);
+		}
+
+		zassert_equal(ret[0], ret[1], "%s return value differs",
+			      cases[i].name);
+		zassert_mem_equal(out[0], out[1], BUF_SIZE, "%s data differs",
+				  cases[i].name);
+	}
+}
+
+static uint64_t mb_per_s(uint32_t cycles)
+{
+	uint64_t us = MAX(k_cyc_to_us_ceil64(cycles), 1U);
+
+	return ((uint64_t)LEN * PERF_ROUNDS) / us;
+}
+
+/**
+ * @brief Measure the throughput of libc functions and of their references
+ */
+void test_libc_perf(void)
+{
+	uint32_t cycles, libc_cycles;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		buf_fill();
+
+		cycles = k_cycle_get_32();
+		for (int round = 0; round < PERF_ROUNDS; round++) {
+			cases[i].libc();
+		}
+		libc_cycles = k_cycle_get_32() - cycles;
+
+		cycles = k_cycle_get_32();
+		for (int round = 0; round < PERF_ROUNDS; round++) {
+			cases[i].ref();
+		}
+		cycles = k_cycle_get_32() - cycles;
+
+		TC_PRINT("%s: %s %llu MB/s, reference %llu MB/s\n", LIBC_MODE,
+			 cases[i].name, mb_per_s(libc_cycles),
+			 mb_per_s(cycles));
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(libc_perf,
+			 ztest_unit_test(test_libc_check),
+			 ztest_unit_test(test_libc_perf)
+			 );
+	ztest_run_test_suite(libc_perf);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <stdio.h>
+#include <string.h>
+#include <settings/settings.h>
+#include <storage/flash_map.h>
+
+/* Number of stored keys at which the save latency is measured */
+static const int key_counts[] = { 16, 64, 256 };
+/* Number of saves measured for each key count */
+#define SAVE_ROUNDS 32
+
+static int keys_stored;
+
+/* Number of settings handlers in addition to the "perf" one */
+#define HANDLER_CNT 32
+/* Number of handler lookups measured */
+#define LOOKUP_ROUNDS 1000
+
+static int perf_set_cnt;
+
+static int perf_set(const char *key, size_t len, settings_read_cb read_cb,
+		    void *cb_arg)
+{
+	perf_set_cnt++;
+
+	return 0;
+}
+
+static int bench_set(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(perf, "perf", NULL, perf_set, NULL, NULL);
+
+#define BENCH_HANDLER_DEFINE(i, _)					\
+	SETTINGS_STATIC_HANDLER_DEFINE(bench_##i, "bench/h" #i, NULL,	\
+				       bench_set, NULL, NULL);
+
+UTIL_LISTIFY(HANDLER_CNT, BENCH_HANDLER_DEFINE, _)
+
+static void key_name(char *name, size_t size, int idx)
+{
+	snprintf(name, size, "perf/key%d", idx);
+}
+
+static void keys_store(int cnt)
+{
+	char name[16];
+	uint32_t val;
+	int err;
+
+	for (; keys_stored < cnt; keys_stored++) {
+		key_name(name, sizeof(name), keys_stored);
+		val = keys_stored;
+		err = settings_save_one(name, &val, sizeof(val));
+		zassert_equal(err, 0, "settings_save_one failed: %d", err);
+	}
+}
+
+/**
+ * @brief Measure the settings save latency against the number of keys
+ *
+ * @details For each number of stored keys, the time to update existing
+ * keys (the oldest and the newest ones) and the time to add a new key are
+ * measured after the settings have been loaded, like at runtime after boot.
+ */
+void test_settings_save_perf(void)
+{
+	const struct flash_area *fap;
+	char name[16];
+	uint32_t val, cycles, update_cycles, new_cycles;
+	int err;
+
+	err = flash_area_open(FLASH_AREA_ID(storage), &fap);
+	zassert_equal(err, 0, "flash_area_open failed: %d", err);
+	err = flash_area_erase(fap, 0, fap->fa_size);
+	zassert_equal(err, 0, "flash_area_erase failed: %d", err);
+	flash_area_close(fap);
+
+	err = settings_subsys_init();
+	zassert_equal(err, 0, "settings_subsys_init failed: %d", err);
+
+	for (int i = 0; i < ARRAY_SIZE(key_counts); i++) {
+		keys_store(key_counts[i]);
+
+		err = settings_load();
+		zassert_equal(err, 0, "settings_load failed: %d", err);
+
+		update_cycles = 0U;
+		for (int j = 0; j < SAVE_ROUNDS; j++) {
+			/* Alternate between the oldest and the newest keys */
+			key_name(name, sizeof(name),
+				 (j & 1) ? keys_stored - 1 - j / 2 : j / 2);
+			val = j;
+
+			cycles = k_cycle_get_32();
+			err = settings_save_one(name, &val, sizeof(val));
+			update_cycles += k_cycle_get_32() - cycles;
+			zassert_equal(err, 0, "settings_save_one failed: %d",
+				      err);
+		}
+
+		new_cycles = 0U;
+		for (int j = 0; j < SAVE_ROUNDS; j++) {
+			key_name(name, sizeof(name), keys_stored);
+			val = keys_stored++;
+
+			cycles = k_cycle_get_32();
+			err = settings_save_one(name, &val, sizeof(val));
+			new_cycles += k_cycle_get_32() - cycles;
+			zassert_equal(err, 0, "settings_save_one failed: %d",
+				      err);
+		}
+
+		TC_PRINT("%d keys: update %llu us, new key %llu us\n",
+			 key_counts[i],
+			 k_cyc_to_us_ceil64(update_cycles) / SAVE_ROUNDS,
+			 k_cyc_to_us_ceil64(new_cycles) / SAVE_ROUNDS);
+	}
+}
+
+/**
+ * @brief Measure the time to find the handler of a key
+ *
+ * @details Keys of all the handlers are looked up, the handlers names share
+ * a common prefix like the ones of a subsystem with many handlers.
+ */
+void test_settings_lookup_perf(void)
+{
+	struct settings_handler_static *ch;
+	char name[32];
+	const char *next;
+	uint32_t cycles;
+
+	cycles = k_cycle_get_32();
+	for (int i = 0; i < LOOKUP_ROUNDS; i++) {
+		snprintf(name, sizeof(name), "bench/h%d/item",
+			 i % HANDLER_CNT);
+		ch = settings_parse_and_lookup(name, &next);
+		zassert_not_null(ch, "No handler found for %s", name);
+		zassert_equal(ch->h_set, bench_set, "Wrong handler found");
+		zassert_true(next && !strcmp(next, "item"), "Wrong next");
+	}
+	cycles = k_cycle_get_32() - cycles;
+
+	TC_PRINT("%d handlers: %llu ns per lookup\n", HANDLER_CNT + 1,
+		 k_cyc_to_ns_ceil64(cycles) / LOOKUP_ROUNDS);
+}
+
+/**
+ * @brief Measure the time to load all the settings, like at boot
+ *
+ * @details Loads the keys stored by test_settings_save_perf.
+ */
+void test_settings_load_perf(void)
+{
+	uint32_t cycles;
+	int err;
+
+	perf_set_cnt = 0;
+
+	cycles = k_cycle_get_32();
+	err = settings_load();
+	cycles = k_cycle_get_32() - cycles;
+
+	zassert_equal(err, 0, "settings_load failed: %d", err);
+	zassert_equal(perf_set_cnt, keys_stored, "Not all keys loaded");
+
+	TC_PRINT("%d keys, %d handlers: load %llu us\n", keys_stored,
+		 HANDLER_CNT + 1, k_cyc_to_us_ceil64(cycles));
+}
+
+void test_main(void)
+{
+	ztest_test_suite(settings_perf,
+			 ztest_unit_test(test_settings_save_perf),
+			 ztest_unit_test(test_settings_lookup_perf),
+			 ztest_unit_test(test_settings_load_perf)
+			 );
+	ztest_run_test_suite(settings_perf);
+}
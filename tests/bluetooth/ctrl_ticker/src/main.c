@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <ztest.h>
+
+#define CONFIG_BT_LOG_LEVEL 1
+#define CONFIG_BT_TICKER_EXT 1
+
+#if TEST_TICKER_WHEEL
+#define CONFIG_BT_TICKER_WHEEL 1
+#define CONFIG_BT_TICKER_WHEEL_SLOTS 64
+#define CONFIG_BT_TICKER_WHEEL_SLOT_SHIFT 10
+#define TICKER_MODE "wheel"
+#else
+#define TICKER_MODE "list"
+#endif /* TEST_TICKER_WHEEL */
+
+#include "ticker/ticker.c"
+
+/*
+ * Unit test of the ticker scheduling core, driven by a simulated counter.
+ * The compare value set by ticker_job is reached at once, the ticker_worker
+ * and ticker_job mayflies are run in place.
+ */
+
+#define TICKER_NODES 200
+#define TICKER_USER_OPS 250
+#define TICKER_USER_ID 0
+
+/* Expirations after which a node is updated with drift or restarted */
+#define CHURN_EXPIRIES 5
+#define CHURN_DRIFT 7
+
+static uint8_t __aligned(4) ticker_nodes[TICKER_NODES][TICKER_NODE_T_SIZE];
+static uint8_t __aligned(4) ticker_users[1][TICKER_USER_T_SIZE];
+static uint8_t __aligned(4) ticker_user_ops[TICKER_USER_OPS]
+					  [TICKER_USER_OP_T_SIZE];
+
+static uint32_t cntr;
+static uint32_t cntr_cc;
+static bool job_pending;
+static uint32_t job_cycles;
+static uint32_t job_count;
+
+static struct {
+	uint32_t ticks_periodic;
+	uint32_t ticks_expire;
+	uint32_t expiries;
+	uint8_t churn;
+} nodes[TICKER_NODES];
+
+uint32_t cntr_cnt_get(void)
+{
+	return cntr;
+}
+
+uint32_t cntr_start(void)
+{
+	return 0;
+}
+
+uint32_t cntr_stop(void)
+{
+	return 0;
+}
+
+static uint8_t caller_id_get(uint8_t user_id)
+{
+	ARG_UNUSED(user_id);
+
+	return TICKER_CALL_ID_PROGRAM;
+}
+
+static void sched(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+		  void *instance)
+{
+	if (callee_id == TICKER_CALL_ID_JOB) {
+		job_pending = true;
+	}
+}
+
+static void trigger_set(uint32_t value)
+{
+	cntr_cc = value;
+}
+
+static void job_run(void)
+{
+	while (job_pending) {
+		uint32_t cycles;
+
+		job_pending = false;
+
+		cycles = k_cycle_get_32();
+		ticker_job(&_instance[0]);
+		job_cycles += k_cycle_get_32() - cycles;
+		job_count++;
+	}
+}
+
+static void timeout(uint32_t ticks_at_expire, uint32_t remainder,
+		    uint16_t lazy, uint8_t force, void *context)
+{
+	uint8_t id = (uint8_t)POINTER_TO_UINT(context);
+
+	zassert_equal(ticks_at_expire,
+		      nodes[id].ticks_expire & HAL_TICKER_CNTR_MASK,
+		      "Ticker %u expired at %u", id, ticks_at_expire);
+	zassert_equal(lazy, 0U, "Ticker %u skipped %u", id, lazy);
+
+	nodes[id].ticks_expire += nodes[id].ticks_periodic;
+	nodes[id].expiries++;
+	nodes[id].churn++;
+}
+
+static void ticker_node_start(uint8_t id, uint32_t ticks_first,
+			      uint32_t ticks_periodic)
+{
+	uint32_t ret;
+
+	nodes[id].ticks_periodic = ticks_periodic;
+	nodes[id].ticks_expire = cntr + ticks_first;
+	nodes[id].churn = 0U;
+
+	ret = ticker_start(0, TICKER_USER_ID, id, cntr, ticks_first,
+			   ticks_periodic, TICKER_NULL_REMAINDER,
+			   TICKER_NULL_LAZY, TICKER_NULL_SLOT, timeout,
+			   UINT_TO_POINTER(id), NULL, NULL);
+	zassert_equal(ret, TICKER_STATUS_BUSY, "Ticker %u start failed", id);
+	job_run();
+}
+
+/* Connection like intervals, every 8th node has a long advertising like
+ * interval beyond the timing wheel.
+ */
+static void ticker_setup(uint8_t count)
+{
+	uint32_t ret;
+
+	memset(ticker_nodes, 0, sizeof(ticker_nodes));
+	memset(nodes, 0, sizeof(nodes));
+
+	/* Counter restarts along with the ticker instance */
+	cntr = 0U;
+	cntr_cc = 0U;
+
+	((struct ticker_user *)ticker_users[0])->count_user_op =
+		TICKER_USER_OPS;
+	ret = ticker_init(0, count, ticker_nodes, 1, ticker_users,
+			  TICKER_USER_OPS, ticker_user_ops, caller_id_get,
+			  sched, trigger_set);
+	zassert_equal(ret, TICKER_STATUS_SUCCESS, "Ticker init failed");
+
+	for (uint8_t id = 0U; id < count; id++) {
+		uint32_t ticks_periodic;
+
+		if (id % 8U) {
+			ticks_periodic = HAL_TICKER_US_TO_TICKS(7500U) *
+					 (1U + (id % 16U)) + id;
+		} else {
+			ticks_periodic = HAL_TICKER_US_TO_TICKS(2500000U) + id;
+		}
+
+		ticker_node_start(id, 10U + (id * 37U), ticks_periodic);
+	}
+
+	job_cycles = 0U;
+	job_count = 0U;
+}
+
+/* Nodes that expired a few times are updated with drift, or stopped and
+ * started again, as connections and advertising sets come and go.
+ */
+static void ticker_churn(uint8_t count)
+{
+	uint32_t ret;
+
+	for (uint8_t id = 0U; id < count; id++) {
+		if (nodes[id].churn < CHURN_EXPIRIES) {
+			continue;
+		}
+
+		if (id % 2U) {
+			nodes[id].churn = 0U;
+			nodes[id].ticks_expire += CHURN_DRIFT;
+
+			ret = ticker_update(0, TICKER_USER_ID, id, CHURN_DRIFT,
+					    0, 0, 0, 0, 0, NULL, NULL);
+			zassert_equal(ret, TICKER_STATUS_BUSY,
+				      "Ticker %u update failed", id);
+			job_run();
+		} else {
+			ret = ticker_stop(0, TICKER_USER_ID, id, NULL, NULL);
+			zassert_equal(ret, TICKER_STATUS_BUSY,
+				      "Ticker %u stop failed", id);
+			job_run();
+
+			ticker_node_start(id, 100U + ((id * 97U +
+						       nodes[id].expiries) %
+						      5000U),
+					  nodes[id].ticks_periodic);
+		}
+	}
+}
+
+static uint32_t ticker_run(uint8_t count, uint32_t triggers, bool churn)
+{
+	uint32_t expiries = 0U;
+
+	while (triggers--) {
+		cntr = cntr_cc;
+		ticker_worker(&_instance[0]);
+		job_run();
+
+		if (churn) {
+			ticker_churn(count);
+		}
+	}
+
+	for (uint8_t id = 0U; id < count; id++) {
+		zassert_true(nodes[id].expiries, "Ticker %u never expired", id);
+		expiries += nodes[id].expiries;
+	}
+
+	return expiries;
+}
+
+/**
+ * @brief Test expiration of periodic ticker nodes with updates and restarts
+ *
+ * @details Every expiration happens at the tick the node was scheduled for,
+ * including nodes expiring beyond the timing wheel.
+ */
+void test_ticker_expire(void)
+{
+	uint32_t expiries;
+
+	ticker_setup(64U);
+	expiries = ticker_run(64U, 20000U, true);
+
+	TC_PRINT("%s: %u expirations of 64 ticker nodes\n", TICKER_MODE,
+		 expiries);
+}
+
+/**
+ * @brief Measure ticker_job execution time with many active ticker nodes
+ */
+void test_ticker_job_perf(void)
+{
+	uint32_t expiries;
+
+	for (uint32_t count = 25U; count <= TICKER_NODES; count *= 2U) {
+		ticker_setup(count);
+		expiries = ticker_run(count, 10000U, true);
+
+		TC_PRINT("%s: %u ticker nodes, %u expirations, %u jobs in "
+			 "%llu us\n", TICKER_MODE, count, expiries, job_count,
+			 k_cyc_to_us_ceil64(job_cycles));
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ctrl_ticker,
+			 ztest_unit_test(test_ticker_expire),
+			 ztest_unit_test(test_ticker_job_perf)
+			 );
+	ztest_run_test_suite(ctrl_ticker);
+}
@@ -265,6 +265,86 @@ void test_gatt_write(void)
 			  "Attribute write value don't match");
 }
 
+/* Characteristics of the service used to measure the lookup cost */
+#define LOOKUP_CHRC_CNT 64
+/* Number of lookups of each attribute */
+#define LOOKUP_ROUNDS 10
+
+#define LOOKUP_CHRC(i, _)						\
+	BT_GATT_CHARACTERISTIC(&test_chrc_uuid.uuid, BT_GATT_CHRC_READ,	\
+			       BT_GATT_PERM_READ, read_test, NULL,	\
+			       test_value),
+
+static struct bt_gatt_attr lookup_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(&test1_uuid),
+	UTIL_LISTIFY(LOOKUP_CHRC_CNT, LOOKUP_CHRC, _)
+};
+
+static struct bt_gatt_service lookup_svc = BT_GATT_SERVICE(lookup_attrs);
+
+static uint8_t get_attr(const struct bt_gatt_attr *attr, uint16_t handle,
+			void *user_data)
+{
+	const struct bt_gatt_attr **tmp = user_data;
+
+	*tmp = attr;
+
+	return BT_GATT_ITER_STOP;
+}
+
+static const struct bt_gatt_attr *lookup_handle(uint16_t handle)
+{
+	const struct bt_gatt_attr *attr = NULL;
+
+	bt_gatt_foreach_attr(handle, handle, get_attr, &attr);
+
+	return attr;
+}
+
+void test_gatt_lookup(void)
+{
+	const struct bt_gatt_attr *attr;
+	uint16_t first, last;
+	uint32_t cycles;
+
+	zassert_false(bt_gatt_service_register(&lookup_svc),
+		     "Lookup service registration failed");
+
+	first = lookup_attrs[0].handle;
+	last = lookup_attrs[ARRAY_SIZE(lookup_attrs) - 1].handle;
+
+	/* Static attributes are found and their handle resolved back */
+	attr = lookup_handle(0x0001);
+	zassert_not_null(attr, "First static attribute not found");
+	zassert_equal(bt_gatt_attr_get_handle(attr), 0x0001,
+		      "Static attribute handle don't match");
+
+	/* Every attribute of the database, the last service is the biggest */
+	cycles = k_cycle_get_32();
+	for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+		for (uint16_t handle = 1; handle <= last; handle++) {
+			attr = lookup_handle(handle);
+			zassert_not_null(attr, "Handle 0x%04x not found",
+					 handle);
+			if (handle >= first) {
+				zassert_equal_ptr(attr,
+						  &lookup_attrs[handle - first],
+						  "Wrong attribute found");
+			}
+		}
+	}
+	cycles = k_cycle_get_32() - cycles;
+
+	TC_PRINT("%u attributes: %llu ns per lookup\n", last,
+		 k_cyc_to_ns_ceil64(cycles) / (LOOKUP_ROUNDS * last));
+
+	zassert_is_null(lookup_handle(last + 1), "Unexpected attribute");
+
+	zassert_false(bt_gatt_service_unregister(&lookup_svc),
+		     "Lookup service unregister failed");
+	zassert_is_null(lookup_handle(first), "Unregistered attribute found");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -273,6 +353,7 @@ void test_main(void)
 			 ztest_unit_test(test_gatt_unregister),
 			 ztest_unit_test(test_gatt_foreach),
 			 ztest_unit_test(test_gatt_read),
-			 ztest_unit_test(test_gatt_write));
+			 ztest_unit_test(test_gatt_write),
+			 ztest_unit_test(test_gatt_lookup));
 	ztest_run_test_suite(test_gatt);
 }
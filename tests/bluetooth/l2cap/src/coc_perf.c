@@ -0,0 +1,515 @@
+/* coc_perf.c - L2CAP credit based channel throughput */
+
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <stddef.h>
+#include <ztest.h>
+
+#include <bluetooth/hci.h>
+#include <bluetooth/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/l2cap.h>
+#include <drivers/bluetooth/hci_driver.h>
+#include <sys/byteorder.h>
+
+/* The test driver emulates a controller connected to a peer which accepts
+ * the channel and returns credits as it receives the K-frames, unless it is
+ * told not to.
+ */
+#define CONN_HANDLE	0x0001
+#define ACL_MTU		251
+#define ACL_PKTS	8
+
+#define PSM		0x0080
+#define PEER_CID	0x0040
+#define PEER_MTU	2048
+#define PEER_MPS	247
+#define PEER_CREDITS	32
+/* Credits returned each time that many K-frames have been received */
+#define CREDITS_BATCH	8
+
+#define SDU_FRAGS	4
+#define SDU_LEN		(SDU_FRAGS * PEER_MPS - BT_L2CAP_SDU_HDR_SIZE)
+#define SDU_COUNT	4
+#define SDU_ROUNDS	64
+
+/* Without credits returned, the SDUs of both kinds use the initial credits */
+BUILD_ASSERT(2 * SDU_COUNT * SDU_FRAGS <= PEER_CREDITS);
+
+/* L2CAP signaling, not part of the public API */
+#define L2CAP_CID_LE_SIG	0x0005
+#define L2CAP_LE_CONN_REQ	0x14
+#define L2CAP_LE_CONN_RSP	0x15
+#define L2CAP_LE_CREDITS	0x16
+
+struct l2cap_sig_hdr {
+	uint8_t  code;
+	uint8_t  ident;
+	uint16_t len;
+} __packed;
+
+struct l2cap_le_conn_req {
+	uint16_t psm;
+	uint16_t scid;
+	uint16_t mtu;
+	uint16_t mps;
+	uint16_t credits;
+} __packed;
+
+struct l2cap_le_conn_rsp {
+	uint16_t dcid;
+	uint16_t mtu;
+	uint16_t mps;
+	uint16_t credits;
+	uint16_t result;
+} __packed;
+
+struct l2cap_le_credits {
+	uint16_t cid;
+	uint16_t credits;
+} __packed;
+
+/* State of the emulated peer */
+static struct {
+	uint16_t scid;
+	uint16_t kframes;
+	uint16_t sdu_len;
+	uint16_t sdu_offset;
+	uint32_t sdus;
+	uint32_t errors;
+	bool no_credits;
+} peer;
+
+static void evt_create(struct net_buf *buf, uint8_t evt, uint8_t len)
+{
+	struct bt_hci_evt_hdr *hdr;
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = evt;
+	hdr->len = len;
+}
+
+/* Command complete with success status, the return parameters are zeroed
+ * except for the commands the host needs actual values from.
+ */
+static void cmd_complete(uint16_t opcode)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+	struct net_buf *buf;
+	uint8_t *params;
+	/* Largest return parameters read by the host */
+	uint8_t plen = sizeof(struct bt_hci_rp_read_supported_commands);
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+	evt_create(buf, BT_HCI_EVT_CMD_COMPLETE, sizeof(*cc) + plen);
+	cc = net_buf_add(buf, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+	params = net_buf_add(buf, plen);
+	(void)memset(params, 0, plen);
+
+	switch (opcode) {
+	case BT_HCI_OP_READ_LOCAL_FEATURES: {
+		struct bt_hci_rp_read_local_features *rp = (void *)params;
+
+		/* LE supported, BR/EDR not supported */
+		rp->features[4] = BIT(5) | BIT(6);
+		break;
+	}
+	case BT_HCI_OP_READ_SUPPORTED_COMMANDS: {
+		struct bt_hci_rp_read_supported_commands *rp = (void *)params;
+
+		(void)memset(rp->commands, 0xFF, sizeof(rp->commands));
+		rp->status = 0x00;
+		break;
+	}
+	case BT_HCI_OP_LE_READ_BUFFER_SIZE: {
+		struct bt_hci_rp_le_read_buffer_size *rp = (void *)params;
+
+		rp->le_max_len = sys_cpu_to_le16(ACL_MTU);
+		rp->le_max_num = ACL_PKTS;
+		break;
+	}
+	default:
+		break;
+	}
+
+	bt_recv_prio(buf);
+}
+
+static void num_completed_packets(void)
+{
+	struct bt_hci_evt_num_completed_packets *ev;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_NUM_COMPLETED_PACKETS, false,
+			     K_FOREVER);
+	evt_create(buf, BT_HCI_EVT_NUM_COMPLETED_PACKETS,
+		   sizeof(*ev) + sizeof(ev->h[0]));
+	ev = net_buf_add(buf, sizeof(*ev) + sizeof(ev->h[0]));
+	ev->num_handles = 1U;
+	ev->h[0].handle = sys_cpu_to_le16(CONN_HANDLE);
+	ev->h[0].count = sys_cpu_to_le16(1);
+
+	bt_recv_prio(buf);
+}
+
+/* Send a signaling PDU from the peer to the host */
+static void *sig_create(struct net_buf **buf, uint8_t code, uint8_t ident,
+			uint16_t len)
+{
+	struct bt_hci_acl_hdr *acl;
+	struct bt_l2cap_hdr *l2cap;
+	struct l2cap_sig_hdr *sig;
+
+	*buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
+	acl = net_buf_add(*buf, sizeof(*acl));
+	acl->handle = sys_cpu_to_le16(bt_acl_handle_pack(CONN_HANDLE,
+							 BT_ACL_START));
+	acl->len = sys_cpu_to_le16(sizeof(*l2cap) + sizeof(*sig) + len);
+	l2cap = net_buf_add(*buf, sizeof(*l2cap));
+	l2cap->len = sys_cpu_to_le16(sizeof(*sig) + len);
+	l2cap->cid = sys_cpu_to_le16(L2CAP_CID_LE_SIG);
+	sig = net_buf_add(*buf, sizeof(*sig));
+	sig->code = code;
+	sig->ident = ident;
+	sig->len = sys_cpu_to_le16(len);
+
+	return net_buf_add(*buf, len);
+}
+
+static void peer_sig_recv(struct net_buf *buf)
+{
+	struct l2cap_le_conn_req *req;
+	struct l2cap_le_conn_rsp *rsp;
+	struct l2cap_sig_hdr *sig;
+	struct net_buf *rbuf;
+
+	sig = net_buf_pull_mem(buf, sizeof(*sig));
+	if (sig->code != L2CAP_LE_CONN_REQ) {
+		/* Nothing else is expected from the host */
+		return;
+	}
+
+	req = (void *)buf->data;
+	peer.scid = sys_le16_to_cpu(req->scid);
+
+	rsp = sig_create(&rbuf, L2CAP_LE_CONN_RSP, sig->ident, sizeof(*rsp));
+	rsp->dcid = sys_cpu_to_le16(PEER_CID);
+	rsp->mtu = sys_cpu_to_le16(PEER_MTU);
+	rsp->mps = sys_cpu_to_le16(PEER_MPS);
+	rsp->credits = sys_cpu_to_le16(PEER_CREDITS);
+	rsp->result = 0U;
+
+	bt_recv(rbuf);
+}
+
+static void peer_credits_send(uint16_t credits)
+{
+	struct l2cap_le_credits *ev;
+	struct net_buf *rbuf;
+
+	ev = sig_create(&rbuf, L2CAP_LE_CREDITS, 1U, sizeof(*ev));
+	ev->cid = sys_cpu_to_le16(PEER_CID);
+	ev->credits = sys_cpu_to_le16(credits);
+
+	bt_recv(rbuf);
+}
+
+static void peer_kframe_recv(struct net_buf *buf)
+{
+	if (!peer.sdu_len) {
+		peer.sdu_len = net_buf_pull_le16(buf);
+		peer.sdu_offset = 0U;
+	}
+
+	/* The SDU bytes are numbered from the start of the SDU */
+	for (uint16_t i = 0; i < buf->len; i++) {
+		if (buf->data[i] != (uint8_t)(peer.sdu_offset + i)) {
+			peer.errors++;
+			break;
+		}
+	}
+
+	peer.sdu_offset += buf->len;
+	if (peer.sdu_offset >= peer.sdu_len) {
+		if (peer.sdu_offset != peer.sdu_len) {
+			peer.errors++;
+		}
+		peer.sdu_len = 0U;
+		peer.sdus++;
+	}
+
+	if (peer.no_credits) {
+		return;
+	}
+
+	if (++peer.kframes == CREDITS_BATCH) {
+		peer.kframes = 0U;
+		peer_credits_send(CREDITS_BATCH);
+	}
+}
+
+static int driver_open(void)
+{
+	return 0;
+}
+
+static int driver_send(struct net_buf *buf)
+{
+	struct bt_hci_cmd_hdr *chdr;
+	struct bt_l2cap_hdr *l2cap;
+
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_CMD:
+		chdr = net_buf_pull_mem(buf, sizeof(*chdr));
+		cmd_complete(sys_le16_to_cpu(chdr->opcode));
+		break;
+	case BT_BUF_ACL_OUT:
+		/* The host never fragments the K-frames, ACL_MTU fits them */
+		net_buf_pull(buf, sizeof(struct bt_hci_acl_hdr));
+		l2cap = net_buf_pull_mem(buf, sizeof(*l2cap));
+
+		if (sys_le16_to_cpu(l2cap->cid) == L2CAP_CID_LE_SIG) {
+			peer_sig_recv(buf);
+		} else if (sys_le16_to_cpu(l2cap->cid) == PEER_CID) {
+			peer_kframe_recv(buf);
+		}
+
+		num_completed_packets();
+		break;
+	default:
+		break;
+	}
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static const struct bt_hci_driver drv = {
+	.name         = "test",
+	.bus          = BT_HCI_DRIVER_BUS_VIRTUAL,
+	.open         = driver_open,
+	.send         = driver_send,
+	.quirks       = BT_QUIRK_NO_RESET,
+};
+
+/* Connect the emulated peer to the advertising host */
+static void peer_connect(void)
+{
+	struct bt_hci_evt_le_conn_complete *ev;
+	struct bt_hci_evt_le_meta_event *meta;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_rx(BT_BUF_EVT, K_FOREVER);
+	evt_create(buf, BT_HCI_EVT_LE_META_EVENT, sizeof(*meta) + sizeof(*ev));
+	meta = net_buf_add(buf, sizeof(*meta));
+	meta->subevent = BT_HCI_EVT_LE_CONN_COMPLETE;
+	ev = net_buf_add(buf, sizeof(*ev));
+	(void)memset(ev, 0, sizeof(*ev));
+	ev->status = BT_HCI_ERR_SUCCESS;
+	ev->handle = sys_cpu_to_le16(CONN_HANDLE);
+	ev->role = BT_HCI_ROLE_SLAVE;
+	ev->peer_addr.type = BT_ADDR_LE_RANDOM;
+	ev->peer_addr.a.val[5] = 0xc0;
+	ev->interval = sys_cpu_to_le16(BT_GAP_INIT_CONN_INT_MIN);
+	ev->supv_timeout = sys_cpu_to_le16(400);
+
+	bt_recv(buf);
+}
+
+static struct bt_conn *default_conn;
+static K_SEM_DEFINE(conn_sem, 0, 1);
+static K_SEM_DEFINE(chan_sem, 0, 1);
+static K_SEM_DEFINE(sent_sem, 0, SDU_ROUNDS);
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (!err) {
+		default_conn = bt_conn_ref(conn);
+		k_sem_give(&conn_sem);
+	}
+}
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+};
+
+static void chan_connected(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&chan_sem);
+}
+
+static int chan_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	return 0;
+}
+
+static void chan_sent(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&sent_sem);
+}
+
+static const struct bt_l2cap_chan_ops chan_ops = {
+	.connected = chan_connected,
+	.recv = chan_recv,
+	.sent = chan_sent,
+};
+
+static struct bt_l2cap_le_chan le_chan = {
+	.chan.ops = &chan_ops,
+};
+
+/* SDUs in a single buffer, segmented by copying */
+NET_BUF_POOL_FIXED_DEFINE(sdu_pool, SDU_COUNT, BT_L2CAP_SDU_BUF_SIZE(SDU_LEN),
+			  NULL);
+
+/* SDUs as fragments fitting the MPS, each one sent as a K-frame */
+NET_BUF_POOL_FIXED_DEFINE(frag_pool, SDU_COUNT * SDU_FRAGS,
+			  BT_L2CAP_BUF_SIZE(PEER_MPS), NULL);
+
+static void sdu_fill(struct net_buf *buf, uint16_t offset, uint16_t len)
+{
+	uint8_t *data = net_buf_add(buf, len);
+
+	for (uint16_t i = 0; i < len; i++) {
+		data[i] = offset + i;
+	}
+}
+
+static struct net_buf *sdu_contiguous_get(void)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc(&sdu_pool, K_FOREVER);
+	net_buf_reserve(buf, BT_L2CAP_SDU_CHAN_SEND_RESERVE);
+	sdu_fill(buf, 0U, SDU_LEN);
+
+	return buf;
+}
+
+static struct net_buf *sdu_fragmented_get(void)
+{
+	struct net_buf *buf, *frag;
+	uint16_t len;
+
+	buf = net_buf_alloc(&frag_pool, K_FOREVER);
+	net_buf_reserve(buf, BT_L2CAP_SDU_CHAN_SEND_RESERVE);
+	sdu_fill(buf, 0U, PEER_MPS - BT_L2CAP_SDU_HDR_SIZE);
+
+	for (len = buf->len; len < SDU_LEN; len += frag->len) {
+		frag = net_buf_alloc(&frag_pool, K_FOREVER);
+		net_buf_reserve(frag, BT_L2CAP_CHAN_SEND_RESERVE);
+		sdu_fill(frag, len, MIN(PEER_MPS, SDU_LEN - len));
+		net_buf_frag_add(buf, frag);
+	}
+
+	return buf;
+}
+
+static void sdus_send(int count, struct net_buf *(*sdu_get)(void))
+{
+	uint32_t sdus = peer.sdus;
+	int err;
+
+	for (int i = 0; i < count; i++) {
+		err = bt_l2cap_chan_send(&le_chan.chan, sdu_get());
+		zassert_true(err >= 0, "Unable to send SDU: %d", err);
+	}
+
+	for (int i = 0; i < count; i++) {
+		err = k_sem_take(&sent_sem, K_SECONDS(5));
+		zassert_equal(err, 0, "SDU %d not sent", i);
+	}
+
+	zassert_equal(peer.sdus - sdus, count, "SDUs lost");
+	zassert_equal(peer.errors, 0, "Corrupted SDUs received");
+}
+
+static void coc_perf(const char *what, struct net_buf *(*sdu_get)(void))
+{
+	uint32_t cycles;
+	uint64_t us;
+
+	cycles = k_cycle_get_32();
+	sdus_send(SDU_ROUNDS, sdu_get);
+	us = k_cyc_to_us_ceil64(k_cycle_get_32() - cycles);
+
+	TC_PRINT("%s: %u SDUs of %u bytes in %llu us, %llu kB/s\n", what,
+		 SDU_ROUNDS, SDU_LEN, us,
+		 (uint64_t)SDU_ROUNDS * SDU_LEN * 1000U / MAX(us, 1U));
+}
+
+/* Connect the channel to the emulated peer, once for all the tests */
+static void coc_connect(void)
+{
+	int err;
+
+	if (default_conn) {
+		return;
+	}
+
+	bt_hci_driver_register(&drv);
+	err = bt_enable(NULL);
+	zassert_equal(err, 0, "bt_enable failed: %d", err);
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	err = bt_le_adv_start(BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONNECTABLE |
+					      BT_LE_ADV_OPT_ONE_TIME,
+					      BT_GAP_ADV_FAST_INT_MIN_2,
+					      BT_GAP_ADV_FAST_INT_MAX_2, NULL),
+			      NULL, 0, NULL, 0);
+	zassert_equal(err, 0, "Advertising failed: %d", err);
+
+	peer_connect();
+	err = k_sem_take(&conn_sem, K_SECONDS(1));
+	zassert_equal(err, 0, "Not connected");
+
+	err = bt_l2cap_chan_connect(default_conn, &le_chan.chan, PSM);
+	zassert_equal(err, 0, "Channel connect failed: %d", err);
+	err = k_sem_take(&chan_sem, K_SECONDS(1));
+	zassert_equal(err, 0, "Channel not connected");
+}
+
+/**
+ * @brief Send SDUs with the credits granted when the channel was connected
+ *
+ * @details The peer returns no credits during the transfer, so the sending
+ * only resumes from the completion of the segments when it runs out of
+ * buffers. The credits are given back at the end.
+ */
+void test_l2cap_coc_no_credits(void)
+{
+	coc_connect();
+
+	peer.no_credits = true;
+	sdus_send(SDU_COUNT, sdu_contiguous_get);
+	sdus_send(SDU_COUNT, sdu_fragmented_get);
+	peer.no_credits = false;
+
+	peer.kframes = 0U;
+	peer_credits_send(2 * SDU_COUNT * SDU_FRAGS);
+}
+
+/**
+ * @brief Measure the throughput of a credit based channel
+ *
+ * @details The SDUs are sent to an emulated peer through a test HCI driver,
+ * either as single buffers which are segmented by copying, or as chains of
+ * fragments which are used as K-frames directly.
+ */
+void test_l2cap_coc_perf(void)
+{
+	coc_connect();
+
+	coc_perf("copy", sdu_contiguous_get);
+	coc_perf("zero-copy", sdu_fragmented_get);
+}
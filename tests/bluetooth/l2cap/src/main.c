@@ -69,10 +69,15 @@ void test_l2cap_register(void)
 		     "Test dynamic PSM server duplicate succeeded");
 }
 
+void test_l2cap_coc_no_credits(void);
+void test_l2cap_coc_perf(void);
+
 /*test case main entry*/
 void test_main(void)
 {
 	ztest_test_suite(test_l2cap,
-			 ztest_unit_test(test_l2cap_register));
+			 ztest_unit_test(test_l2cap_register),
+			 ztest_unit_test(test_l2cap_coc_no_credits),
+			 ztest_unit_test(test_l2cap_coc_perf));
 	ztest_run_test_suite(test_l2cap);
 }
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <bluetooth/mesh.h>
+
+#include "net.h"
+#include "access.h"
+
+#define PRIMARY_ADDR 0x0100
+#define APP_IDX 0x000
+#define TEST_CID 0x0059
+#define OTHER_CID 0x0060
+/* Group all the models subscribe to */
+#define TEST_GROUP 0xc001
+
+/* Opcodes of the test models, one of each length */
+#define OP_1 BT_MESH_MODEL_OP_1(0x01)
+#define OP_2 BT_MESH_MODEL_OP_2(0x82, 0x01)
+#define OP_SHADOWED BT_MESH_MODEL_OP_2(0x82, 0x02)
+#define OP_LONG BT_MESH_MODEL_OP_2(0x82, 0x03)
+#define OP_VND BT_MESH_MODEL_OP_3(0x01, TEST_CID)
+/* Opcodes no model supports */
+#define OP_UNKNOWN BT_MESH_MODEL_OP_2(0x82, 0x7f)
+#define OP_VND_OTHER BT_MESH_MODEL_OP_3(0x01, OTHER_CID)
+
+#define PAYLOAD_LEN 4
+#define MAX_CALLS 8
+
+static struct {
+	struct bt_mesh_model *model;
+	uint32_t opcode;
+} calls[MAX_CALLS];
+static int call_cnt;
+
+static void handler(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		    struct net_buf_simple *buf, uint32_t opcode)
+{
+	zassert_true(call_cnt < MAX_CALLS, "Too many calls");
+	zassert_equal(buf->len, PAYLOAD_LEN, "Payload not restored");
+
+	/* Consume the payload, the next model must get it again */
+	net_buf_simple_pull(buf, buf->len);
+
+	calls[call_cnt].model = model;
+	calls[call_cnt].opcode = opcode;
+	call_cnt++;
+}
+
+#define HANDLER(_op)                                                          \
+	static void handler_##_op(struct bt_mesh_model *model,                \
+				  struct bt_mesh_msg_ctx *ctx,                \
+				  struct net_buf_simple *buf)                 \
+	{                                                                     \
+		handler(model, ctx, buf, _op);                                \
+	}
+
+HANDLER(OP_1)
+HANDLER(OP_2)
+HANDLER(OP_SHADOWED)
+HANDLER(OP_LONG)
+HANDLER(OP_VND)
+
+static const struct bt_mesh_model_op model_a_op[] = {
+	{ OP_1, 0, handler_OP_1 },
+	{ OP_2, 0, handler_OP_2 },
+	{ OP_SHADOWED, 0, handler_OP_SHADOWED },
+	BT_MESH_MODEL_OP_END,
+};
+
+/* The opcode shared with model A is only received by model A */
+static const struct bt_mesh_model_op model_b_op[] = {
+	{ OP_SHADOWED, 0, handler_OP_SHADOWED },
+	{ OP_LONG, PAYLOAD_LEN + 1, handler_OP_LONG },
+	BT_MESH_MODEL_OP_END,
+};
+
+static const struct bt_mesh_model_op model_c_op[] = {
+	{ OP_1, 0, handler_OP_1 },
+	BT_MESH_MODEL_OP_END,
+};
+
+static const struct bt_mesh_model_op model_vnd_op[] = {
+	{ OP_VND, 0, handler_OP_VND },
+	BT_MESH_MODEL_OP_END,
+};
+
+static struct bt_mesh_model elem0_models[] = {
+	BT_MESH_MODEL(0x1000, model_a_op, NULL, NULL),
+	BT_MESH_MODEL(0x1002, model_b_op, NULL, NULL),
+};
+
+static struct bt_mesh_model elem0_vnd_models[] = {
+	BT_MESH_MODEL_VND(TEST_CID, 0x0001, model_vnd_op, NULL, NULL),
+};
+
+static struct bt_mesh_model elem1_models[] = {
+	BT_MESH_MODEL(0x1000, model_c_op, NULL, NULL),
+};
+
+static struct bt_mesh_model elem1_vnd_models[] = {
+	BT_MESH_MODEL_VND(TEST_CID, 0x0001, model_vnd_op, NULL, NULL),
+};
+
+static struct bt_mesh_elem elems[] = {
+	BT_MESH_ELEM(0, elem0_models, elem0_vnd_models),
+	BT_MESH_ELEM(0, elem1_models, elem1_vnd_models),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = TEST_CID,
+	.elem = elems,
+	.elem_count = ARRAY_SIZE(elems),
+};
+
+static void model_key_bind(struct bt_mesh_model *mod,
+			   struct bt_mesh_elem *elem, bool vnd, bool primary,
+			   void *user_data)
+{
+	mod->keys[0] = APP_IDX;
+	mod->groups[0] = TEST_GROUP;
+}
+
+/* Receive a message and return the number of models it was dispatched to */
+static int msg_recv(uint32_t opcode, uint16_t dst, uint16_t app_idx)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_MODEL_BUF_LEN(OP_VND, PAYLOAD_LEN));
+	struct bt_mesh_net_rx rx = {
+		.ctx = {
+			.app_idx = app_idx,
+			.addr = 0x0001,
+			.recv_dst = dst,
+		},
+	};
+
+	bt_mesh_model_msg_init(&buf, opcode);
+	net_buf_simple_add_le32(&buf, 0x12345678);
+
+	call_cnt = 0;
+	bt_mesh_model_recv(&rx, &buf);
+
+	return call_cnt;
+}
+
+static void call_check(int idx, struct bt_mesh_model *model, uint32_t opcode)
+{
+	zassert_equal_ptr(calls[idx].model, model, "Call %d: wrong model", idx);
+	zassert_equal(calls[idx].opcode, opcode, "Call %d: wrong opcode", idx);
+}
+
+/**
+ * @brief Dispatch of SIG opcodes to the models of the destination element
+ */
+void test_sig_op(void)
+{
+	zassert_equal(msg_recv(OP_1, PRIMARY_ADDR, APP_IDX), 1, NULL);
+	call_check(0, &elem0_models[0], OP_1);
+
+	zassert_equal(msg_recv(OP_2, PRIMARY_ADDR, APP_IDX), 1, NULL);
+	call_check(0, &elem0_models[0], OP_2);
+
+	zassert_equal(msg_recv(OP_1, PRIMARY_ADDR + 1, APP_IDX), 1, NULL);
+	call_check(0, &elem1_models[0], OP_1);
+
+	/* Only the first model of the element supporting the opcode */
+	zassert_equal(msg_recv(OP_SHADOWED, PRIMARY_ADDR, APP_IDX), 1, NULL);
+	call_check(0, &elem0_models[0], OP_SHADOWED);
+
+	/* Messages shorter than the minimum length are dropped */
+	zassert_equal(msg_recv(OP_LONG, PRIMARY_ADDR, APP_IDX), 0, NULL);
+}
+
+/**
+ * @brief Dispatch of vendor opcodes, only to the models of their company
+ */
+void test_vnd_op(void)
+{
+	zassert_equal(msg_recv(OP_VND, PRIMARY_ADDR, APP_IDX), 1, NULL);
+	call_check(0, &elem0_vnd_models[0], OP_VND);
+
+	zassert_equal(msg_recv(OP_VND, PRIMARY_ADDR + 1, APP_IDX), 1, NULL);
+	call_check(0, &elem1_vnd_models[0], OP_VND);
+
+	zassert_equal(msg_recv(OP_VND_OTHER, PRIMARY_ADDR, APP_IDX), 0, NULL);
+}
+
+/**
+ * @brief Messages no model can receive are not dispatched
+ */
+void test_unknown_op(void)
+{
+	zassert_equal(msg_recv(OP_UNKNOWN, PRIMARY_ADDR, APP_IDX), 0, NULL);
+	zassert_equal(msg_recv(OP_UNKNOWN, BT_MESH_ADDR_ALL_NODES, APP_IDX), 0,
+		      NULL);
+
+	/* Known opcode, but not bound to the key or not on the element */
+	zassert_equal(msg_recv(OP_1, PRIMARY_ADDR, APP_IDX + 1), 0, NULL);
+	zassert_equal(msg_recv(OP_2, PRIMARY_ADDR + 1, APP_IDX), 0, NULL);
+	zassert_equal(msg_recv(OP_1, PRIMARY_ADDR + 2, APP_IDX), 0, NULL);
+}
+
+/**
+ * @brief Fixed group addresses reach the models of the primary element
+ */
+void test_fixed_group(void)
+{
+	zassert_equal(msg_recv(OP_1, BT_MESH_ADDR_ALL_NODES, APP_IDX), 1, NULL);
+	call_check(0, &elem0_models[0], OP_1);
+
+	zassert_equal(msg_recv(OP_VND, BT_MESH_ADDR_ALL_NODES, APP_IDX), 1,
+		      NULL);
+	call_check(0, &elem0_vnd_models[0], OP_VND);
+}
+
+/**
+ * @brief Group addresses reach the models of every element, in order
+ */
+void test_group(void)
+{
+	zassert_equal(msg_recv(OP_1, TEST_GROUP, APP_IDX), 2, NULL);
+	call_check(0, &elem0_models[0], OP_1);
+	call_check(1, &elem1_models[0], OP_1);
+
+	zassert_equal(msg_recv(OP_VND, TEST_GROUP, APP_IDX), 2, NULL);
+	call_check(0, &elem0_vnd_models[0], OP_VND);
+	call_check(1, &elem1_vnd_models[0], OP_VND);
+
+	zassert_equal(msg_recv(OP_SHADOWED, TEST_GROUP, APP_IDX), 1, NULL);
+	call_check(0, &elem0_models[0], OP_SHADOWED);
+
+	zassert_equal(msg_recv(OP_UNKNOWN, TEST_GROUP, APP_IDX), 0, NULL);
+	zassert_equal(msg_recv(OP_1, TEST_GROUP + 1, APP_IDX), 0, NULL);
+}
+
+void test_main(void)
+{
+	zassert_equal(bt_mesh_comp_register(&comp), 0, "Registration failed");
+	bt_mesh_comp_provision(PRIMARY_ADDR);
+	bt_mesh_model_foreach(model_key_bind, NULL);
+
+	ztest_test_suite(bt_mesh_access,
+			 ztest_unit_test(test_sig_op),
+			 ztest_unit_test(test_vnd_op),
+			 ztest_unit_test(test_unknown_op),
+			 ztest_unit_test(test_fixed_group),
+			 ztest_unit_test(test_group)
+			 );
+	ztest_run_test_suite(bt_mesh_access);
+}
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <bluetooth/mesh.h>
+
+#include "crypto.h"
+#include "foundation.h"
+
+#define NET_IDX 0x001
+#define APP_IDX 0x002
+
+/* Sample data of the Mesh Profile Specification, section 8.1 */
+static const uint8_t k2_n[16] = {
+	0xf7, 0xa2, 0xa4, 0x4f, 0x8e, 0x8a, 0x80, 0x29,
+	0x06, 0x4f, 0x17, 0x3d, 0xdc, 0x1e, 0x2b, 0x00,
+};
+static const uint8_t k2_p[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+};
+static const struct {
+	uint8_t nid;
+	uint8_t enc[16];
+	uint8_t priv[16];
+} k2_master = {
+	0x7f,
+	{ 0x9f, 0x58, 0x91, 0x81, 0xa0, 0xf5, 0x0d, 0xe7,
+	  0x3c, 0x80, 0x70, 0xc7, 0xa6, 0xd2, 0x7f, 0x46 },
+	{ 0x4c, 0x71, 0x5b, 0xd4, 0xa6, 0x4b, 0x93, 0x8f,
+	  0x99, 0xb4, 0x53, 0x35, 0x16, 0x53, 0x12, 0x4f },
+}, k2_friend = {
+	0x73,
+	{ 0x11, 0xef, 0xec, 0x06, 0x42, 0x77, 0x49, 0x92,
+	  0x51, 0x0f, 0xb5, 0x92, 0x96, 0x46, 0xdf, 0x49 },
+	{ 0xd4, 0xd7, 0xcc, 0x0d, 0xfa, 0x77, 0x2d, 0x83,
+	  0x6a, 0x8d, 0xf9, 0xdf, 0x55, 0x10, 0xd7, 0xa7 },
+};
+static const uint8_t k3_out[8] = {
+	0xff, 0x04, 0x69, 0x58, 0x23, 0x3d, 0xb0, 0x14,
+};
+static const uint8_t k4_n[16] = {
+	0x32, 0x16, 0xd1, 0x50, 0x98, 0x84, 0xb5, 0x33,
+	0x24, 0x85, 0x41, 0x79, 0x2b, 0x87, 0x7f, 0x98,
+};
+#define K4_OUT 0x38
+static const uint8_t net_key[16] = {
+	0x7d, 0xd7, 0x36, 0x4c, 0xd8, 0x42, 0xad, 0x18,
+	0xc1, 0x7c, 0x2b, 0x82, 0x0c, 0x84, 0xc3, 0xd6,
+};
+static const uint8_t beacon_key[16] = {
+	0x54, 0x23, 0xd9, 0x67, 0xda, 0x63, 0x9a, 0x99,
+	0xcb, 0x02, 0x23, 0x1a, 0x83, 0xf7, 0xd2, 0x54,
+};
+static const uint8_t identity_key[16] = {
+	0x84, 0x39, 0x6c, 0x43, 0x5a, 0xc4, 0x85, 0x60,
+	0xb5, 0x96, 0x53, 0x85, 0x25, 0x3e, 0x21, 0x0c,
+};
+
+/* Keys of the key refresh procedure */
+static const uint8_t net_key_old[16] = { 0x01, 0x01 };
+static const uint8_t net_key_new[16] = { 0x01, 0x02 };
+static const uint8_t app_key_old[16] = { 0x02, 0x01 };
+static const uint8_t app_key_new[16] = { 0x02, 0x02 };
+
+static const struct bt_mesh_model_op model_op[] = {
+	BT_MESH_MODEL_OP_END,
+};
+
+static struct bt_mesh_model models[] = {
+	BT_MESH_MODEL(0x1000, model_op, NULL, NULL),
+};
+
+static struct bt_mesh_elem elems[] = {
+	BT_MESH_ELEM(0, models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = 0x0059,
+	.elem = elems,
+	.elem_count = ARRAY_SIZE(elems),
+};
+
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+/* Counters at the last check */
+static struct bt_mesh_crypto_cache_stats last_stats;
+
+static struct bt_mesh_crypto_cache_stats cache_stats_get(void)
+{
+	struct bt_mesh_crypto_cache_stats stats;
+
+	bt_mesh_crypto_cache_stats_get(&stats);
+
+	return stats;
+}
+
+static void cache_clear(void)
+{
+	bt_mesh_crypto_cache_clear();
+	last_stats = cache_stats_get();
+}
+
+/* Check the hits and misses since the last check */
+static void cache_check(uint32_t hits, uint32_t misses)
+{
+	struct bt_mesh_crypto_cache_stats stats = cache_stats_get();
+
+	zassert_equal(stats.hits - last_stats.hits, hits, "Cache hits");
+	zassert_equal(stats.misses - last_stats.misses, misses,
+		      "Cache misses");
+
+	last_stats = stats;
+}
+
+static void cache_count_check(uint16_t entries, uint16_t beacon_keys)
+{
+	struct bt_mesh_crypto_cache_stats stats = cache_stats_get();
+
+	zassert_equal(stats.entries, entries, "Cached entries");
+	zassert_equal(stats.beacon_keys, beacon_keys, "Cached beacon keys");
+}
+
+/* Check if the material derived from the key is cached, without leaving
+ * the material derived by the check in the cache.
+ */
+static bool k3_cached(const uint8_t n[16])
+{
+	uint32_t hits = cache_stats_get().hits;
+	uint8_t net_id[8];
+
+	zassert_ok(bt_mesh_k3(n, net_id), NULL);
+
+	if (cache_stats_get().hits == hits) {
+		bt_mesh_crypto_cache_evict(n);
+		return false;
+	}
+
+	return true;
+}
+
+static bool k4_cached(const uint8_t n[16])
+{
+	uint32_t hits = cache_stats_get().hits;
+	uint8_t aid;
+
+	zassert_ok(bt_mesh_k4(n, &aid), NULL);
+
+	if (cache_stats_get().hits == hits) {
+		bt_mesh_crypto_cache_evict(n);
+		return false;
+	}
+
+	return true;
+}
+#else
+static void cache_clear(void)
+{
+}
+
+static void cache_check(uint32_t hits, uint32_t misses)
+{
+}
+#endif
+
+/**
+ * @brief Test k2 against the specification and the cached outputs
+ *
+ * @details The outputs are keyed by both N and P, the master and friendship
+ * credentials of a key are cached separately.
+ */
+void test_k2(void)
+{
+	uint8_t nid, enc[16], priv[16];
+
+	cache_clear();
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(bt_mesh_k2(k2_n, (uint8_t[]){ 0x00 }, 1, &nid, enc,
+				      priv), NULL);
+		zassert_equal(nid, k2_master.nid, "Bad NID");
+		zassert_mem_equal(enc, k2_master.enc, 16, "Bad EncKey");
+		zassert_mem_equal(priv, k2_master.priv, 16, "Bad PrivacyKey");
+
+		zassert_ok(bt_mesh_k2(k2_n, k2_p, sizeof(k2_p), &nid, enc,
+				      priv), NULL);
+		zassert_equal(nid, k2_friend.nid, "Bad NID");
+		zassert_mem_equal(enc, k2_friend.enc, 16, "Bad EncKey");
+		zassert_mem_equal(priv, k2_friend.priv, 16, "Bad PrivacyKey");
+
+		cache_check(i ? 2 : 0, i ? 0 : 2);
+	}
+}
+
+/**
+ * @brief Test k3 against the specification and an uncached derivation
+ */
+void test_k3(void)
+{
+	uint8_t salt[16], ref[16], out[8];
+
+	zassert_ok(bt_mesh_s1("smk3", salt), NULL);
+	zassert_ok(bt_mesh_k1(k2_n, 16, salt, "id64\x01", ref), NULL);
+	zassert_mem_equal(&ref[8], k3_out, 8, "Bad reference");
+
+	cache_clear();
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(bt_mesh_k3(k2_n, out), NULL);
+		zassert_mem_equal(out, k3_out, 8, "Bad NetID");
+
+		cache_check(i, !i);
+	}
+}
+
+/**
+ * @brief Test k4 against the specification and an uncached derivation
+ */
+void test_k4(void)
+{
+	uint8_t salt[16], ref[16], aid;
+
+	zassert_ok(bt_mesh_s1("smk4", salt), NULL);
+	zassert_ok(bt_mesh_k1(k4_n, 16, salt, "id6\x01", ref), NULL);
+	zassert_equal(ref[15] & BIT_MASK(6), K4_OUT, "Bad reference");
+
+	cache_clear();
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(bt_mesh_k4(k4_n, &aid), NULL);
+		zassert_equal(aid, K4_OUT, "Bad AID");
+
+		cache_check(i, !i);
+	}
+}
+
+/**
+ * @brief Test the salts of id128 against an uncached derivation
+ *
+ * @details The beacon and identity keys use the cached salts of "nkbk" and
+ * "nkik", other salts are computed for each derivation.
+ */
+void test_salt(void)
+{
+	uint8_t salt[16], ref[16], out[16];
+
+	zassert_ok(bt_mesh_s1("nkbk", salt), NULL);
+	zassert_ok(bt_mesh_k1(net_key, 16, salt, "id128\x01", ref), NULL);
+	zassert_mem_equal(ref, beacon_key, 16, "Bad reference");
+
+	zassert_ok(bt_mesh_s1("nkik", salt), NULL);
+	zassert_ok(bt_mesh_k1(net_key, 16, salt, "id128\x01", ref), NULL);
+	zassert_mem_equal(ref, identity_key, 16, "Bad reference");
+
+	cache_clear();
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(bt_mesh_beacon_key(net_key, out), NULL);
+		zassert_mem_equal(out, beacon_key, 16, "Bad BeaconKey");
+
+		zassert_ok(bt_mesh_identity_key(net_key, out), NULL);
+		zassert_mem_equal(out, identity_key, 16, "Bad IdentityKey");
+
+		cache_check(i ? 2 : 0, i ? 0 : 2);
+	}
+
+	zassert_ok(bt_mesh_s1("test", salt), NULL);
+	zassert_ok(bt_mesh_k1(net_key, 16, salt, "id128\x01", ref), NULL);
+	zassert_ok(bt_mesh_id128(net_key, "test", out), NULL);
+	zassert_mem_equal(out, ref, 16, "Bad id128 of uncached salt");
+	cache_check(0, 0);
+}
+
+/**
+ * @brief Test that the key refresh procedure evicts the old keys
+ *
+ * @details The material derived from the old NetKey and AppKey is evicted
+ * when the old keys are revoked, the material of the new keys stays.
+ */
+void test_evict_key_refresh(void)
+{
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+	uint8_t phase;
+
+	cache_clear();
+
+	/* NetKey: k2, k3 and beacon key, AppKey: k4 */
+	zassert_equal(bt_mesh_subnet_add(NET_IDX, net_key_old),
+		      STATUS_SUCCESS, NULL);
+	zassert_equal(bt_mesh_app_key_add(APP_IDX, NET_IDX, app_key_old),
+		      STATUS_SUCCESS, NULL);
+	cache_count_check(4, 1);
+
+	zassert_equal(bt_mesh_subnet_update(NET_IDX, net_key_new),
+		      STATUS_SUCCESS, NULL);
+	zassert_equal(bt_mesh_app_key_update(APP_IDX, NET_IDX, app_key_new),
+		      STATUS_SUCCESS, NULL);
+	cache_count_check(8, 1);
+
+	/* Beacons are authenticated with the new key */
+	phase = BT_MESH_KR_PHASE_2;
+	zassert_equal(bt_mesh_subnet_kr_phase_set(NET_IDX, &phase),
+		      STATUS_SUCCESS, NULL);
+	cache_count_check(8, 2);
+
+	phase = BT_MESH_KR_PHASE_3;
+	zassert_equal(bt_mesh_subnet_kr_phase_set(NET_IDX, &phase),
+		      STATUS_SUCCESS, NULL);
+	cache_count_check(4, 1);
+
+	zassert_false(k3_cached(net_key_old), "Old NetKey not evicted");
+	zassert_true(k3_cached(net_key_new), "New NetKey evicted");
+	zassert_false(k4_cached(app_key_old), "Old AppKey not evicted");
+	zassert_true(k4_cached(app_key_new), "New AppKey evicted");
+	cache_count_check(4, 1);
+
+	zassert_equal(bt_mesh_subnet_del(NET_IDX), STATUS_SUCCESS, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test that deleted keys are evicted
+ *
+ * @details Deleting an AppKey evicts its material only, deleting a subnet
+ * evicts the material of the NetKey and of its AppKeys.
+ */
+void test_evict_del(void)
+{
+#if defined(CONFIG_BT_MESH_CRYPTO_CACHE)
+	cache_clear();
+
+	zassert_equal(bt_mesh_subnet_add(NET_IDX, net_key_old),
+		      STATUS_SUCCESS, NULL);
+	zassert_equal(bt_mesh_app_key_add(APP_IDX, NET_IDX, app_key_old),
+		      STATUS_SUCCESS, NULL);
+	zassert_equal(bt_mesh_app_key_add(APP_IDX + 1, NET_IDX, app_key_new),
+		      STATUS_SUCCESS, NULL);
+	cache_count_check(5, 1);
+
+	zassert_equal(bt_mesh_app_key_del(APP_IDX, NET_IDX), STATUS_SUCCESS,
+		      NULL);
+	cache_count_check(4, 1);
+	zassert_false(k4_cached(app_key_old), "Deleted AppKey not evicted");
+	zassert_true(k4_cached(app_key_new), "AppKey evicted");
+	zassert_true(k3_cached(net_key_old), "NetKey evicted");
+
+	zassert_equal(bt_mesh_subnet_del(NET_IDX), STATUS_SUCCESS, NULL);
+	cache_count_check(0, 0);
+	zassert_false(k3_cached(net_key_old), "Deleted NetKey not evicted");
+	zassert_false(k4_cached(app_key_new), "AppKey of subnet not evicted");
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_main(void)
+{
+	zassert_equal(bt_mesh_comp_register(&comp), 0, "Registration failed");
+
+	ztest_test_suite(bt_mesh_crypto,
+			 ztest_unit_test(test_k2),
+			 ztest_unit_test(test_k3),
+			 ztest_unit_test(test_k4),
+			 ztest_unit_test(test_salt),
+			 ztest_unit_test(test_evict_key_refresh),
+			 ztest_unit_test(test_evict_del)
+			 );
+	ztest_run_test_suite(bt_mesh_crypto);
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/byteorder.h>
+
+#include "hash_index.h"
+#include "relay_queue.h"
+
+/* Replay protection list of a large network, one entry per node */
+#define RPL_SIZE 255
+/* Network message cache, the oldest messages are evicted first */
+#define CACHE_SIZE 64
+#define CACHE_MSGS 4096
+#define LOOKUP_ROUNDS 16
+
+static uint16_t rpl[RPL_SIZE];
+BT_MESH_HASH_INDEX_DEFINE(rpl_index, RPL_SIZE);
+
+static uint32_t cache[CACHE_SIZE];
+BT_MESH_HASH_INDEX_DEFINE(cache_index, CACHE_SIZE);
+
+#define RELAY_QUEUE_SIZE 4
+BT_MESH_RELAY_QUEUE_DEFINE(relay_queue, RELAY_QUEUE_SIZE);
+
+#if defined(CONFIG_ARCH_POSIX)
+/* Table with more index slots than a 16-bit count, only where RAM allows */
+#define LARGE_SIZE 40000
+BT_MESH_HASH_INDEX_DEFINE(large_index, LARGE_SIZE);
+#endif
+
+/* Unicast addresses of multi-element nodes, like a provisioner assigns */
+static uint16_t node_addr(int node)
+{
+	return 0x0001 + node * 3;
+}
+
+static int rpl_linear_find(uint16_t src)
+{
+	for (int i = 0; i < RPL_SIZE; i++) {
+		if (rpl[i] == src) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void rpl_fill(void)
+{
+	bt_mesh_hash_index_clear(&rpl_index);
+
+	for (int i = 0; i < RPL_SIZE; i++) {
+		rpl[i] = node_addr(i);
+		bt_mesh_hash_index_add(&rpl_index, rpl[i], i);
+	}
+}
+
+/**
+ * @brief Check that entries stay reachable when others are removed
+ */
+void test_hash_index_del(void)
+{
+	rpl_fill();
+
+	/* Remove every other entry, the remaining ones are shifted back */
+	for (int i = 0; i < RPL_SIZE; i += 2) {
+		bt_mesh_hash_index_del(&rpl_index, rpl[i], i);
+	}
+
+	for (int i = 0; i < RPL_SIZE; i++) {
+		int idx = bt_mesh_hash_index_find(&rpl_index, rpl[i]);
+
+		if (i % 2) {
+			zassert_equal(idx, i, "Entry %d not found", i);
+		} else {
+			zassert_equal(idx, -ENOENT, "Removed entry %d found", i);
+		}
+	}
+
+	/* Removing a key indexed to another entry has no effect */
+	bt_mesh_hash_index_del(&rpl_index, rpl[1], 0);
+	zassert_equal(bt_mesh_hash_index_find(&rpl_index, rpl[1]), 1,
+		      "Entry removed with the wrong index");
+}
+
+/**
+ * @brief Check the largest table entry and tables of many entries
+ */
+void test_hash_index_large(void)
+{
+	rpl_fill();
+
+	/* The last entry of a table of 65535 entries is not a free slot */
+	bt_mesh_hash_index_add(&rpl_index, 0x10000, UINT16_MAX);
+	zassert_equal(bt_mesh_hash_index_find(&rpl_index, 0x10000), UINT16_MAX,
+		      "Last entry not found");
+	bt_mesh_hash_index_del(&rpl_index, 0x10000, UINT16_MAX);
+	zassert_equal(bt_mesh_hash_index_find(&rpl_index, 0x10000), -ENOENT,
+		      "Last entry not removed");
+
+#if defined(CONFIG_ARCH_POSIX)
+	bt_mesh_hash_index_clear(&large_index);
+
+	for (int i = 0; i < LARGE_SIZE; i++) {
+		bt_mesh_hash_index_add(&large_index, i * 3U + 1U, i);
+	}
+
+	for (int i = 0; i < LARGE_SIZE; i++) {
+		zassert_equal(bt_mesh_hash_index_find(&large_index,
+						      i * 3U + 1U), i,
+			      "Entry %d not found", i);
+	}
+#endif
+}
+
+/**
+ * @brief Measure replay protection list lookups
+ *
+ * @details Compares the hashed lookup with a linear scan of the list, for
+ * sources spread over the whole list.
+ */
+void test_rpl_lookup_perf(void)
+{
+	uint32_t linear, hashed;
+	int idx;
+
+	rpl_fill();
+
+	linear = k_cycle_get_32();
+	for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+		for (int i = 0; i < RPL_SIZE; i++) {
+			idx = rpl_linear_find(node_addr(i));
+			zassert_equal(idx, i, "Wrong entry");
+		}
+	}
+	linear = k_cycle_get_32() - linear;
+
+	hashed = k_cycle_get_32();
+	for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+		for (int i = 0; i < RPL_SIZE; i++) {
+			idx = bt_mesh_hash_index_find(&rpl_index, node_addr(i));
+			zassert_equal(idx, i, "Wrong entry");
+		}
+	}
+	hashed = k_cycle_get_32() - hashed;
+
+	TC_PRINT("RPL of %d entries: linear %llu ns, hashed %llu ns\n",
+		 RPL_SIZE,
+		 k_cyc_to_ns_ceil64(linear) / (LOOKUP_ROUNDS * RPL_SIZE),
+		 k_cyc_to_ns_ceil64(hashed) / (LOOKUP_ROUNDS * RPL_SIZE));
+}
+
+static uint32_t msg_key(int msg)
+{
+	/* Source and sequence number of a message relayed twice */
+	return ((uint32_t)node_addr((msg / 2) % RPL_SIZE) << 17) | (msg / 2);
+}
+
+/**
+ * @brief Measure network message cache lookups
+ *
+ * @details Every message is received twice, like relayed messages. The
+ * second copy has to be found in the cache and the first one not.
+ */
+void test_msg_cache_perf(void)
+{
+	uint32_t cycles, key;
+	int next = 0;
+	bool found;
+
+	(void)memset(cache, 0, sizeof(cache));
+	bt_mesh_hash_index_clear(&cache_index);
+
+	cycles = k_cycle_get_32();
+	for (int msg = 0; msg < CACHE_MSGS; msg++) {
+		key = msg_key(msg);
+
+		found = false;
+		for (int i = 0; i < CACHE_SIZE; i++) {
+			if (cache[i] == key) {
+				found = true;
+				break;
+			}
+		}
+
+		zassert_equal(found, msg % 2, "Message %d cache mismatch", msg);
+		if (!found) {
+			cache[next] = key;
+			next = (next + 1) % CACHE_SIZE;
+		}
+	}
+	cycles = k_cycle_get_32() - cycles;
+
+	TC_PRINT("Cache of %d messages: linear %llu ns per message\n",
+		 CACHE_SIZE, k_cyc_to_ns_ceil64(cycles) / CACHE_MSGS);
+
+	(void)memset(cache, 0, sizeof(cache));
+	next = 0;
+
+	cycles = k_cycle_get_32();
+	for (int msg = 0; msg < CACHE_MSGS; msg++) {
+		key = msg_key(msg);
+
+		found = bt_mesh_hash_index_find(&cache_index, key) >= 0;
+
+		zassert_equal(found, msg % 2, "Message %d cache mismatch", msg);
+		if (!found) {
+			bt_mesh_hash_index_del(&cache_index, cache[next], next);
+			cache[next] = key;
+			bt_mesh_hash_index_add(&cache_index, key, next);
+			next = (next + 1) % CACHE_SIZE;
+		}
+	}
+	cycles = k_cycle_get_32() - cycles;
+
+	TC_PRINT("Cache of %d messages: hashed %llu ns per message\n",
+		 CACHE_SIZE, k_cyc_to_ns_ceil64(cycles) / CACHE_MSGS);
+}
+
+/* Network PDU of a relayed packet, SEQ and SRC identify it */
+static struct bt_mesh_relay_pdu relay_pdu(uint16_t src, uint32_t seq,
+					  uint8_t ttl)
+{
+	struct bt_mesh_relay_pdu pdu = {
+		.net_idx = 0x0001,
+		.dst = 0xc000,
+		.len = BT_MESH_RELAY_PDU_MAX_LEN,
+	};
+
+	for (int i = 0; i < pdu.len; i++) {
+		pdu.data[i] = i;
+	}
+
+	pdu.data[1] = ttl;
+	sys_put_be24(seq, &pdu.data[2]);
+	sys_put_be16(src, &pdu.data[5]);
+
+	return pdu;
+}
+
+static void relay_queue_check(uint16_t src, uint32_t seq, uint8_t ttl)
+{
+	const struct bt_mesh_relay_pdu *pdu;
+	struct bt_mesh_relay_pdu expected = relay_pdu(src, seq, ttl);
+
+	pdu = bt_mesh_relay_queue_peek(&relay_queue);
+	zassert_not_null(pdu, "Queue empty, expected seq %u", seq);
+	zassert_equal(pdu->net_idx, expected.net_idx, NULL);
+	zassert_equal(pdu->dst, expected.dst, NULL);
+	zassert_equal(pdu->len, expected.len, NULL);
+	zassert_mem_equal(pdu->data, expected.data, expected.len,
+			  "Expected seq %u", seq);
+	bt_mesh_relay_queue_remove(&relay_queue, true);
+}
+
+static void relay_queue_add(uint16_t src, uint32_t seq, uint8_t ttl,
+			    int expected)
+{
+	struct bt_mesh_relay_pdu pdu = relay_pdu(src, seq, ttl);
+
+	zassert_equal(bt_mesh_relay_queue_add(&relay_queue, &pdu), expected,
+		      "Adding seq %u", seq);
+}
+
+static void relay_queue_reset(void)
+{
+	while (bt_mesh_relay_queue_peek(&relay_queue)) {
+		bt_mesh_relay_queue_remove(&relay_queue, false);
+	}
+
+	bt_mesh_relay_queue_stats_reset(&relay_queue);
+}
+
+/**
+ * @brief Check that the relay queue keeps the packets in order
+ *
+ * @details Packets come out in the order they were added, also when the
+ * queue wraps around.
+ */
+void test_relay_queue_order(void)
+{
+	struct bt_mesh_relay_stats stats;
+	uint32_t seq = 0;
+
+	relay_queue_reset();
+
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < RELAY_QUEUE_SIZE - 1; i++) {
+			relay_queue_add(node_addr(i), seq + i, 5, 0);
+		}
+
+		for (int i = 0; i < RELAY_QUEUE_SIZE - 1; i++) {
+			relay_queue_check(node_addr(i), seq + i, 5);
+		}
+
+		seq += RELAY_QUEUE_SIZE - 1;
+	}
+
+	zassert_is_null(bt_mesh_relay_queue_peek(&relay_queue), NULL);
+
+	bt_mesh_relay_queue_stats_get(&relay_queue, &stats);
+	zassert_equal(stats.queued, seq, NULL);
+	zassert_equal(stats.relayed, seq, NULL);
+	zassert_equal(stats.depth, 0, NULL);
+	zassert_equal(stats.max_depth, RELAY_QUEUE_SIZE - 1, NULL);
+	zassert_equal(stats.dropped_dup + stats.dropped_full, 0, NULL);
+}
+
+/**
+ * @brief Check that packets already in the relay queue are dropped
+ *
+ * @details A packet with the SRC and SEQ of a queued one is dropped, even
+ * with another TTL, and can be queued again once the first one is gone.
+ */
+void test_relay_queue_dup(void)
+{
+	struct bt_mesh_relay_stats stats;
+
+	relay_queue_reset();
+
+	relay_queue_add(0x0001, 100, 5, 0);
+	relay_queue_add(0x0001, 100, 4, -EALREADY);
+	/* Same SEQ from another source, or another SEQ of the source */
+	relay_queue_add(0x0002, 100, 5, 0);
+	relay_queue_add(0x0001, 101, 5, 0);
+	relay_queue_add(0x0002, 100, 3, -EALREADY);
+
+	relay_queue_check(0x0001, 100, 5);
+	relay_queue_add(0x0001, 100, 4, 0);
+
+	relay_queue_check(0x0002, 100, 5);
+	relay_queue_check(0x0001, 101, 5);
+	relay_queue_check(0x0001, 100, 4);
+
+	bt_mesh_relay_queue_stats_get(&relay_queue, &stats);
+	zassert_equal(stats.queued, 4, NULL);
+	zassert_equal(stats.dropped_dup, 2, NULL);
+	zassert_equal(stats.dropped_full, 0, NULL);
+}
+
+/**
+ * @brief Check that packets which don't fit in the relay queue are dropped
+ *
+ * @details The queued packets are kept, and only packets removed without
+ * being sent are not counted as relayed.
+ */
+void test_relay_queue_full(void)
+{
+	struct bt_mesh_relay_stats stats;
+
+	relay_queue_reset();
+
+	for (int i = 0; i < RELAY_QUEUE_SIZE; i++) {
+		relay_queue_add(0x0001, i, 5, 0);
+	}
+
+	relay_queue_add(0x0001, RELAY_QUEUE_SIZE, 5, -ENOMEM);
+	relay_queue_add(0x0002, 0, 5, -ENOMEM);
+
+	bt_mesh_relay_queue_stats_get(&relay_queue, &stats);
+	zassert_equal(stats.depth, RELAY_QUEUE_SIZE, NULL);
+	zassert_equal(stats.max_depth, RELAY_QUEUE_SIZE, NULL);
+	zassert_equal(stats.dropped_full, 2, NULL);
+
+	/* A packet of a deleted subnet is removed without being sent */
+	bt_mesh_relay_queue_remove(&relay_queue, false);
+	relay_queue_add(0x0001, RELAY_QUEUE_SIZE, 5, 0);
+
+	for (int i = 1; i <= RELAY_QUEUE_SIZE; i++) {
+		relay_queue_check(0x0001, i, 5);
+	}
+
+	bt_mesh_relay_queue_stats_get(&relay_queue, &stats);
+	zassert_equal(stats.queued, RELAY_QUEUE_SIZE + 1, NULL);
+	zassert_equal(stats.relayed, RELAY_QUEUE_SIZE, NULL);
+	zassert_equal(stats.depth, 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mesh_perf,
+			 ztest_unit_test(test_hash_index_del),
+			 ztest_unit_test(test_hash_index_large),
+			 ztest_unit_test(test_relay_queue_order),
+			 ztest_unit_test(test_relay_queue_dup),
+			 ztest_unit_test(test_relay_queue_full),
+			 ztest_unit_test(test_rpl_lookup_perf),
+			 ztest_unit_test(test_msg_cache_perf)
+			 );
+	ztest_run_test_suite(mesh_perf);
+}
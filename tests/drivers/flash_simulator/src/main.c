@@ -5,8 +5,10 @@
  */
 
 #include <ztest.h>
+#include <string.h>
 #include <drivers/flash.h>
 #include <device.h>
+#include <stats/stats.h>
 
 /* configuration derived from DT */
 #ifdef CONFIG_ARCH_POSIX
@@ -279,6 +281,138 @@ static void test_get_erase_value(void)
 		      FLASH_SIMULATOR_ERASE_VALUE);
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+#define ASYNC_PAGES 3
+
+static const char *stat_name;
+
+static int stat_find(struct stats_hdr *hdr, void *arg, const char *name,
+		     uint16_t off)
+{
+	uint32_t **val = arg;
+
+	if (!strcmp(name, stat_name)) {
+		*val = (uint32_t *)((uint8_t *)hdr + off);
+		return 1;
+	}
+
+	return 0;
+}
+
+static struct flash_async_req async_req[ASYNC_PAGES];
+static int async_done;
+static int async_result;
+
+static void async_cb(const struct device *dev, struct flash_async_req *req,
+		     int result)
+{
+	zassert_equal(dev, flash_dev, "Wrong device");
+	zassert_equal(req, &async_req[async_done], "Completed out of order");
+	async_done++;
+	async_result |= result;
+}
+
+static void async_wait(int count)
+{
+	for (int i = 0; (async_done < count) && (i < 1000); i++) {
+		k_msleep(1);
+	}
+	zassert_equal(async_done, count, "Requests not completed");
+	zassert_equal(async_result, 0, "Request failed");
+}
+
+static uint32_t sim_stat_get(const char *name)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	uint32_t *val = NULL;
+
+	stat_name = name;
+	zassert_not_null(hdr, "flash_sim_stats not found");
+	stats_walk(hdr, stat_find, &val);
+	zassert_not_null(val, "Stat not found");
+
+	return *val;
+}
+#endif
+
+/* Asynchronous requests complete in order, adjacent queued requests are
+ * merged.
+ */
+static void test_async(void)
+{
+#ifdef CONFIG_FLASH_ASYNC
+	static uint32_t data[ASYNC_PAGES * 4];
+	struct k_poll_signal signal;
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &signal);
+	const off_t page = FLASH_SIMULATOR_ERASE_UNIT;
+	uint32_t erases;
+	int rc;
+
+	async_done = 0;
+	async_result = 0;
+	erases = sim_stat_get("flash_erase_calls");
+
+	/* The first erase starts at once, the next ones are merged */
+	for (int i = 0; i < ASYNC_PAGES; i++) {
+		async_req[i].cb = async_cb;
+		rc = flash_erase_async(flash_dev,
+				       FLASH_SIMULATOR_BASE_OFFSET + i * page,
+				       page, &async_req[i]);
+		zassert_equal(rc, 0, "flash_erase_async failed: %d", rc);
+	}
+	zassert_equal(async_done, 0, "Erase completed synchronously");
+
+	async_wait(ASYNC_PAGES);
+	zassert_equal(sim_stat_get("flash_erase_calls") - erases, 2,
+		      "Erases not merged");
+
+	/* Writes of adjacent parts of a buffer, completed by signals */
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		data[i] = i;
+	}
+
+	k_poll_signal_init(&signal);
+	for (int i = 0; i < 2; i++) {
+		async_req[i].cb = NULL;
+		async_req[i].signal = (i == 1) ? &signal : NULL;
+		rc = flash_write_async(flash_dev,
+				       FLASH_SIMULATOR_BASE_OFFSET +
+				       i * sizeof(data) / 2,
+				       (uint8_t *)data + i * sizeof(data) / 2,
+				       sizeof(data) / 2, &async_req[i]);
+		zassert_equal(rc, 0, "flash_write_async failed: %d", rc);
+	}
+
+	rc = k_poll(&event, 1, K_SECONDS(1));
+	zassert_equal(rc, 0, "Write not completed");
+	zassert_equal(signal.result, 0, "Write failed");
+
+	pattern32_ini(0);
+	test_check_pattern32(FLASH_SIMULATOR_BASE_OFFSET, pattern32_inc,
+			     sizeof(data));
+
+	/* Read back */
+	memset(test_read_buf, 0, sizeof(data));
+	k_poll_signal_init(&signal);
+	event.state = K_POLL_STATE_NOT_READY;
+	async_req[0].signal = &signal;
+	rc = flash_read_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			      test_read_buf, sizeof(data), &async_req[0]);
+	zassert_equal(rc, 0, "flash_read_async failed: %d", rc);
+
+	rc = k_poll(&event, 1, K_SECONDS(1));
+	zassert_equal(rc, 0, "Read not completed");
+	zassert_mem_equal(test_read_buf, data, sizeof(data), "Wrong data");
+
+	rc = flash_erase_async(flash_dev, TEST_SIM_FLASH_END, page,
+			       &async_req[0]);
+	zassert_equal(rc, -EINVAL, "Unexpected error code (%d)", rc);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -289,6 +423,7 @@ void test_main(void)
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
+			 ztest_unit_test(test_async),
 			 ztest_unit_test(test_double_write));
 
 	ztest_run_test_suite(flash_sim_api);
@@ -594,6 +594,72 @@ void test_memmove(void)
 		     "memmove failed");
 }
 
+/**
+ * @brief Test copies and scans at every alignment
+ *
+ * @details Source and destination offsets cover every combination within
+ * two words, so that word at a time implementations handle equally and
+ * differently aligned buffers, and overlapping moves in both directions.
+ *
+ * @see memcpy(), memmove(), memcmp(), memchr(), strlen(), strchr(),
+ * strcmp().
+ */
+void test_mem_align(void)
+{
+	static char src[64], dst[64], exp[64];
+	const size_t off_max = 2 * sizeof(uintptr_t);
+	const size_t len = sizeof(src) - off_max - 1;
+
+	/* Distinct non-zero characters */
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = '0' + i;
+	}
+
+	for (size_t s_off = 0; s_off < off_max; s_off++) {
+		for (size_t d_off = 0; d_off < off_max; d_off++) {
+			memset(dst, 0, sizeof(dst));
+			memset(exp, 0, sizeof(exp));
+			for (size_t i = 0; i < len; i++) {
+				exp[d_off + i] = src[s_off + i];
+			}
+
+			zassert_equal(memcpy(dst + d_off, src + s_off, len),
+				      dst + d_off, "memcpy error");
+			zassert_equal(memcmp(dst, exp, sizeof(dst)), 0,
+				      "memcpy %zu to %zu failed", s_off, d_off);
+			zassert_true(memcmp(dst + d_off, src + s_off,
+					    len + 1) < 0,
+				     "memcmp %zu to %zu failed", s_off, d_off);
+
+			/* The copy is a string of <len> characters */
+			zassert_equal(strlen(dst + d_off), len,
+				      "strlen at %zu failed", d_off);
+			zassert_true(strcmp(dst + d_off, src + s_off) < 0,
+				     "strcmp %zu to %zu failed", s_off, d_off);
+			zassert_equal(strchr(dst + d_off, src[s_off + len - 1]),
+				      dst + d_off + len - 1,
+				      "strchr at %zu failed", d_off);
+			zassert_equal(memchr(dst + d_off, src[s_off + len - 1],
+					     len),
+				      dst + d_off + len - 1,
+				      "memchr at %zu failed", d_off);
+
+			/* Overlapping move within the source pattern */
+			memcpy(dst, src, sizeof(dst));
+			memcpy(exp, src, sizeof(exp));
+			for (size_t i = 0; i < len; i++) {
+				exp[d_off + i] = src[s_off + i];
+			}
+
+			zassert_equal(memmove(dst + d_off, dst + s_off, len),
+				      dst + d_off, "memmove error");
+			zassert_equal(memcmp(dst, exp, sizeof(dst)), 0,
+				      "memmove %zu to %zu failed", s_off,
+				      d_off);
+		}
+	}
+}
+
 /**
  *
  * @brief test str operate functions
@@ -965,6 +1031,7 @@ void test_main(void)
 			 ztest_unit_test(test_memchr),
 			 ztest_unit_test(test_memcpy),
 			 ztest_unit_test(test_memmove),
+			 ztest_unit_test(test_mem_align),
 			 ztest_unit_test(test_time),
 			 ztest_unit_test(test_abort),
 			 ztest_unit_test(test_exit),
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/ring_buffer_lf.h>
+
+#define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define RECORD_LEN	4
+#define RECORDS		1000
+
+RING_BUF_LF_DECLARE_POW2(ringbuf_lf, 6);
+RING_BUF_LF_DECLARE_POW2(ringbuf_lf_mp, 6);
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACKSIZE);
+static struct k_thread producer_data;
+
+static uint8_t input[100];
+static uint8_t output[100];
+
+/**
+ * @brief Test single producer put and get with wrapping
+ *
+ * @details Data is written and read in chunks which are not a divisor of
+ * the buffer size, so the indexes wrap around in all positions.
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+void test_ringbuffer_lf_put_get(void)
+{
+	uint32_t len;
+
+	for (int i = 0; i < sizeof(input); i++) {
+		input[i] = i;
+	}
+
+	zassert_true(ring_buf_lf_is_empty(&ringbuf_lf), NULL);
+	zassert_equal(ring_buf_lf_capacity_get(&ringbuf_lf), 64, NULL);
+
+	for (int i = 0; i < 100; i++) {
+		len = ring_buf_lf_put(&ringbuf_lf, input, 37);
+		zassert_equal(len, 37, NULL);
+
+		/* Only the remaining space is written */
+		len = ring_buf_lf_put(&ringbuf_lf, input, 37);
+		zassert_equal(len, 64 - 37, NULL);
+		zassert_equal(ring_buf_lf_space_get(&ringbuf_lf), 0, NULL);
+
+		len = ring_buf_lf_get(&ringbuf_lf, output, sizeof(output));
+		zassert_equal(len, 64, NULL);
+		zassert_mem_equal(output, input, 37, NULL);
+		zassert_mem_equal(&output[37], input, 64 - 37, NULL);
+
+		/* Move indexes to a different offset for the next round */
+		len = ring_buf_lf_put(&ringbuf_lf, input, i % 13);
+		zassert_equal(ring_buf_lf_get(&ringbuf_lf, NULL, len), len,
+			      NULL);
+	}
+
+	zassert_true(ring_buf_lf_is_empty(&ringbuf_lf), NULL);
+}
+
+/**
+ * @brief Test single producer claim and finish
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+void test_ringbuffer_lf_claim_finish(void)
+{
+	uint8_t *data;
+	uint32_t len;
+	int err;
+
+	len = ring_buf_lf_put_claim(&ringbuf_lf, &data, 16);
+	zassert_equal(len, 16, NULL);
+	memcpy(data, input, len);
+
+	/* Nothing is visible before finish */
+	zassert_true(ring_buf_lf_is_empty(&ringbuf_lf), NULL);
+
+	err = ring_buf_lf_put_finish(&ringbuf_lf, len + 1);
+	zassert_equal(err, -EINVAL, NULL);
+
+	err = ring_buf_lf_put_finish(&ringbuf_lf, 10);
+	zassert_equal(err, 0, NULL);
+
+	len = ring_buf_lf_get_claim(&ringbuf_lf, &data, 16);
+	zassert_equal(len, 10, NULL);
+	zassert_mem_equal(data, input, len, NULL);
+
+	err = ring_buf_lf_get_finish(&ringbuf_lf, len + 1);
+	zassert_equal(err, -EINVAL, NULL);
+
+	/* Partially consumed data stays in the buffer */
+	err = ring_buf_lf_get_finish(&ringbuf_lf, 4);
+	zassert_equal(err, 0, NULL);
+
+	len = ring_buf_lf_get(&ringbuf_lf, output, sizeof(output));
+	zassert_equal(len, 6, NULL);
+	zassert_mem_equal(output, &input[4], len, NULL);
+}
+
+static bool record_put(uint8_t id, uint16_t seq)
+{
+	uint8_t rec[RECORD_LEN] = { id, seq & 0xFF, seq >> 8, id ^ seq };
+
+	return ring_buf_lf_mp_put(&ringbuf_lf_mp, rec, sizeof(rec)) != 0;
+}
+
+static void isr_producer(const void *param)
+{
+	static uint16_t seq;
+
+	/* Free space is always a multiple of the record length, so records
+	 * are either written whole or not at all.
+	 */
+	if (record_put(1, seq)) {
+		seq++;
+	}
+}
+
+static void thread_producer(void *p1, void *p2, void *p3)
+{
+	for (uint16_t seq = 0; seq < RECORDS; seq++) {
+		while (!record_put(0, seq)) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test multiple producers writing to the same buffer
+ *
+ * @details A thread producer is preempted by an interrupt producer while the
+ * consumer checks that records are never torn and that the records of each
+ * producer are received in order.
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+void test_ringbuffer_lf_mp_put(void)
+{
+	uint16_t next[2] = { 0 };
+	uint8_t rec[RECORD_LEN];
+	int received = 0;
+
+	k_thread_create(&producer_data, producer_stack, STACKSIZE,
+			thread_producer, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	while (received < 2 * RECORDS) {
+		if (next[1] < RECORDS) {
+			irq_offload(isr_producer, NULL);
+		}
+
+		if (ring_buf_lf_get(&ringbuf_lf_mp, rec, sizeof(rec)) == 0) {
+			k_msleep(1);
+			continue;
+		}
+
+		uint16_t seq = rec[1] | (rec[2] << 8);
+
+		zassert_true(rec[0] < 2, "Invalid producer %d", rec[0]);
+		zassert_equal((uint8_t)(rec[0] ^ seq), rec[3], "Torn record");
+		zassert_equal(seq, next[rec[0]], "Record out of order");
+		next[rec[0]]++;
+		received++;
+	}
+
+	k_thread_join(&producer_data, K_FOREVER);
+	zassert_true(ring_buf_lf_is_empty(&ringbuf_lf_mp), NULL);
+}
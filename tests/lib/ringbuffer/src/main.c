@@ -50,6 +50,9 @@ RING_BUF_ITEM_DECLARE_POW2(ring_buf1, 8);
 #define DATA_MAX_SIZE 3
 #define POW 2
 extern void test_ringbuffer_concurrent(void);
+extern void test_ringbuffer_lf_put_get(void);
+extern void test_ringbuffer_lf_claim_finish(void);
+extern void test_ringbuffer_lf_mp_put(void);
 /**
  * @brief Test APIs of ring buffer
  *
@@ -971,7 +974,10 @@ void test_main(void)
 		       ztest_unit_test(test_capacity),
 		       ztest_unit_test(test_reset),
 		       ztest_unit_test(test_ringbuffer_performance),
-		       ztest_unit_test(test_ringbuffer_concurrent)
+		       ztest_unit_test(test_ringbuffer_concurrent),
+		       ztest_unit_test(test_ringbuffer_lf_put_get),
+		       ztest_unit_test(test_ringbuffer_lf_claim_finish),
+		       ztest_unit_test(test_ringbuffer_lf_mp_put)
 		);
 	ztest_run_test_suite(test_ringbuffer_api);
 }
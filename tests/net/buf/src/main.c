@@ -457,6 +457,92 @@ static void test_net_buf_var_pool(void)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void test_net_buf_cpu_cache(void)
+{
+	struct net_buf *bufs[10];
+	int i;
+
+	if (!IS_ENABLED(CONFIG_NET_BUF_CPU_CACHE)) {
+		ztest_test_skip();
+		return;
+	}
+
+	destroy_called = 0;
+
+	/* Buffers held in the caches must not be lost for the allocations */
+	for (int round = 0; round < 2; round++) {
+		for (i = 0; i < ARRAY_SIZE(bufs); i++) {
+			bufs[i] = net_buf_alloc(&fixed_pool, K_NO_WAIT);
+			zassert_not_null(bufs[i], "Failed to get buffer %d", i);
+		}
+
+		zassert_is_null(net_buf_alloc(&fixed_pool, K_NO_WAIT),
+				"Got more buffers than the pool has");
+
+		for (i = 0; i < ARRAY_SIZE(bufs); i++) {
+			net_buf_unref(bufs[i]);
+		}
+	}
+
+	zassert_equal(destroy_called, 2 * ARRAY_SIZE(bufs),
+		      "Incorrect destroy callback count");
+
+	/* A freed buffer is allocated again from the cache */
+	bufs[0] = net_buf_alloc(&fixed_pool, K_NO_WAIT);
+	zassert_not_null(bufs[0], "Failed to get buffer");
+	net_buf_unref(bufs[0]);
+
+	bufs[1] = net_buf_alloc(&fixed_pool, K_NO_WAIT);
+	zassert_equal_ptr(bufs[0], bufs[1], "Freed buffer not reused");
+	net_buf_unref(bufs[1]);
+}
+
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+static void trace_count(struct net_buf *buf, void *user_data)
+{
+	int *count = user_data;
+
+	zassert_equal_ptr(buf->trace.owner, k_current_get(),
+			  "Wrong buffer owner");
+	zassert_not_null(buf->trace.site, "No allocation site");
+	zassert_true(k_uptime_get_32() - buf->trace.time < 1000,
+		     "Wrong allocation time");
+
+	(*count)++;
+}
+#endif
+
+static void test_net_buf_alloc_trace(void)
+{
+#if defined(CONFIG_NET_BUF_ALLOC_TRACE)
+	struct net_buf *buf1, *buf2;
+	int count = 0;
+
+	buf1 = net_buf_alloc_len(&var_pool, 20, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer");
+
+	buf2 = net_buf_alloc_len(&var_pool, 20, K_NO_WAIT);
+	zassert_not_null(buf2, "Failed to get buffer");
+
+	net_buf_pool_trace_foreach(&var_pool, trace_count, &count);
+	zassert_equal(count, 2, "Wrong number of allocated buffers");
+
+	net_buf_unref(buf1);
+
+	count = 0;
+	net_buf_pool_trace_foreach(&var_pool, trace_count, &count);
+	zassert_equal(count, 1, "Wrong number of allocated buffers");
+
+	net_buf_unref(buf2);
+
+	count = 0;
+	net_buf_pool_trace_foreach(&var_pool, trace_count, &count);
+	zassert_equal(count, 0, "Freed buffers reported");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void test_net_buf_byte_order(void)
 {
 	struct net_buf *buf;
@@ -692,6 +778,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_buf_clone),
 			 ztest_unit_test(test_net_buf_fixed_pool),
 			 ztest_unit_test(test_net_buf_var_pool),
+			 ztest_unit_test(test_net_buf_cpu_cache),
+			 ztest_unit_test(test_net_buf_alloc_trace),
 			 ztest_unit_test(test_net_buf_byte_order)
 			 );
 
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <net/socket.h>
 #include <net/ethernet.h>
+#include <net/net_stats.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -911,6 +912,56 @@ void test_so_protocol(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_so_net_stats(void)
+{
+	struct sockaddr_in bind_addr, conn_addr;
+	struct net_stats_context stats;
+	socklen_t optlen = sizeof(stats);
+	int sock1, sock2, len, rv;
+	char buf[10];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55555,
+			    &sock1, &bind_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, 55555,
+			    &sock2, &conn_addr);
+
+	rv = bind(sock1, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = connect(sock2, (struct sockaddr *)&conn_addr, sizeof(conn_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	len = send(sock2, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	len = recv(sock1, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "Invalid recv len");
+
+	rv = getsockopt(sock2, SOL_SOCKET, SO_NET_STATS, &stats, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(stats.bytes.sent, STRLEN(TEST_STR_SMALL),
+		      "Invalid sent bytes");
+
+	rv = getsockopt(sock1, SOL_SOCKET, SO_NET_STATS, &stats, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(stats.pkts.rx, 1, "Invalid received packets");
+	zassert_equal(stats.bytes.received, STRLEN(TEST_STR_SMALL),
+		      "Invalid received bytes");
+	zassert_equal(stats.rx_queue_time.count, 1,
+		      "Invalid RX queue time count");
+	zassert_equal(stats.drop, 0, "Invalid drop count");
+
+	optlen = sizeof(stats) - 1;
+	rv = getsockopt(sock1, SOL_SOCKET, SO_NET_STATS, &stats, &optlen);
+	zassert_equal(rv, -1, "getsockopt succeeded with invalid size");
+	zassert_equal(errno, EINVAL, "Invalid errno (%d)", errno);
+
+	rv = close(sock1);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock2);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void comm_sendmsg_with_txtime(int client_sock,
 				     struct sockaddr *client_addr,
 				     socklen_t client_addrlen,
@@ -1228,6 +1279,7 @@ void test_main(void)
 			 ztest_unit_test(test_so_rcvtimeo),
 			 ztest_unit_test(test_so_sndtimeo),
 			 ztest_unit_test(test_so_protocol),
+			 ztest_unit_test(test_so_net_stats),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom),
 			 ztest_user_unit_test(test_v4_sendmsg_recvfrom),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom_no_aux_data),
@@ -89,6 +89,7 @@ void test_main(void)
 			 ztest_unit_test(test_file_sync),
 			 ztest_unit_test(test_file_rename),
 			 ztest_unit_test(test_file_stat),
+			 ztest_unit_test(test_file_stat_cache),
 			 ztest_unit_test(test_file_unlink),
 			 ztest_unit_test(test_unmount),
 			 ztest_unit_test_setup_teardown(test_mount_flags,
@@ -23,6 +23,23 @@ static int file_length;
 static struct fs_mount_t *mp[FS_TYPE_EXTERNAL_BASE];
 static bool nospace;
 static int opendir_result;
+/* Path removed by the last rename or unlink, it is not found by fs_stat()
+ * and neither are the paths below it.
+ */
+static char removed_path[64];
+
+static void temp_remove(const char *path)
+{
+	strncpy(removed_path, path, sizeof(removed_path) - 1);
+}
+
+static bool temp_removed(const char *path)
+{
+	size_t len = strlen(removed_path);
+
+	return len > 0 && strncmp(path, removed_path, len) == 0 &&
+	       (path[len] == '\0' || path[len] == '/');
+}
 
 static
 int temp_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
@@ -42,6 +59,10 @@ int temp_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 		return -EINVAL;
 	}
 
+	if ((flags & FS_O_CREATE) && temp_removed(file_name)) {
+		removed_path[0] = '\0';
+	}
+
 	zfp->filep = (char *)file_name;
 	return 0;
 }
@@ -70,6 +91,8 @@ static int temp_unlink(struct fs_mount_t *mountp, const char *path)
 	if (strcmp(mountp->mnt_point, path) == 0) {
 		return -EPERM;
 	}
+
+	temp_remove(path);
 	return 0;
 }
 
@@ -83,6 +106,8 @@ static int temp_rename(struct fs_mount_t *mountp, const char *from,
 	if (strcmp(to, TEST_FILE_EX) == 0) {
 		return -EINVAL;
 	}
+
+	temp_remove(from);
 	return 0;
 }
 
@@ -288,6 +313,10 @@ static int temp_stat(struct fs_mount_t *mountp,
 		return -EINVAL;
 	}
 
+	if (temp_removed(path)) {
+		return -ENOENT;
+	}
+
 	return 0;
 }
 
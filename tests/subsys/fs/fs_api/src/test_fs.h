@@ -53,6 +53,7 @@ void test_file_close(void);
 void test_file_sync(void);
 void test_file_rename(void);
 void test_file_stat(void);
+void test_file_stat_cache(void);
 void test_file_unlink(void);
 void test_unmount(void);
 void test_mount_flags(void);
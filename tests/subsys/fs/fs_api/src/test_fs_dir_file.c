@@ -987,6 +987,73 @@ void test_file_stat(void)
 	zassert_equal(ret, 0, "Fail to stat a file");
 }
 
+/**
+ * @brief Test the stat cache of the file system core
+ *
+ * @details Repeated fs_stat() calls are served by the cache until the
+ * path is modified, including the calls which do not find the path.
+ *
+ * @ingroup filesystem_api
+ */
+#ifdef CONFIG_FS_STAT_CACHE
+void test_file_stat_cache(void)
+{
+	struct fs_cache_stats before, after;
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	int ret;
+
+	/* Creating the file drops a cached entry for it */
+	fs_file_t_init(&file);
+	ret = fs_open(&file, TEST_DIR_FILE, FS_O_CREATE | FS_O_RDWR);
+	zassert_equal(ret, 0, "Fail to create a file");
+	ret = fs_close(&file);
+	zassert_equal(ret, 0, "Fail to close a file");
+
+	ret = fs_cache_stats_get(&before);
+	zassert_equal(ret, 0, "Fail to get cache statistics");
+
+	ret = fs_stat(TEST_DIR_FILE, &entry);
+	zassert_equal(ret, 0, "Fail to stat a file");
+	ret = fs_stat(TEST_DIR_FILE, &entry);
+	zassert_equal(ret, 0, "Fail to stat a file");
+
+	fs_cache_stats_get(&after);
+	zassert_equal(after.stat_misses - before.stat_misses, 1,
+		      "First stat should miss the cache");
+	zassert_equal(after.stat_hits - before.stat_hits, 1,
+		      "Second stat should hit the cache");
+
+	/* Modifications of the parent directory invalidate the entry */
+	ret = fs_rename(TEST_DIR, TEST_FS_MNTP"/testdir2");
+	zassert_equal(ret, 0, "Fail to rename a dir");
+
+	ret = fs_stat(TEST_DIR_FILE, &entry);
+	zassert_equal(ret, -ENOENT, "Stat a file of a renamed dir");
+	ret = fs_stat(TEST_DIR_FILE, &entry);
+	zassert_equal(ret, -ENOENT, "Stat a file of a renamed dir");
+
+	fs_cache_stats_get(&before);
+	zassert_equal(before.stat_misses - after.stat_misses, 1,
+		      "Stat after a modification should miss the cache");
+	zassert_equal(before.stat_hits - after.stat_hits, 1,
+		      "Missing file should be cached");
+	zassert_true(before.stat_invalidations > after.stat_invalidations,
+		     "Entry should have been invalidated");
+
+	ret = fs_stat(TEST_FS_MNTP"/testdir2/testfile.txt", &entry);
+	zassert_equal(ret, 0, "Fail to stat a renamed file");
+
+	ret = fs_rename(TEST_FS_MNTP"/testdir2", TEST_DIR);
+	zassert_equal(ret, 0, "Fail to rename a dir");
+}
+#else
+void test_file_stat_cache(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /**
  * @brief Test fs_unlink() interface in filesystem core
  *
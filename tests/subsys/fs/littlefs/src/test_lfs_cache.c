@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Read-ahead of the file system core on littlefs:
+ * * sequential reads
+ * * tell while data is read ahead
+ * * seek
+ * * write
+ */
+
+#include <string.h>
+#include <ztest.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+
+#ifdef CONFIG_FS_READ_AHEAD
+#define RA_FILE "read_ahead"
+#define RA_FILE_SIZE 512
+#define RA_CHUNK 16
+#define RA_WRITE_VALUE 0xaa
+
+/* Read a chunk and check that it continues the incrementing data written
+ * to the file, and the position after it.
+ */
+static void read_chunk(struct fs_file_t *file, off_t pos)
+{
+	uint8_t buf[RA_CHUNK];
+
+	zassert_equal(fs_read(file, buf, sizeof(buf)), sizeof(buf),
+		      "read at %d failed", (int)pos);
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		zassert_equal(buf[i], (uint8_t)(pos + i),
+			      "unexpected data at %d", (int)(pos + i));
+	}
+
+	zassert_equal(fs_tell(file), pos + sizeof(buf),
+		      "unexpected position after read at %d", (int)pos);
+}
+
+void test_lfs_read_ahead(void)
+{
+	struct fs_mount_t *mp = &testfs_small_mnt;
+	struct fs_cache_stats before, after;
+	struct testfs_path path;
+	struct fs_file_t file;
+	uint8_t buf[RA_CHUNK];
+	off_t pos;
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_equal(fs_mount(mp), 0,
+		      "mount failed");
+
+	fs_file_t_init(&file);
+	zassert_equal(fs_open(&file,
+			      testfs_path_init(&path, mp,
+					       RA_FILE,
+					       TESTFS_PATH_END),
+			      FS_O_CREATE | FS_O_RDWR),
+		      0,
+		      "open failed");
+	zassert_equal(testfs_write_incrementing(&file, 0, RA_FILE_SIZE),
+		      RA_FILE_SIZE,
+		      "write failed");
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_SET), 0,
+		      "seek to start failed");
+
+	/* The 2nd read fills a window of 4 chunks, the 6th one the next
+	 * window of 8 chunks, the other reads are served from the buffer
+	 * while fs_tell() reports the position of the data returned.
+	 */
+	zassert_equal(fs_cache_stats_get(&before), 0,
+		      "cache stats failed");
+
+	for (pos = 0; pos < 8 * RA_CHUNK; pos += RA_CHUNK) {
+		read_chunk(&file, pos);
+	}
+
+	fs_cache_stats_get(&after);
+	zassert_equal(after.ra_fills - before.ra_fills, 2,
+		      "unexpected number of read ahead");
+	zassert_equal(after.ra_hits - before.ra_hits, 5,
+		      "unexpected number of reads from the buffer");
+
+	/* A seek drops the data read ahead */
+	pos = 3 * RA_CHUNK + 5;
+	zassert_equal(fs_seek(&file, pos, FS_SEEK_SET), 0,
+		      "seek failed");
+	zassert_equal(fs_tell(&file), pos,
+		      "unexpected position after seek");
+
+	before = after;
+	for (int i = 0; i < 3; i++) {
+		read_chunk(&file, pos);
+		pos += RA_CHUNK;
+	}
+
+	fs_cache_stats_get(&after);
+	zassert_equal(after.ra_fills - before.ra_fills, 1,
+		      "read ahead not restarted after seek");
+	zassert_equal(after.ra_hits - before.ra_hits, 1,
+		      "unexpected number of reads from the buffer");
+
+	/* A write goes to the position of the data returned, not to the
+	 * one of the data read ahead.
+	 */
+	memset(buf, RA_WRITE_VALUE, sizeof(buf));
+	zassert_equal(fs_write(&file, buf, sizeof(buf)), sizeof(buf),
+		      "write failed");
+	zassert_equal(fs_tell(&file), pos + RA_CHUNK,
+		      "unexpected position after write");
+
+	read_chunk(&file, pos + RA_CHUNK);
+
+	zassert_equal(fs_seek(&file, pos, FS_SEEK_SET), 0,
+		      "seek to written data failed");
+	memset(buf, 0, sizeof(buf));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), sizeof(buf),
+		      "read of written data failed");
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		zassert_equal(buf[i], RA_WRITE_VALUE,
+			      "written data not read back");
+	}
+
+	zassert_equal(fs_close(&file), 0,
+		      "close failed");
+	zassert_equal(fs_unmount(mp), 0,
+		      "unmount failed");
+}
+#else
+void test_lfs_read_ahead(void)
+{
+	ztest_test_skip();
+}
+#endif
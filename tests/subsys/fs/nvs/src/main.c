@@ -706,6 +706,232 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+/*
+ * Test that with the lookup cache a read only needs to access the ate of the
+ * id and its data, regardless of the number of entries written after it.
+ */
+void test_nvs_cache_read(void)
+{
+	int err;
+	ssize_t len;
+	uint32_t *flash_read_stat = NULL;
+	uint32_t reads;
+	uint16_t data;
+
+	if (!IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE)) {
+		ztest_test_skip();
+	}
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (uint16_t id = 1; id < 20; id++) {
+		len = nvs_write(&fs, id, &id, sizeof(id));
+		zassert_true(len == sizeof(id), "nvs_write failed: %d", len);
+	}
+
+	/* The cache is rebuilt from flash */
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	stats_walk(sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+	zassert_not_null(flash_read_stat, "flash_read_calls stat not found");
+
+	reads = *flash_read_stat;
+	len = nvs_read(&fs, 1, &data, sizeof(data));
+	zassert_true(len == sizeof(data), "nvs_read unexpected failure: %d",
+		     len);
+	zassert_equal(data, 1, "unexpected value %d", data);
+	zassert_equal(*flash_read_stat - reads, 2,
+		      "Unexpected number of flash reads");
+
+	/* An id that was never written is found without reading flash */
+	reads = *flash_read_stat;
+	len = nvs_read(&fs, 0, &data, sizeof(data));
+	zassert_true(len == -ENOENT, "nvs_read unexpected result: %d", len);
+	zassert_equal(*flash_read_stat - reads, 0,
+		      "Unexpected number of flash reads");
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+#define TEST_CACHE_COLLISION_ID CONFIG_NVS_LOOKUP_CACHE_SIZE
+#else
+#define TEST_CACHE_COLLISION_ID 1
+#endif
+
+/*
+ * Test ids sharing the same lookup cache position, the older one is then
+ * found by walking back from the most recent one.
+ */
+void test_nvs_cache_collision(void)
+{
+	const uint16_t ids[] = { 0, TEST_CACHE_COLLISION_ID };
+	int err;
+	ssize_t len;
+	uint16_t data;
+
+	if (!IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE)) {
+		ztest_test_skip();
+	}
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		len = nvs_write(&fs, ids[i], &ids[i], sizeof(ids[i]));
+		zassert_true(len == sizeof(ids[i]), "nvs_write failed: %d",
+			     len);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		len = nvs_read(&fs, ids[i], &data, sizeof(data));
+		zassert_true(len == sizeof(data),
+			     "nvs_read unexpected failure: %d", len);
+		zassert_equal(data, ids[i], "unexpected value %d", data);
+	}
+
+	err = nvs_delete(&fs, ids[1]);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	len = nvs_read(&fs, ids[1], &data, sizeof(data));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+
+	len = nvs_read(&fs, ids[0], &data, sizeof(data));
+	zassert_true(len == sizeof(data), "nvs_read unexpected failure: %d",
+		     len);
+	zassert_equal(data, ids[0], "unexpected value %d", data);
+}
+
+/*
+ * Test the garbage collection statistics. With background garbage collection
+ * the sectors are reclaimed while the writer sleeps, so that the writes never
+ * do garbage collection themselves.
+ */
+void test_nvs_gc_stats(void)
+{
+	struct nvs_gc_stats stats;
+	const uint16_t max_id = 10;
+	/* 50th write triggers the 1st GC, see test_nvs_gc_3sectors */
+	const uint16_t max_writes = IS_ENABLED(CONFIG_NVS_BACKGROUND_GC) ?
+				    150 : 51;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_NVS_GC_STATS)) {
+		ztest_test_skip();
+	}
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (uint16_t i = 0; i < max_writes; i++) {
+		write_content(max_id, i, i + 1, &fs);
+		if (IS_ENABLED(CONFIG_NVS_BACKGROUND_GC)) {
+			k_msleep(1);
+		}
+	}
+
+	err = nvs_gc_stats_get(&fs, &stats);
+	zassert_true(err == 0,  "nvs_gc_stats_get call failure: %d", err);
+
+	if (IS_ENABLED(CONFIG_NVS_BACKGROUND_GC)) {
+		zassert_equal(stats.fg_count, 0, "Unexpected write gc");
+		zassert_true(stats.bg_count > 0, "No background gc");
+		zassert_true(stats.bg_max_us <= stats.bg_total_us,
+			     "Inconsistent gc duration");
+	} else {
+		zassert_equal(stats.fg_count, 1, "Unexpected gc count");
+		zassert_equal(stats.bg_count, 0, "Unexpected background gc");
+		zassert_equal(stats.fg_max_us, stats.fg_total_us,
+			      "Inconsistent gc duration");
+	}
+
+	check_content(max_id, &fs);
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	check_content(max_id, &fs);
+
+	/* The statistics are reset by nvs_init() */
+	err = nvs_gc_stats_get(&fs, &stats);
+	zassert_true(err == 0,  "nvs_gc_stats_get call failure: %d", err);
+	zassert_equal(stats.fg_count + stats.bg_count, 0,
+		      "Statistics not reset");
+}
+
+/*
+ * Test that the background garbage collection is done in steps which
+ * interleave with writes, and that nvs_init() resumes a garbage collection
+ * interrupted between two steps without losing these writes.
+ */
+void test_nvs_bg_gc_steps(void)
+{
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	const uint16_t max_id = 10;
+	const uint16_t max_writes = 100;
+	int prio = k_thread_priority_get(k_current_get());
+	uint16_t i;
+	int err;
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	/* At the priority of the garbage collection work queue every yield
+	 * lets it do a single step.
+	 */
+	k_thread_priority_set(k_current_get(),
+			      CONFIG_NVS_BACKGROUND_GC_PRIORITY);
+
+	for (i = 0; (i < max_writes) && !fs.gc_active; i++) {
+		write_content(max_id, i, i + 1, &fs);
+		k_yield();
+	}
+	zassert_true(fs.gc_active, "No background gc in progress");
+
+	/* Writes between the steps */
+	write_content(max_id, i, i + 2, &fs);
+	i += 2;
+	k_yield();
+	write_content(max_id, i, i + 2, &fs);
+	i += 2;
+	zassert_true(fs.gc_active, "Background gc not done in steps");
+
+	k_thread_priority_set(k_current_get(), prio);
+
+	check_content(max_id, &fs);
+
+	/* The garbage collection is cancelled by nvs_init() */
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	check_content(max_id, &fs);
+
+	/* and the file system keeps working */
+	write_content(max_id, i, i + max_writes, &fs);
+	check_content(max_id, &fs);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -729,7 +955,15 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache_read, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache_collision, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_stats, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_bg_gc_steps, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
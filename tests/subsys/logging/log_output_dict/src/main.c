@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test dictionary-based binary output of a non-UART backend
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <sys/crc.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output.h>
+#include <logging/log_output_dict.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_DBG);
+
+#define TEST_TIMESTAMP 0x1234
+#define TEST_DROPPED 7
+
+static uint8_t log_output_buf[256];
+static uint8_t mock_buffer[512];
+static uint32_t mock_len;
+/* Calls of the output function, i.e. packets a network backend would send */
+static uint32_t mock_chunks;
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	zassert_true(mock_len + size <= sizeof(mock_buffer), "Output overflow");
+
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+	mock_chunks++;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+/* Backend built on the log output module, like the network or RTT ones */
+static void process(struct log_backend const *const backend,
+		    union log_msg2_generic *msg)
+{
+	log_output_msg2_process(&log_output, &msg->log, 0);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+}
+
+static void dropped(struct log_backend const *const backend, uint32_t cnt)
+{
+	log_output_dropped_process(&log_output, cnt);
+}
+
+static const struct log_backend_api log_backend_test_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+static log_timestamp_t timestamp_get(void)
+{
+	return TEST_TIMESTAMP;
+}
+
+static void reset(void)
+{
+	while (log_process(false)) {
+	}
+
+	mock_len = 0;
+	mock_chunks = 0;
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+}
+
+/*
+ * Check the frame around a record when framing is enabled and return the
+ * offset of the record in the captured output.
+ */
+static size_t frame_check(size_t record_len)
+{
+	struct log_dict_output_frame_hdr_t frame;
+	uint16_t crc;
+
+	if (!IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+		zassert_equal(mock_len, record_len, "Unexpected output length");
+		return 0;
+	}
+
+	zassert_equal(mock_len, sizeof(frame) + record_len + sizeof(crc),
+		      "Unexpected frame length");
+
+	memcpy(&frame, mock_buffer, sizeof(frame));
+	zassert_equal(frame.sync[0], LOG_DICT_OUTPUT_FRAME_SYNC0, "Bad sync");
+	zassert_equal(frame.sync[1], LOG_DICT_OUTPUT_FRAME_SYNC1, "Bad sync");
+	zassert_equal(frame.len, record_len, "Bad record length");
+
+	memcpy(&crc, &mock_buffer[sizeof(frame) + record_len], sizeof(crc));
+	zassert_equal(crc, crc16_ccitt(0xFFFF, &mock_buffer[sizeof(frame)],
+				       record_len), "Bad CRC");
+
+	return sizeof(frame);
+}
+
+/**
+ * @brief Test the record of a log message
+ *
+ * @details The backend receives the record in one chunk, its header
+ * describes the message and the hexdump data ends the record.
+ */
+void test_log_output_dict_msg(void)
+{
+	static const uint8_t data[] = { 0xde, 0xad, 0xbe, 0xef, 0x01, 0x02 };
+	struct log_dict_output_normal_msg_hdr_t hdr;
+	size_t record_len, offset;
+
+	reset();
+
+	LOG_HEXDUMP_INF(data, sizeof(data), "data");
+	while (log_process(false)) {
+	}
+
+	zassert_equal(mock_chunks, 1, "Record split in %u chunks", mock_chunks);
+	zassert_true(mock_len > sizeof(hdr), "Record too short");
+
+	offset = IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING) ?
+		 sizeof(struct log_dict_output_frame_hdr_t) : 0;
+	memcpy(&hdr, &mock_buffer[offset], sizeof(hdr));
+
+	zassert_equal(hdr.type, MSG_NORMAL, "Bad type");
+	zassert_equal(hdr.domain, 0, "Bad domain");
+	zassert_equal(hdr.level, LOG_LEVEL_INF, "Bad level");
+	zassert_equal(hdr.source, LOG_CURRENT_MODULE_ID(), "Bad source");
+	zassert_equal(hdr.timestamp, TEST_TIMESTAMP, "Bad timestamp");
+	zassert_equal(hdr.data_len, sizeof(data), "Bad data length");
+	zassert_true(hdr.package_len > 0, "No package");
+
+	record_len = sizeof(hdr) + hdr.package_len + hdr.data_len;
+	offset = frame_check(record_len);
+
+	zassert_mem_equal(&mock_buffer[offset + record_len - sizeof(data)],
+			  data, sizeof(data), "Bad data");
+}
+
+/**
+ * @brief Test the record of a dropped messages report
+ */
+void test_log_output_dict_dropped(void)
+{
+	struct log_dict_output_dropped_msg_t msg;
+	size_t offset;
+
+	reset();
+
+	log_output_dropped_process(&log_output, TEST_DROPPED);
+
+	zassert_equal(mock_chunks, 1, "Record split in %u chunks", mock_chunks);
+
+	offset = frame_check(sizeof(msg));
+	memcpy(&msg, &mock_buffer[offset], sizeof(msg));
+
+	zassert_equal(msg.type, MSG_DROPPED_MSG, "Bad type");
+	zassert_equal(msg.num_dropped_messages, TEST_DROPPED, "Bad count");
+}
+
+/**
+ * @brief Test that consecutive records follow each other in the stream
+ */
+void test_log_output_dict_stream(void)
+{
+	struct log_dict_output_normal_msg_hdr_t hdr;
+	size_t frame_len, offset = 0;
+
+	reset();
+
+	LOG_INF("first");
+	LOG_WRN("second %d", 2);
+	while (log_process(false)) {
+	}
+
+	zassert_equal(mock_chunks, 2, "%u chunks for 2 records", mock_chunks);
+
+	for (int i = 0; i < 2; i++) {
+		if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+			offset += sizeof(struct log_dict_output_frame_hdr_t);
+		}
+
+		zassert_true(offset + sizeof(hdr) <= mock_len, "Record missing");
+		memcpy(&hdr, &mock_buffer[offset], sizeof(hdr));
+
+		zassert_equal(hdr.type, MSG_NORMAL, "Bad type");
+		zassert_equal(hdr.level, i ? LOG_LEVEL_WRN : LOG_LEVEL_INF,
+			      "Bad level of record %d", i);
+		zassert_equal(hdr.data_len, 0, "Unexpected data");
+
+		frame_len = sizeof(hdr) + hdr.package_len;
+		offset += frame_len;
+
+		if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMING)) {
+			uint16_t crc;
+
+			memcpy(&crc, &mock_buffer[offset], sizeof(crc));
+			zassert_equal(crc, crc16_ccitt(0xFFFF,
+						       &mock_buffer[offset -
+								    frame_len],
+						       frame_len),
+				      "Bad CRC of record %d", i);
+			offset += sizeof(crc);
+		}
+	}
+
+	zassert_equal(offset, mock_len, "Trailing output");
+}
+
+void test_main(void)
+{
+	log_init();
+	log_set_timestamp_func(timestamp_get, 1000000);
+	log_backend_enable(&backend, NULL, LOG_LEVEL_DBG);
+
+	ztest_test_suite(test_log_output_dict,
+			 ztest_unit_test(test_log_output_dict_msg),
+			 ztest_unit_test(test_log_output_dict_dropped),
+			 ztest_unit_test(test_log_output_dict_stream)
+			 );
+	ztest_run_test_suite(test_log_output_dict);
+}
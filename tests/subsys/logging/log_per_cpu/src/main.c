@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test deferred logging with a message buffer for each CPU
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_msg2.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define CPU_CNT CONFIG_MP_NUM_CPUS
+/* Messages logged by each CPU, they fit in its part of the buffer */
+#define MSG_CNT 32
+/* Messages logged by one CPU, way beyond its part of the buffer */
+#define FLOOD_CNT 500
+#define STACK_SIZE 1024
+
+/* Payload of each message, checked by the backend */
+struct test_payload {
+	uint32_t cpu;
+	uint32_t seq;
+	uint32_t magic;
+};
+
+#define TEST_MAGIC(cpu, seq) (0xa5a50000 ^ ((cpu) << 12) ^ (seq))
+
+struct backend_cb {
+	uint32_t cnt[CPU_CNT];
+	uint32_t next_seq[CPU_CNT];
+	uint32_t last_seq[CPU_CNT];
+	log_timestamp_t last_timestamp;
+	bool any;
+	uint32_t total_drops;
+};
+
+static struct backend_cb backend_ctrl_blk;
+
+static void process(struct log_backend const *const backend,
+		    union log_msg2_generic *msg)
+{
+	struct backend_cb *cb = (struct backend_cb *)backend->cb->ctx;
+	struct test_payload payload;
+	log_timestamp_t timestamp;
+	uint8_t *data;
+	size_t len;
+
+	data = log_msg2_get_data(&msg->log, &len);
+	zassert_equal(len, sizeof(payload), "Truncated message");
+	memcpy(&payload, data, sizeof(payload));
+
+	zassert_true(payload.cpu < CPU_CNT, "Bad CPU %u", payload.cpu);
+	zassert_equal(payload.magic, TEST_MAGIC(payload.cpu, payload.seq),
+		      "Corrupted message");
+
+	/* Messages of each CPU come out in order, in overflow mode the oldest
+	 * ones may be missing.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
+		zassert_true(payload.seq >= cb->next_seq[payload.cpu],
+			     "CPU %u message %u out of order", payload.cpu,
+			     payload.seq);
+	} else {
+		zassert_equal(payload.seq, cb->next_seq[payload.cpu],
+			      "CPU %u message %u missing", payload.cpu,
+			      cb->next_seq[payload.cpu]);
+	}
+
+	timestamp = log_msg2_get_timestamp(&msg->log);
+	zassert_true(!cb->any || timestamp > cb->last_timestamp,
+		     "Message from CPU %u out of timestamp order", payload.cpu);
+
+	cb->any = true;
+	cb->last_timestamp = timestamp;
+	cb->next_seq[payload.cpu] = payload.seq + 1;
+	cb->last_seq[payload.cpu] = payload.seq;
+	cb->cnt[payload.cpu]++;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+}
+
+static void dropped(struct log_backend const *const backend, uint32_t cnt)
+{
+	struct backend_cb *cb = (struct backend_cb *)backend->cb->ctx;
+
+	cb->total_drops += cnt;
+}
+
+static const struct log_backend_api log_backend_test_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+/* Every message gets a distinct timestamp */
+static atomic_t stamp;
+
+static log_timestamp_t timestamp_get(void)
+{
+	return (log_timestamp_t)atomic_inc(&stamp);
+}
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CPU_CNT, STACK_SIZE);
+static struct k_thread threads[CPU_CNT];
+
+static void log_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t cpu = POINTER_TO_UINT(p1);
+	uint32_t cnt = POINTER_TO_UINT(p2);
+
+	for (uint32_t seq = 0; seq < cnt; seq++) {
+		struct test_payload payload = {
+			.cpu = cpu,
+			.seq = seq,
+			.magic = TEST_MAGIC(cpu, seq),
+		};
+
+		LOG_HEXDUMP_INF(&payload, sizeof(payload), "payload");
+	}
+
+}
+
+/* Cooperative threads pinned to their CPU, so that messages of one CPU are
+ * committed in allocation order.
+ */
+static void log_threads_start(uint32_t cpu_mask, uint32_t cnt)
+{
+	for (uint32_t cpu = 0; cpu < CPU_CNT; cpu++) {
+		if (!(cpu_mask & BIT(cpu))) {
+			continue;
+		}
+
+		k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE,
+				log_thread, UINT_TO_POINTER(cpu),
+				UINT_TO_POINTER(cnt), NULL, K_PRIO_COOP(1), 0,
+				K_FOREVER);
+		zassert_equal(k_thread_cpu_mask_clear(&threads[cpu]), 0, NULL);
+		zassert_equal(k_thread_cpu_mask_enable(&threads[cpu], cpu), 0,
+			      NULL);
+	}
+
+	for (uint32_t cpu = 0; cpu < CPU_CNT; cpu++) {
+		if (cpu_mask & BIT(cpu)) {
+			k_thread_start(&threads[cpu]);
+		}
+	}
+
+	for (uint32_t cpu = 0; cpu < CPU_CNT; cpu++) {
+		if (cpu_mask & BIT(cpu)) {
+			k_thread_join(&threads[cpu], K_FOREVER);
+		}
+	}
+}
+
+static void log_flush(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+static void test_setup(void)
+{
+	log_flush();
+	memset(&backend_ctrl_blk, 0, sizeof(backend_ctrl_blk));
+	atomic_set(&stamp, 1);
+}
+
+/**
+ * @brief Test messages logged concurrently on all CPUs
+ *
+ * @details Every message comes out complete, the messages of each CPU
+ * come out in order and all messages come out in timestamp order.
+ */
+void test_log_per_cpu_order(void)
+{
+	test_setup();
+
+	log_threads_start(BIT_MASK(CPU_CNT), MSG_CNT);
+	log_flush();
+
+	for (int cpu = 0; cpu < CPU_CNT; cpu++) {
+		zassert_equal(backend_ctrl_blk.cnt[cpu], MSG_CNT,
+			      "CPU %d: %u messages processed", cpu,
+			      backend_ctrl_blk.cnt[cpu]);
+	}
+
+	zassert_equal(backend_ctrl_blk.total_drops, 0, "Unexpected drops");
+}
+
+/**
+ * @brief Test drop accounting when one CPU exhausts its buffer
+ *
+ * @details Every message is either processed or reported as dropped. The
+ * other CPUs still have their part of the buffer for their messages.
+ */
+void test_log_per_cpu_drops(void)
+{
+	uint32_t processed;
+
+	test_setup();
+
+	log_threads_start(BIT(0), FLOOD_CNT);
+	log_threads_start(BIT_MASK(CPU_CNT) & ~BIT(0), MSG_CNT);
+	log_flush();
+
+	processed = backend_ctrl_blk.cnt[0];
+	zassert_true(processed < FLOOD_CNT, "No message dropped");
+	zassert_equal(processed + backend_ctrl_blk.total_drops, FLOOD_CNT,
+		      "%u processed, %u dropped", processed,
+		      backend_ctrl_blk.total_drops);
+
+	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
+		/* The oldest messages were overwritten */
+		zassert_equal(backend_ctrl_blk.last_seq[0], FLOOD_CNT - 1,
+			      "Newest message lost");
+	} else {
+		/* The newest messages did not fit */
+		zassert_equal(backend_ctrl_blk.last_seq[0], processed - 1,
+			      "Oldest messages lost");
+	}
+
+	for (int cpu = 1; cpu < CPU_CNT; cpu++) {
+		zassert_equal(backend_ctrl_blk.cnt[cpu], MSG_CNT,
+			      "CPU %d: %u messages processed", cpu,
+			      backend_ctrl_blk.cnt[cpu]);
+	}
+}
+
+void test_main(void)
+{
+	log_init();
+	log_set_timestamp_func(timestamp_get, 1000000);
+	log_backend_enable(&backend, &backend_ctrl_blk, LOG_LEVEL_DBG);
+
+	ztest_test_suite(test_log_per_cpu,
+			 ztest_unit_test(test_log_per_cpu_order),
+			 ztest_unit_test(test_log_per_cpu_drops)
+			 );
+	ztest_run_test_suite(test_log_per_cpu);
+}
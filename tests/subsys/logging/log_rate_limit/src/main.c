@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test rate limiting of log messages
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_msg2.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_DBG);
+
+/* Refill rate used by the tests, one token every 100 ms */
+#define TEST_RATE 10
+#define TEST_TOKEN_MS (MSEC_PER_SEC / TEST_RATE)
+
+struct backend_cb {
+	/* Processed messages of each level, error to debug */
+	uint32_t cnt[4];
+};
+
+static struct backend_cb backend_ctrl_blk;
+
+static void process(struct log_backend const *const backend,
+		    union log_msg2_generic *msg)
+{
+	struct backend_cb *cb = (struct backend_cb *)backend->cb->ctx;
+	uint8_t level = log_msg2_get_level(&msg->log);
+
+	zassert_true(level >= LOG_LEVEL_ERR && level <= LOG_LEVEL_DBG,
+		     "Bad level %u", level);
+	cb->cnt[level - 1]++;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+}
+
+static void dropped(struct log_backend const *const backend, uint32_t cnt)
+{
+	zassert_unreachable("%u messages dropped", cnt);
+}
+
+static const struct log_backend_api log_backend_test_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+static void log_flush(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+static void test_setup(uint16_t burst, uint16_t rate, uint16_t sample)
+{
+	log_flush();
+	memset(&backend_ctrl_blk, 0, sizeof(backend_ctrl_blk));
+	log_rate_limit_set(burst, rate, sample);
+	log_rate_limit_reset();
+}
+
+static uint32_t log_inf(int cnt)
+{
+	uint32_t processed = backend_ctrl_blk.cnt[LOG_LEVEL_INF - 1];
+
+	for (int i = 0; i < cnt; i++) {
+		LOG_INF("message %d", i);
+	}
+
+	log_flush();
+
+	return backend_ctrl_blk.cnt[LOG_LEVEL_INF - 1] - processed;
+}
+
+static uint32_t suppressed_get(uint32_t level)
+{
+	return log_rate_limit_suppressed_get(LOG_CURRENT_MODULE_ID(), level);
+}
+
+/**
+ * @brief Test that a burst exhausts the bucket of its level only
+ */
+void test_log_rate_limit_burst(void)
+{
+	test_setup(4, 0, 0);
+
+	zassert_equal(log_inf(10), 4, "Burst not limited");
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 6, NULL);
+
+	/* Other levels have their own bucket */
+	LOG_ERR("error");
+	LOG_WRN("warning");
+	log_flush();
+	zassert_equal(backend_ctrl_blk.cnt[LOG_LEVEL_ERR - 1], 1, NULL);
+	zassert_equal(backend_ctrl_blk.cnt[LOG_LEVEL_WRN - 1], 1, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_ERR), 0, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_WRN), 0, NULL);
+
+	/* Without refill the bucket stays empty */
+	k_msleep(2 * TEST_TOKEN_MS);
+	zassert_equal(log_inf(1), 0, "Bucket refilled with rate 0");
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 7, NULL);
+}
+
+/**
+ * @brief Test that the bucket is refilled at the configured rate
+ */
+void test_log_rate_limit_refill(void)
+{
+	test_setup(4, TEST_RATE, 0);
+
+	zassert_equal(log_inf(5), 4, "Burst not limited");
+
+	/* Two tokens and a half */
+	k_msleep(2 * TEST_TOKEN_MS + TEST_TOKEN_MS / 2);
+	zassert_equal(log_inf(4), 2, "Unexpected refill");
+
+	/* The remaining half token is not lost */
+	k_msleep(TEST_TOKEN_MS / 2 + TEST_TOKEN_MS / 4);
+	zassert_equal(log_inf(2), 1, "Partial token lost");
+
+	/* The bucket does not hold more than the burst */
+	k_msleep(10 * TEST_TOKEN_MS);
+	zassert_equal(log_inf(10), 4, "Bucket overfilled");
+
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 1 + 2 + 1 + 6, NULL);
+}
+
+/**
+ * @brief Test that one in N limited messages passes with sampling
+ */
+void test_log_rate_limit_sample(void)
+{
+	test_setup(2, 0, 3);
+
+	/* 2 from the burst, then the 3rd, 6th and 9th limited ones */
+	zassert_equal(log_inf(11), 2 + 3, "Bad sampling");
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 6, NULL);
+
+	/* Sampling continues across calls */
+	zassert_equal(log_inf(3), 1, "Bad sampling");
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 8, NULL);
+}
+
+/**
+ * @brief Test suppressed messages counters
+ *
+ * @details Counters are kept per source and level, invalid sources and
+ * levels read as 0 and a reset clears the counters and refills the buckets.
+ */
+void test_log_rate_limit_suppressed(void)
+{
+	uint32_t id = LOG_CURRENT_MODULE_ID();
+
+	test_setup(1, 0, 0);
+
+	for (int i = 0; i < 4; i++) {
+		LOG_ERR("error");
+		LOG_DBG("debug");
+	}
+	LOG_DBG("debug");
+	log_flush();
+
+	zassert_equal(backend_ctrl_blk.cnt[LOG_LEVEL_ERR - 1], 1, NULL);
+	zassert_equal(backend_ctrl_blk.cnt[LOG_LEVEL_DBG - 1], 1, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_ERR), 3, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_WRN), 0, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_INF), 0, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_DBG), 4, NULL);
+
+	zassert_equal(log_rate_limit_suppressed_get(id, LOG_LEVEL_NONE), 0,
+		      NULL);
+	zassert_equal(log_rate_limit_suppressed_get(id, LOG_LEVEL_DBG + 1), 0,
+		      NULL);
+	zassert_equal(log_rate_limit_suppressed_get(log_src_cnt_get(0),
+						    LOG_LEVEL_ERR), 0, NULL);
+	zassert_equal(log_rate_limit_suppressed_get(UINT32_MAX,
+						    LOG_LEVEL_ERR), 0, NULL);
+
+	log_rate_limit_reset();
+	zassert_equal(suppressed_get(LOG_LEVEL_ERR), 0, NULL);
+	zassert_equal(suppressed_get(LOG_LEVEL_DBG), 0, NULL);
+
+	LOG_DBG("debug");
+	LOG_DBG("debug");
+	log_flush();
+	zassert_equal(backend_ctrl_blk.cnt[LOG_LEVEL_DBG - 1], 2,
+		      "Bucket not refilled by reset");
+}
+
+/**
+ * @brief Test setting and getting rate limiting parameters
+ */
+void test_log_rate_limit_set(void)
+{
+	uint16_t burst, rate, sample;
+
+	log_rate_limit_set(8, 2, 5);
+	log_rate_limit_get(&burst, &rate, &sample);
+	zassert_equal(burst, 8, NULL);
+	zassert_equal(rate, 2, NULL);
+	zassert_equal(sample, 5, NULL);
+
+	/* At least one message passes */
+	log_rate_limit_set(0, 0, 0);
+	log_rate_limit_get(&burst, &rate, &sample);
+	zassert_equal(burst, 1, NULL);
+	zassert_equal(rate, 0, NULL);
+	zassert_equal(sample, 0, NULL);
+
+	/* A larger burst applies to an already limited source */
+	test_setup(1, 0, 0);
+	zassert_equal(log_inf(3), 1, NULL);
+	log_rate_limit_set(3, 0, 0);
+	zassert_equal(log_inf(3), 2, NULL);
+
+	log_rate_limit_set(CONFIG_LOG_RATE_LIMIT_BURST,
+			   CONFIG_LOG_RATE_LIMIT_RATE,
+			   CONFIG_LOG_RATE_LIMIT_SAMPLE);
+}
+
+void test_main(void)
+{
+	log_init();
+	log_backend_enable(&backend, &backend_ctrl_blk, LOG_LEVEL_DBG);
+
+	ztest_test_suite(test_log_rate_limit,
+			 ztest_unit_test(test_log_rate_limit_burst),
+			 ztest_unit_test(test_log_rate_limit_refill),
+			 ztest_unit_test(test_log_rate_limit_sample),
+			 ztest_unit_test(test_log_rate_limit_suppressed),
+			 ztest_unit_test(test_log_rate_limit_set)
+			 );
+	ztest_run_test_suite(test_log_rate_limit);
+}
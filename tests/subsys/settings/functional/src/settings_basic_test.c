@@ -462,6 +462,68 @@ static void test_direct_loading(void)
 	zassert_equal(23, val_directly_loaded, NULL);
 }
 
+static void test_transaction(void)
+{
+	int rc;
+	uint8_t val;
+
+	if (!IS_ENABLED(CONFIG_SETTINGS_TXN)) {
+		ztest_test_skip();
+	}
+
+	rc = settings_txn_begin();
+	zassert_true(rc == 0, NULL);
+
+	rc = settings_txn_begin();
+	zassert_equal(-EBUSY, rc, NULL);
+
+	/* Repeated saves of the same key are coalesced */
+	val = 12;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_true(rc == 0, NULL);
+	val = 13;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_true(rc == 0, NULL);
+	val = 24;
+	rc = settings_save_one("val/2", &val, sizeof(uint8_t));
+	zassert_true(rc == 0, NULL);
+
+	/* Nothing is written before the commit */
+	val_directly_loaded = 0;
+	rc = settings_load_subtree_direct("val/2", direct_loader,
+					  (void *)0x1234);
+	zassert_true(rc == 0, NULL);
+	zassert_equal(23, val_directly_loaded, NULL);
+
+	rc = settings_txn_commit();
+	zassert_true(rc == 0, NULL);
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load();
+	zassert_true(rc == 0, NULL);
+
+	zassert_equal(13, data.val1, NULL);
+	zassert_equal(24, data.val2, NULL);
+	zassert_equal(35, data.val3, NULL);
+
+	/* Aborted transactions are discarded */
+	rc = settings_txn_begin();
+	zassert_true(rc == 0, NULL);
+	val = 36;
+	rc = settings_save_one("val/3", &val, sizeof(uint8_t));
+	zassert_true(rc == 0, NULL);
+	settings_txn_abort();
+
+	rc = settings_txn_commit();
+	zassert_equal(-EINVAL, rc, NULL);
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load();
+	zassert_true(rc == 0, NULL);
+
+	zassert_equal(35, data.val3, NULL);
+}
+
 struct test_loading_data {
 	const char *n;
 	const char *v;
@@ -614,6 +676,7 @@ void test_main(void)
 			 ztest_unit_test(test_support_rtn),
 			 ztest_unit_test(test_register_and_loading),
 			 ztest_unit_test(test_direct_loading),
+			 ztest_unit_test(test_transaction),
 			 ztest_unit_test(test_direct_loading_filter)
 			);
 
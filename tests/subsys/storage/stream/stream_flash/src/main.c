@@ -644,6 +644,72 @@ static void test_stream_flash_progress_clear(void)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_PIPELINE
+static uint8_t pipe_buf[BUF_LEN * 2];
+
+static void test_stream_flash_pipelined_write(void)
+{
+	int rc;
+	size_t bytes_written;
+
+	clear_all_progress();
+	init_target();
+
+	rc = stream_flash_init_pipelined(&ctx, fdev, pipe_buf, BUF_LEN, 1,
+					 FLASH_BASE, 0, NULL);
+	zassert_true(rc < 0, "should fail with a single buffer");
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	/* Dirty the second page, which is erased ahead of the writes */
+	rc = flash_write(fdev, FLASH_BASE + page_size, write_buf, page_size);
+	zassert_equal(rc, 0, "should succeed");
+#endif
+
+	rc = stream_flash_init_pipelined(&ctx, fdev, pipe_buf, BUF_LEN, 2,
+					 FLASH_BASE, 0, stream_flash_callback);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Three buffers are submitted, the writer waits for the first two
+	 * ones when reusing their buffer.
+	 */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * 3 + 128,
+					 false);
+	zassert_equal(rc, 0, "expected success");
+
+	bytes_written = stream_flash_bytes_written(&ctx);
+	zassert_equal(bytes_written, BUF_LEN * 2,
+		      "expected completed writes only");
+	VERIFY_WRITTEN(0, BUF_LEN * 2);
+
+	/* The stored progress does not cover pending writes */
+	rc = stream_flash_progress_save(&ctx, progress_key);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN - 128, true);
+	zassert_equal(rc, 0, "expected success");
+
+	bytes_written = stream_flash_bytes_written(&ctx);
+	zassert_equal(bytes_written, BUF_LEN * 4, "expected all bytes written");
+	VERIFY_WRITTEN(0, BUF_LEN * 4);
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	VERIFY_ERASED(page_size, page_size);
+#endif
+
+	init_target();
+
+	bytes_written = load_progress(progress_key);
+	zassert_equal(bytes_written, BUF_LEN * 2,
+		      "expected saved progress to be loaded");
+
+	clear_all_progress();
+}
+#else
+static void test_stream_flash_pipelined_write(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -667,7 +733,8 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_bytes_written),
 	     ztest_unit_test(test_stream_flash_progress_api),
 	     ztest_unit_test(test_stream_flash_progress_resume),
-	     ztest_unit_test(test_stream_flash_progress_clear)
+	     ztest_unit_test(test_stream_flash_progress_clear),
+	     ztest_unit_test(test_stream_flash_pipelined_write)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);
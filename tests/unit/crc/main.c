@@ -12,6 +12,10 @@
 #include "../../../lib/os/crc32c_sw.c"
 #include "../../../lib/os/crc7_sw.c"
 
+#if defined(CRC_SLICE_TABLES)
+#include "../../../lib/os/crc_tables.c"
+#endif
+
 void test_crc32c(void)
 {
 	uint8_t test1[] = { 'A' };